@@ -0,0 +1,88 @@
+#include <tinystl/allocator.h>
+#include <tinystl/arena.h>
+#include <tinystl/pool_allocator.h>
+#include <tinystl/thread_cache.h>
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t batch = 1000;
+
+template <typename Allocator>
+void bench_single(const char *name, std::size_t n) {
+    Allocator alloc;
+    BENCHMARK(name) {
+        auto p = alloc.allocate(n);
+        alloc.deallocate(p, n);
+        return p;
+    };
+}
+
+template <typename Allocator>
+void bench_batch(const char *name, std::size_t n) {
+    Allocator alloc;
+    std::vector<typename Allocator::pointer> ptrs(batch);
+    BENCHMARK(name) {
+        for (auto &p : ptrs) p = alloc.allocate(n);
+        for (auto p : ptrs) alloc.deallocate(p, n);
+        return ptrs.back();
+    };
+}
+
+}  // namespace
+
+TEST_CASE("Allocator allocate/deallocate pair", "[benchmark][allocator]") {
+    SECTION("16 bytes") {
+        bench_single<std::allocator<char>>("std::allocator 16B", 16);
+        bench_single<tinystl::allocator<char>>("tinystl::allocator 16B", 16);
+        bench_single<tinystl::pool_allocator<char>>("tinystl::pool_allocator 16B", 16);
+        bench_single<tinystl::thread_cache_allocator<char>>("tinystl::thread_cache_allocator 16B", 16);
+    }
+
+    SECTION("256 bytes") {
+        bench_single<std::allocator<char>>("std::allocator 256B", 256);
+        bench_single<tinystl::allocator<char>>("tinystl::allocator 256B", 256);
+        bench_single<tinystl::pool_allocator<char>>("tinystl::pool_allocator 256B", 256);
+        bench_single<tinystl::thread_cache_allocator<char>>("tinystl::thread_cache_allocator 256B", 256);
+    }
+
+    SECTION("4096 bytes") {
+        bench_single<std::allocator<char>>("std::allocator 4KiB", 4096);
+        bench_single<tinystl::allocator<char>>("tinystl::allocator 4KiB", 4096);
+    }
+
+    SECTION("1 MiB") {
+        bench_single<std::allocator<char>>("std::allocator 1MiB", 1 << 20);
+        bench_single<tinystl::allocator<char>>("tinystl::allocator 1MiB", 1 << 20);
+    }
+}
+
+TEST_CASE("Allocator batches of 1000", "[benchmark][allocator]") {
+    SECTION("16 bytes") {
+        bench_batch<std::allocator<char>>("std::allocator 1000 x 16B", 16);
+        bench_batch<tinystl::allocator<char>>("tinystl::allocator 1000 x 16B", 16);
+        bench_batch<tinystl::pool_allocator<char>>("tinystl::pool_allocator 1000 x 16B", 16);
+        bench_batch<tinystl::thread_cache_allocator<char>>("tinystl::thread_cache_allocator 1000 x 16B", 16);
+    }
+
+    SECTION("128 bytes") {
+        bench_batch<std::allocator<char>>("std::allocator 1000 x 128B", 128);
+        bench_batch<tinystl::allocator<char>>("tinystl::allocator 1000 x 128B", 128);
+        bench_batch<tinystl::pool_allocator<char>>("tinystl::pool_allocator 1000 x 128B", 128);
+        bench_batch<tinystl::thread_cache_allocator<char>>("tinystl::thread_cache_allocator 1000 x 128B", 128);
+    }
+
+    SECTION("Arena") {
+        tinystl::monotonic_arena arena;
+        tinystl::arena_allocator<char> alloc(arena);
+        BENCHMARK("tinystl::arena_allocator 1000 x 16B") {
+            char *last = nullptr;
+            for (std::size_t i = 0; i < batch; ++i) last = alloc.allocate(16);
+            arena.release();
+            return last;
+        };
+    }
+}
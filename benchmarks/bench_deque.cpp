@@ -0,0 +1,54 @@
+#include <tinystl/deque.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <deque>
+#include <string>
+
+TEST_CASE("deque push_back", "[benchmark][deque]") {
+    constexpr int count = 1000000;
+
+    SECTION("int") {
+        BENCHMARK("std::deque<int> push_back") {
+            std::deque<int> d;
+            for (int i = 0; i < count; ++i) d.push_back(i);
+            return d.size();
+        };
+        BENCHMARK("tinystl::vector<int> push_back") {
+            tinystl::vector<int> v;
+            for (int i = 0; i < count; ++i) v.push_back(i);
+            return v.size();
+        };
+        BENCHMARK("tinystl::deque<int> push_back") {
+            tinystl::deque<int> d;
+            for (int i = 0; i < count; ++i) d.push_back(i);
+            return d.size();
+        };
+    }
+
+    SECTION("Queue") {
+        BENCHMARK("std::deque<int> push_back/pop_front") {
+            std::deque<int> d;
+            long sum = 0;
+            for (int i = 0; i < count; ++i) {
+                d.push_back(i);
+                if (d.size() > 1000) {
+                    sum += d.front();
+                    d.pop_front();
+                }
+            }
+            return sum;
+        };
+        BENCHMARK("tinystl::deque<int> push_back/pop_front") {
+            tinystl::deque<int> d;
+            long sum = 0;
+            for (int i = 0; i < count; ++i) {
+                d.push_back(i);
+                if (d.size() > 1000) {
+                    sum += d.front();
+                    d.pop_front();
+                }
+            }
+            return sum;
+        };
+    }
+}
@@ -0,0 +1,44 @@
+#include <tinystl/flat_hash_map.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("flat_hash_map find", "[benchmark][flat_hash_map]") {
+    constexpr int count = 100000;
+
+    std::vector<std::uint64_t> keys;
+    for (int i = 0; i < count; ++i) keys.push_back(static_cast<std::uint64_t>(i) * 0x9e3779b97f4a7c15ull);
+    std::unordered_map<std::uint64_t, int> std_map;
+    tinystl::flat_hash_map<std::uint64_t, int> flat_map;
+    for (int i = 0; i < count; ++i) {
+        std_map[keys[i]] = i;
+        flat_map[keys[i]] = i;
+    }
+    // look keys up in a different order than they were inserted, so that
+    // std::unordered_map does not walk its nodes in allocation order
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+    BENCHMARK("std::unordered_map find hit") {
+        long sum = 0;
+        for (std::uint64_t k : keys) sum += std_map.find(k)->second;
+        return sum;
+    };
+    BENCHMARK("tinystl::flat_hash_map find hit") {
+        long sum = 0;
+        for (std::uint64_t k : keys) sum += flat_map.find(k)->second;
+        return sum;
+    };
+    BENCHMARK("std::unordered_map find miss") {
+        int misses = 0;
+        for (std::uint64_t k : keys) misses += std_map.find(k + 1) == std_map.end();
+        return misses;
+    };
+    BENCHMARK("tinystl::flat_hash_map find miss") {
+        int misses = 0;
+        for (std::uint64_t k : keys) misses += flat_map.find(k + 1) == flat_map.end();
+        return misses;
+    };
+}
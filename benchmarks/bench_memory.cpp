@@ -0,0 +1,86 @@
+#include <tinystl/atomic_shared_ptr.h>
+#include <tinystl/memory.h>
+#include <catch2/catch_all.hpp>
+#include <memory>
+#include <mutex>
+
+TEST_CASE("unique_ptr", "[benchmark][memory]") {
+    BENCHMARK("std::unique_ptr construct and destroy") {
+        std::unique_ptr<int> p(new int(42));
+        return *p;
+    };
+    BENCHMARK("tinystl::unique_ptr construct and destroy") {
+        tinystl::unique_ptr<int> p(new int(42));
+        return *p;
+    };
+}
+
+TEST_CASE("shared_ptr", "[benchmark][memory]") {
+    SECTION("Construct and destroy") {
+        BENCHMARK("std::shared_ptr construct and destroy") {
+            std::shared_ptr<int> p(new int(42));
+            return *p;
+        };
+        BENCHMARK("tinystl::shared_ptr construct and destroy") {
+            tinystl::shared_ptr<int> p(new int(42));
+            return *p;
+        };
+    }
+
+    SECTION("Copy") {
+        std::shared_ptr<int> sp(new int(42));
+        tinystl::shared_ptr<int> tp(new int(42));
+        tinystl::shared_ptr<int, tinystl::default_deleter<int>, tinystl::plain_count_policy> lp(new int(42));
+        BENCHMARK("std::shared_ptr copy") {
+            std::shared_ptr<int> copy(sp);
+            return copy.get();
+        };
+        BENCHMARK("tinystl::shared_ptr copy") {
+            tinystl::shared_ptr<int> copy(tp);
+            return copy.get();
+        };
+        BENCHMARK("tinystl::shared_ptr copy (plain_count_policy)") {
+            tinystl::shared_ptr<int, tinystl::default_deleter<int>, tinystl::plain_count_policy> copy(lp);
+            return copy.get();
+        };
+    }
+}
+
+TEST_CASE("make_shared", "[benchmark][memory]") {
+    BENCHMARK("std::make_shared") {
+        auto p = std::make_shared<int>(42);
+        return *p;
+    };
+    BENCHMARK("tinystl::make_shared") {
+        auto p = tinystl::make_shared<int>(42);
+        return *p;
+    };
+}
+
+TEST_CASE("weak_ptr::lock", "[benchmark][memory]") {
+    auto sp = std::make_shared<int>(42);
+    std::weak_ptr<int> sw(sp);
+    auto tp = tinystl::make_shared<int>(42);
+    tinystl::weak_ptr<int> tw(tp);
+    BENCHMARK("std::weak_ptr::lock") {
+        return sw.lock().get();
+    };
+    BENCHMARK("tinystl::weak_ptr::lock") {
+        return tw.lock().get();
+    };
+}
+
+TEST_CASE("atomic_shared_ptr::load", "[benchmark][memory]") {
+    std::mutex mutex;
+    tinystl::shared_ptr<int> guarded(new int(42));
+    tinystl::atomic_shared_ptr<int> slot(tinystl::make_shared<int>(42));
+    BENCHMARK("tinystl::shared_ptr copy under a mutex") {
+        std::lock_guard<std::mutex> lock(mutex);
+        tinystl::shared_ptr<int> copy(guarded);
+        return copy.get();
+    };
+    BENCHMARK("tinystl::atomic_shared_ptr::load") {
+        auto copy = slot.load();
+        return copy.get();
+    };
+}
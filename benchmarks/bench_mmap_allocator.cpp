@@ -0,0 +1,26 @@
+#include <tinystl/mmap_allocator.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("mmap_allocator vector growth", "[benchmark][mmap_allocator]") {
+    // large enough that every growth past the first megabyte is a remap
+    constexpr std::uint64_t count = 16 * 1024 * 1024;
+
+    BENCHMARK("std::vector<std::uint64_t> push_back") {
+        std::vector<std::uint64_t> v;
+        for (std::uint64_t i = 0; i < count; ++i) v.push_back(i);
+        return v.size();
+    };
+    BENCHMARK("tinystl::vector<std::uint64_t> push_back") {
+        tinystl::vector<std::uint64_t> v;
+        for (std::uint64_t i = 0; i < count; ++i) v.push_back(i);
+        return v.size();
+    };
+    BENCHMARK("tinystl::vector<std::uint64_t, mmap_allocator> push_back") {
+        tinystl::vector<std::uint64_t, tinystl::mmap_allocator<std::uint64_t>> v;
+        for (std::uint64_t i = 0; i < count; ++i) v.push_back(i);
+        return v.size();
+    };
+}
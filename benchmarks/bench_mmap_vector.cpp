@@ -0,0 +1,39 @@
+#include <tinystl/mmap_vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("mmap_vector load", "[benchmark][mmap_vector]") {
+    constexpr std::uint64_t count = 4 * 1024 * 1024;
+    const std::string path = (std::filesystem::temp_directory_path() / "tinystl_bench_mmap_vector").string();
+    std::remove(path.c_str());
+    {
+        tinystl::mmap_vector<std::uint64_t> v(path);
+        v.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i) v.push_back(i);
+        v.shrink_to_fit();
+    }
+
+    // loading touches one element per page, as sparse lookups would
+    BENCHMARK("std::vector<std::uint64_t> read from file") {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(tinystl::mmap_vector<std::uint64_t>::data_offset);
+        std::vector<std::uint64_t> v(count);
+        in.read(reinterpret_cast<char *>(v.data()), count * sizeof(std::uint64_t));
+        std::uint64_t sum = 0;
+        for (std::uint64_t i = 0; i < count; i += 512) sum += v[i];
+        return sum;
+    };
+    BENCHMARK("tinystl::mmap_vector<std::uint64_t> open") {
+        tinystl::mmap_vector<std::uint64_t> v(path, tinystl::mmap_mode::read_only);
+        std::uint64_t sum = 0;
+        for (std::uint64_t i = 0; i < count; i += 512) sum += v[i];
+        return sum;
+    };
+
+    std::remove(path.c_str());
+}
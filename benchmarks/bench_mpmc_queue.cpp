@@ -0,0 +1,98 @@
+#include <tinystl/mpmc_queue.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int threads_per_side = 2;
+constexpr int items_per_producer = 100000;
+
+class locked_queue {
+public:
+    bool try_push(int value) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->items_.size() == 1024) return false;
+        this->items_.push_back(value);
+        return true;
+    }
+
+    bool try_pop(int &value) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->items_.empty()) return false;
+        value = this->items_.front();
+        this->items_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<int> items_;
+};
+
+// producers and consumers hand items_per_producer ints each through q
+template <typename Push, typename Pop>
+long run(Push push, Pop pop) {
+    std::atomic<long> sum{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < threads_per_side; ++p) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < items_per_producer;) i += push(i);
+        });
+    }
+    for (int c = 0; c < threads_per_side; ++c) {
+        threads.emplace_back([&] {
+            long local = 0;
+            for (int received = 0; received < items_per_producer;) received += pop(local);
+            sum.fetch_add(local);
+        });
+    }
+    for (auto &t : threads) t.join();
+    return sum.load();
+}
+
+}  // namespace
+
+TEST_CASE("mpmc_queue throughput", "[benchmark][mpmc_queue]") {
+    BENCHMARK("mutex + std::deque") {
+        locked_queue q;
+        return run([&](int i) { return q.try_push(i) ? 1 : (std::this_thread::yield(), 0); },
+                   [&](long &sum) {
+                       int value;
+                       if (!q.try_pop(value)) return (std::this_thread::yield(), 0);
+                       sum += value;
+                       return 1;
+                   });
+    };
+    BENCHMARK("tinystl::mpmc_queue try_push/try_pop") {
+        tinystl::mpmc_queue<int> q(1024);
+        return run([&](int i) { return q.try_push(i) ? 1 : (std::this_thread::yield(), 0); },
+                   [&](long &sum) {
+                       int value;
+                       if (!q.try_pop(value)) return (std::this_thread::yield(), 0);
+                       sum += value;
+                       return 1;
+                   });
+    };
+    BENCHMARK("tinystl::mpmc_queue push_n/pop_n") {
+        tinystl::mpmc_queue<int> q(1024);
+        return run([&](int i) {
+                       int batch[32];
+                       int n = (items_per_producer - i < 32) ? items_per_producer - i : 32;
+                       for (int k = 0; k < n; ++k) batch[k] = i + k;
+                       int pushed = static_cast<int>(q.push_n(batch, n));
+                       if (pushed == 0) std::this_thread::yield();
+                       return pushed;
+                   },
+                   [&](long &sum) {
+                       int batch[32];
+                       int n = static_cast<int>(q.pop_n(batch, 32));
+                       if (n == 0) std::this_thread::yield();
+                       for (int k = 0; k < n; ++k) sum += batch[k];
+                       return n;
+                   });
+    };
+}
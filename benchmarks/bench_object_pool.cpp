@@ -0,0 +1,49 @@
+#include <tinystl/memory.h>
+#include <tinystl/object_pool.h>
+#include <catch2/catch_all.hpp>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct message {
+    int id = 0;
+    std::string body;
+};
+
+struct clear_message {
+    void operator()(message &m) const noexcept {
+        m.id = 0;
+        m.body.clear();
+    }
+};
+
+const char *const payload = "a request body that is too long for the small string buffer";
+
+}  // namespace
+
+TEST_CASE("object_pool", "[benchmark][object_pool]") {
+    tinystl::object_pool<message> pool;
+    tinystl::object_pool<message, clear_message> warm_pool;
+
+    BENCHMARK("std::make_unique<message>") {
+        auto m = std::make_unique<message>();
+        m->body = payload;
+        return m->body.size();
+    };
+    BENCHMARK("tinystl::make_unique<message>") {
+        auto m = tinystl::make_unique<message>();
+        m->body = payload;
+        return m->body.size();
+    };
+    BENCHMARK("tinystl::object_pool<message> acquire") {
+        auto m = pool.acquire();
+        m->body = payload;
+        return m->body.size();
+    };
+    BENCHMARK("tinystl::object_pool<message, clear_message> acquire") {
+        auto m = warm_pool.acquire();
+        m->body = payload;
+        return m->body.size();
+    };
+}
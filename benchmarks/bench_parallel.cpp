@@ -0,0 +1,50 @@
+#include <tinystl/parallel.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+TEST_CASE("parallel algorithms", "[benchmark][parallel]") {
+    constexpr std::size_t count = 4000000;
+    tinystl::vector<double> input(count);
+    std::mt19937_64 rng(1);
+    for (auto &x : input) x = static_cast<double>(rng() % 1000000) / 7.0;
+    tinystl::vector<double> output(count);
+
+    SECTION("for_each") {
+        BENCHMARK("std::for_each") {
+            std::for_each(output.begin(), output.end(), [](double &x) { x = std::sqrt(x + 1.0); });
+            return output[0];
+        };
+        BENCHMARK("tinystl::parallel_for_each") {
+            tinystl::parallel_for_each(output.begin(), output.end(), [](double &x) { x = std::sqrt(x + 1.0); });
+            return output[0];
+        };
+    }
+
+    SECTION("reduce") {
+        BENCHMARK("std::accumulate") { return std::accumulate(input.begin(), input.end(), 0.0); };
+        BENCHMARK("tinystl::parallel_reduce") { return tinystl::parallel_reduce(input.begin(), input.end(), 0.0); };
+    }
+
+    SECTION("inclusive_scan") {
+        BENCHMARK("std::partial_sum") { return *(std::partial_sum(input.begin(), input.end(), output.begin()) - 1); };
+        BENCHMARK("tinystl::parallel_inclusive_scan") {
+            return *(tinystl::parallel_inclusive_scan(input.begin(), input.end(), output.begin()) - 1);
+        };
+    }
+
+    SECTION("sort") {
+        BENCHMARK_ADVANCED("std::sort")(Catch::Benchmark::Chronometer meter) {
+            tinystl::vector<double> v(input);
+            meter.measure([&] { std::sort(v.begin(), v.end()); });
+        };
+        BENCHMARK_ADVANCED("tinystl::parallel_sort")(Catch::Benchmark::Chronometer meter) {
+            tinystl::vector<double> v(input);
+            meter.measure([&] { tinystl::parallel_sort(v.begin(), v.end()); });
+        };
+    }
+}
@@ -0,0 +1,63 @@
+#include <tinystl/memory.h>
+#include <tinystl/slot_map.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <random>
+
+namespace {
+
+struct entity {
+    float x, y, z;
+    float vx, vy, vz;
+};
+
+constexpr int entity_count = 10000;
+
+}  // namespace
+
+TEST_CASE("slot_map", "[benchmark][slot_map]") {
+    // entities held elsewhere through weak references, looked up in random order
+    tinystl::vector<tinystl::shared_ptr<entity>> owners;
+    tinystl::vector<tinystl::weak_ptr<entity>> weak_refs;
+    tinystl::slot_map<entity> entities;
+    tinystl::vector<tinystl::slot_key> keys;
+    for (int i = 0; i < entity_count; ++i) {
+        entity e{float(i), 0, 0, 1, 1, 1};
+        owners.push_back(tinystl::make_shared<entity>(e));
+        keys.push_back(entities.insert(e));
+    }
+    std::mt19937 rng(42);
+    tinystl::vector<int> order;
+    for (int i = 0; i < entity_count; ++i) order.push_back(int(rng() % entity_count));
+    for (int i : order) weak_refs.push_back(tinystl::weak_ptr<entity>(owners[i]));
+    tinystl::vector<tinystl::slot_key> ordered_keys;
+    for (int i : order) ordered_keys.push_back(keys[i]);
+
+    SECTION("Lookup") {
+        BENCHMARK("tinystl::weak_ptr<entity> lock") {
+            float sum = 0;
+            for (const auto &w : weak_refs) {
+                if (auto p = w.lock()) sum += p->x;
+            }
+            return sum;
+        };
+        BENCHMARK("tinystl::slot_map<entity> find") {
+            float sum = 0;
+            for (tinystl::slot_key k : ordered_keys) {
+                if (const entity *p = entities.find(k)) sum += p->x;
+            }
+            return sum;
+        };
+    }
+
+    SECTION("Iteration") {
+        BENCHMARK("tinystl::vector<shared_ptr<entity>> update") {
+            for (auto &p : owners) p->x += p->vx;
+            return owners[0]->x;
+        };
+        BENCHMARK("tinystl::slot_map<entity> update") {
+            for (entity &e : entities) e.x += e.vx;
+            return entities.data()[0].x;
+        };
+    }
+}
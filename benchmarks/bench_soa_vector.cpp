@@ -0,0 +1,44 @@
+#include <tinystl/soa_vector.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+
+namespace {
+
+struct record {
+    float weight;
+    float score;
+    std::uint64_t id;
+    double fields[9];
+};
+
+}  // namespace
+
+TEST_CASE("soa_vector column scan", "[benchmark][soa_vector]") {
+    constexpr std::size_t count = 1000000;
+
+    // the kernel reads two of twelve fields
+    tinystl::vector<record> rows;
+    tinystl::soa_vector<float, float, std::uint64_t, double, double, double, double, double, double, double, double, double> columns;
+    rows.reserve(count);
+    columns.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float w = static_cast<float>(i % 7);
+        float s = static_cast<float>(i % 13);
+        rows.push_back(record{w, s, i, {}});
+        columns.emplace_back(w, s, i, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    }
+
+    BENCHMARK("tinystl::vector<record> weighted score") {
+        float total = 0;
+        for (const record &r : rows) total += r.weight * r.score;
+        return total;
+    };
+    BENCHMARK("tinystl::soa_vector weighted score") {
+        const float *weight = columns.data<0>();
+        const float *score = columns.data<1>();
+        float total = 0;
+        for (std::size_t i = 0; i < columns.size(); ++i) total += weight[i] * score[i];
+        return total;
+    };
+}
@@ -0,0 +1,106 @@
+#include <tinystl/memory.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("vector push_back", "[benchmark][vector]") {
+    constexpr int count = 100000;
+
+    SECTION("int") {
+        BENCHMARK("std::vector<int> push_back") {
+            std::vector<int> v;
+            for (int i = 0; i < count; ++i) v.push_back(i);
+            return v.size();
+        };
+        BENCHMARK("tinystl::vector<int> push_back") {
+            tinystl::vector<int> v;
+            for (int i = 0; i < count; ++i) v.push_back(i);
+            return v.size();
+        };
+    }
+
+    SECTION("std::string") {
+        BENCHMARK("std::vector<std::string> push_back") {
+            std::vector<std::string> v;
+            for (int i = 0; i < count; ++i) v.emplace_back("a string that does not fit in SSO");
+            return v.size();
+        };
+        BENCHMARK("tinystl::vector<std::string> push_back") {
+            tinystl::vector<std::string> v;
+            for (int i = 0; i < count; ++i) v.emplace_back("a string that does not fit in SSO");
+            return v.size();
+        };
+    }
+
+    SECTION("shared_ptr") {
+        BENCHMARK("std::vector<std::shared_ptr<int>> push_back") {
+            std::vector<std::shared_ptr<int>> v;
+            for (int i = 0; i < count; ++i) v.emplace_back();
+            return v.size();
+        };
+        BENCHMARK("tinystl::vector<tinystl::shared_ptr<int>> push_back") {
+            tinystl::vector<tinystl::shared_ptr<int>> v;
+            for (int i = 0; i < count; ++i) v.emplace_back();
+            return v.size();
+        };
+    }
+}
+
+TEST_CASE("vector erase", "[benchmark][vector]") {
+    constexpr int count = 1000;
+
+    BENCHMARK("std::vector<std::unique_ptr<int>> erase front") {
+        std::vector<std::unique_ptr<int>> v(count);
+        while (!v.empty()) v.erase(v.begin());
+        return v.size();
+    };
+    BENCHMARK("tinystl::vector<tinystl::unique_ptr<int>> erase front") {
+        tinystl::vector<tinystl::unique_ptr<int>> v(count);
+        while (!v.empty()) v.erase(v.begin());
+        return v.size();
+    };
+}
+
+TEST_CASE("vector bulk construction", "[benchmark][vector]") {
+    constexpr int count = 1000000;
+
+    SECTION("Fill") {
+        BENCHMARK("std::vector<int> fill") {
+            std::vector<int> v(count, 7);
+            return v.size();
+        };
+        BENCHMARK("tinystl::vector<int> fill") {
+            tinystl::vector<int> v(count, 7);
+            return v.size();
+        };
+    }
+
+    SECTION("Copy") {
+        std::vector<int> sv(count, 7);
+        tinystl::vector<int> tv(count, 7);
+        BENCHMARK("std::vector<int> copy") {
+            std::vector<int> v(sv);
+            return v.size();
+        };
+        BENCHMARK("tinystl::vector<int> copy") {
+            tinystl::vector<int> v(tv);
+            return v.size();
+        };
+    }
+
+    SECTION("Insert in the middle") {
+        std::vector<int> chunk(1000, 3);
+        BENCHMARK("std::vector<int> insert range") {
+            std::vector<int> v(count / 10, 1);
+            v.insert(v.begin() + v.size() / 2, chunk.begin(), chunk.end());
+            return v.size();
+        };
+        BENCHMARK("tinystl::vector<int> insert range") {
+            tinystl::vector<int> v(count / 10, 1);
+            v.insert(v.begin() + v.size() / 2, chunk.data(), chunk.data() + chunk.size());
+            return v.size();
+        };
+    }
+}
@@ -1,8 +1,18 @@
 #pragma once
 
+#include <tinystl/util.h>
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace tinystl {
 
 template <typename T>
@@ -16,12 +26,19 @@ public:
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
+    template <typename U>
+    struct rebind {
+        using other = allocator<U>;
+    };
+
 public:
     allocator() = default;
     allocator(const allocator &other) = default;
     allocator(allocator &&other) = default;
     allocator<T> &operator=(const allocator &other) = default;
     allocator<T> &operator=(allocator &&other) = default;
+    template <typename U>
+    allocator(const allocator<U> &) noexcept {}
 
     pointer allocate(size_type n);
     void deallocate(pointer p, size_type n);
@@ -64,4 +81,159 @@ typename allocator<T>::size_type allocator<T>::max_size() const noexcept {
     return static_cast<allocator<T>::size_type>(-1) / sizeof(T);
 }
 
+template <typename T, typename U>
+bool operator==(const allocator<T> &, const allocator<U> &) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const allocator<T> &, const allocator<U> &) noexcept {
+    return false;
+}
+
+/*
+ * Detects allocators with a reallocate(p, old_n, new_n) that resizes a block
+ * and carries its bytes along, such as mmap_allocator. Containers use it to
+ * grow buffers of trivially relocatable elements without copying them.
+ */
+template <typename Alloc, typename = void>
+struct allocator_can_reallocate : std::false_type {};
+
+template <typename Alloc>
+struct allocator_can_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate(
+                                           std::declval<typename Alloc::pointer>(), std::size_t(), std::size_t()))>>
+    : std::true_type {};
+
+/*
+ * Bulk construction into uninitialized storage through an allocator. Each
+ * returns the end of what it built; if an element constructor throws, the
+ * elements built so far are destroyed before the exception propagates.
+ *
+ * Trivially copyable types skip the allocator's construct() and are copied
+ * as bytes, since constructing them has no effect beyond the bytes.
+ */
+template <typename T>
+void fill_bytes_n(T *dest, std::size_t n, const T &value) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "fill_bytes_n copies object representations");
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(std::addressof(value));
+    unsigned char *out = reinterpret_cast<unsigned char *>(dest);
+    const std::size_t total = n * sizeof(T);
+    // zero and other single-byte patterns are what memset is for
+    if (std::all_of(bytes + 1, bytes + sizeof(T), [&](unsigned char b) { return b == bytes[0]; })) {
+        std::memset(out, bytes[0], total);
+        return;
+    }
+#ifdef __AVX2__
+    if constexpr (32 % sizeof(T) == 0) {
+        alignas(32) unsigned char pattern[32];
+        for (std::size_t i = 0; i < 32; i += sizeof(T)) std::memcpy(pattern + i, bytes, sizeof(T));
+        const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(pattern));
+        std::size_t i = 0;
+        for (; i + 32 <= total; i += 32) _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), v);
+        // i is a multiple of sizeof(T), so the tail starts on an element
+        std::memcpy(out + i, pattern, total - i);
+        return;
+    }
+#endif
+    if (n == 0) return;
+    // copy the filled prefix onto the rest, doubling it every time
+    std::memcpy(out, bytes, sizeof(T));
+    for (std::size_t filled = sizeof(T); filled < total; filled *= 2) {
+        std::memcpy(out + filled, out, std::min(filled, total - filled));
+    }
+}
+
+template <typename Alloc, typename T>
+void destroy_n(Alloc &alloc, T *first, std::size_t n) noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        for (; n > 0; --n, ++first) alloc.destroy(first);
+    }
+}
+
+template <typename Alloc, typename InputIt, typename T>
+T *uninitialized_copy_n(Alloc &alloc, InputIt first, std::size_t n, T *dest) {
+    using source = typename std::remove_cv<typename std::remove_pointer<InputIt>::type>::type;
+    if constexpr (std::is_pointer<InputIt>::value && std::is_same<source, T>::value && std::is_trivially_copyable<T>::value) {
+        if (n != 0) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), n * sizeof(T));
+        return dest + n;
+    } else {
+        T *cur = dest;
+        try {
+            for (; n > 0; --n, ++first, ++cur) alloc.construct(cur, *first);
+        } catch (...) {
+            destroy_n(alloc, dest, static_cast<std::size_t>(cur - dest));
+            throw;
+        }
+        return cur;
+    }
+}
+
+template <typename Alloc, typename T>
+T *uninitialized_move_n(Alloc &alloc, T *first, std::size_t n, T *dest) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (n != 0) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), n * sizeof(T));
+        return dest + n;
+    } else {
+        return uninitialized_copy_n(alloc, std::make_move_iterator(first), n, dest);
+    }
+}
+
+/*
+ * Moves n elements into uninitialized storage at dest and ends the lifetime
+ * of the sources. Trivially relocatable types are moved as bytes with one
+ * memmove, so their ranges may overlap; others are moved if their move
+ * constructor is noexcept and copied otherwise, so a throw leaves the source
+ * range as it was, and their ranges must not overlap.
+ */
+template <typename Alloc, typename T>
+T *relocate_n(Alloc &alloc, T *first, std::size_t n, T *dest) {
+    if constexpr (is_trivially_relocatable<T>::value) {
+        if (n != 0) std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), n * sizeof(T));
+        return dest + n;
+    } else {
+        T *end;
+        if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+            end = uninitialized_move_n(alloc, first, n, dest);
+        } else {
+            end = uninitialized_copy_n(alloc, first, n, dest);
+        }
+        destroy_n(alloc, first, n);
+        return end;
+    }
+}
+
+template <typename Alloc, typename T>
+T *uninitialized_fill_n(Alloc &alloc, T *dest, std::size_t n, const T &value) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        fill_bytes_n(dest, n, value);
+        return dest + n;
+    } else {
+        T *cur = dest;
+        try {
+            for (; n > 0; --n, ++cur) alloc.construct(cur, value);
+        } catch (...) {
+            destroy_n(alloc, dest, static_cast<std::size_t>(cur - dest));
+            throw;
+        }
+        return cur;
+    }
+}
+
+// value-initializes, so scalars start out as zero
+template <typename Alloc, typename T>
+T *uninitialized_value_construct_n(Alloc &alloc, T *dest, std::size_t n) {
+    if constexpr (std::is_trivial<T>::value) {
+        return uninitialized_fill_n(alloc, dest, n, T());
+    } else {
+        T *cur = dest;
+        try {
+            for (; n > 0; --n, ++cur) alloc.construct(cur);
+        } catch (...) {
+            destroy_n(alloc, dest, static_cast<std::size_t>(cur - dest));
+            throw;
+        }
+        return cur;
+    }
+}
+
 }  // namespace tinystl
\ No newline at end of file
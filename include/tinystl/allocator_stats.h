@@ -0,0 +1,342 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+
+/*
+ * Allocation statistics are compiled in only when TINYSTL_ENABLE_ALLOCATOR_STATS
+ * is defined. Without it instrumented_allocator forwards straight to its base
+ * allocator and the registry never records anything.
+ */
+#define TINYSTL_STRINGIFY_IMPL(x) #x
+#define TINYSTL_STRINGIFY(x) TINYSTL_STRINGIFY_IMPL(x)
+#define TINYSTL_CALL_SITE __FILE__ ":" TINYSTL_STRINGIFY(__LINE__)
+
+namespace tinystl {
+
+struct allocation_tag_stats {
+    const char *tag;
+    std::size_t allocations;
+    std::size_t deallocations;
+    std::size_t live_bytes;
+    std::size_t peak_bytes;
+};
+
+struct allocation_stats {
+    static constexpr std::size_t histogram_size = 32;
+    static constexpr std::size_t max_tags = 64;
+
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t allocated_bytes = 0;
+    std::size_t live_bytes = 0;
+    std::size_t peak_bytes = 0;
+    // bucket i counts requests of (2^(i-1), 2^i] bytes, the last one everything larger
+    std::size_t histogram[histogram_size] {};
+    allocation_tag_stats tags[max_tags] {};
+    std::size_t tag_count = 0;
+
+    static std::size_t bucket(std::size_t bytes) noexcept;
+    const allocation_tag_stats *find(const char *tag) const noexcept;
+    void dump(std::ostream &os) const;
+};
+
+inline std::size_t allocation_stats::bucket(std::size_t bytes) noexcept {
+    std::size_t b = 0;
+    while (b + 1 < histogram_size && (static_cast<std::size_t>(1) << b) < bytes) ++b;
+    return b;
+}
+
+inline const allocation_tag_stats *allocation_stats::find(const char *tag) const noexcept {
+    for (std::size_t i = 0; i < this->tag_count; ++i) {
+        if (this->tags[i].tag == tag) return &this->tags[i];
+    }
+    return nullptr;
+}
+
+inline void allocation_stats::dump(std::ostream &os) const {
+    os << "allocations: " << this->allocations << '\n'
+       << "deallocations: " << this->deallocations << '\n'
+       << "allocated bytes: " << this->allocated_bytes << '\n'
+       << "live bytes: " << this->live_bytes << '\n'
+       << "peak bytes: " << this->peak_bytes << '\n'
+       << "size classes:\n";
+    for (std::size_t i = 0; i < histogram_size; ++i) {
+        if (this->histogram[i] == 0) continue;
+        if (i + 1 < histogram_size) {
+            os << "  <= " << (static_cast<std::size_t>(1) << i) << ": " << this->histogram[i] << '\n';
+        } else {
+            os << "  > " << (static_cast<std::size_t>(1) << (i - 1)) << ": " << this->histogram[i] << '\n';
+        }
+    }
+    if (this->tag_count == 0) return;
+    os << "tags:\n";
+    for (std::size_t i = 0; i < this->tag_count; ++i) {
+        const allocation_tag_stats &t = this->tags[i];
+        os << "  " << t.tag << ": allocations " << t.allocations << ", deallocations " << t.deallocations
+           << ", live bytes " << t.live_bytes << ", peak bytes " << t.peak_bytes << '\n';
+    }
+}
+
+/*
+ * Process-wide allocation counters. Recording is lock-free: totals and the
+ * histogram are relaxed atomics, and tags are kept in a fixed open-addressing
+ * table keyed by the address of the tag string, so TINYSTL_CALL_SITE or any
+ * other string literal works as a tag. Tags that do not fit the table are
+ * only counted in the totals. A snapshot is not an atomic cut of all
+ * counters while other threads are allocating.
+ */
+class allocation_registry {
+public:
+#ifdef TINYSTL_ENABLE_ALLOCATOR_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+public:
+    allocation_registry() = default;
+    allocation_registry(const allocation_registry &other) = delete;
+    allocation_registry &operator=(const allocation_registry &other) = delete;
+
+    void record_allocate(std::size_t bytes, const char *tag = nullptr) noexcept;
+    void record_deallocate(std::size_t bytes, const char *tag = nullptr) noexcept;
+    allocation_stats snapshot() const noexcept;
+    void dump(std::ostream &os) const;
+    // must not race with recording
+    void reset() noexcept;
+
+private:
+    struct counters {
+        std::atomic<std::size_t> allocations {0};
+        std::atomic<std::size_t> deallocations {0};
+        std::atomic<std::size_t> allocated_bytes {0};
+        std::atomic<std::size_t> live_bytes {0};
+        std::atomic<std::size_t> peak_bytes {0};
+
+        void add(std::size_t bytes) noexcept;
+        void sub(std::size_t bytes) noexcept;
+        void clear() noexcept;
+    };
+    struct tag_slot {
+        std::atomic<const char *> tag {nullptr};
+        counters stats;
+    };
+
+    tag_slot *find_tag(const char *tag) noexcept;
+
+private:
+    counters totals_;
+    std::atomic<std::size_t> histogram_[allocation_stats::histogram_size] {};
+    tag_slot tags_[allocation_stats::max_tags];
+};
+
+inline void allocation_registry::counters::add(std::size_t bytes) noexcept {
+    this->allocations.fetch_add(1, std::memory_order_relaxed);
+    this->allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    std::size_t live = this->live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = this->peak_bytes.load(std::memory_order_relaxed);
+    while (peak < live && !this->peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+inline void allocation_registry::counters::sub(std::size_t bytes) noexcept {
+    this->deallocations.fetch_add(1, std::memory_order_relaxed);
+    this->live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+inline void allocation_registry::counters::clear() noexcept {
+    this->allocations.store(0, std::memory_order_relaxed);
+    this->deallocations.store(0, std::memory_order_relaxed);
+    this->allocated_bytes.store(0, std::memory_order_relaxed);
+    this->live_bytes.store(0, std::memory_order_relaxed);
+    this->peak_bytes.store(0, std::memory_order_relaxed);
+}
+
+inline void allocation_registry::record_allocate(std::size_t bytes, const char *tag) noexcept {
+    if constexpr (!enabled) return;
+    this->totals_.add(bytes);
+    this->histogram_[allocation_stats::bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+    if (tag_slot *slot = find_tag(tag)) slot->stats.add(bytes);
+}
+
+inline void allocation_registry::record_deallocate(std::size_t bytes, const char *tag) noexcept {
+    if constexpr (!enabled) return;
+    this->totals_.sub(bytes);
+    if (tag_slot *slot = find_tag(tag)) slot->stats.sub(bytes);
+}
+
+inline allocation_stats allocation_registry::snapshot() const noexcept {
+    allocation_stats s;
+    s.allocations = this->totals_.allocations.load(std::memory_order_relaxed);
+    s.deallocations = this->totals_.deallocations.load(std::memory_order_relaxed);
+    s.allocated_bytes = this->totals_.allocated_bytes.load(std::memory_order_relaxed);
+    s.live_bytes = this->totals_.live_bytes.load(std::memory_order_relaxed);
+    s.peak_bytes = this->totals_.peak_bytes.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < allocation_stats::histogram_size; ++i) {
+        s.histogram[i] = this->histogram_[i].load(std::memory_order_relaxed);
+    }
+    for (const tag_slot &slot : this->tags_) {
+        const char *tag = slot.tag.load(std::memory_order_acquire);
+        if (tag == nullptr) continue;
+        allocation_tag_stats &t = s.tags[s.tag_count++];
+        t.tag = tag;
+        t.allocations = slot.stats.allocations.load(std::memory_order_relaxed);
+        t.deallocations = slot.stats.deallocations.load(std::memory_order_relaxed);
+        t.live_bytes = slot.stats.live_bytes.load(std::memory_order_relaxed);
+        t.peak_bytes = slot.stats.peak_bytes.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+inline void allocation_registry::dump(std::ostream &os) const {
+    snapshot().dump(os);
+}
+
+inline void allocation_registry::reset() noexcept {
+    this->totals_.clear();
+    for (auto &h : this->histogram_) h.store(0, std::memory_order_relaxed);
+    for (tag_slot &slot : this->tags_) {
+        slot.tag.store(nullptr, std::memory_order_relaxed);
+        slot.stats.clear();
+    }
+}
+
+inline allocation_registry::tag_slot *allocation_registry::find_tag(const char *tag) noexcept {
+    if (tag == nullptr) return nullptr;
+    std::uintptr_t h = reinterpret_cast<std::uintptr_t>(tag);
+    h ^= h >> 17;
+    h *= 0x9e3779b97f4a7c15ull;
+    for (std::size_t i = 0; i < allocation_stats::max_tags; ++i) {
+        tag_slot &slot = this->tags_[(h + i) % allocation_stats::max_tags];
+        const char *cur = slot.tag.load(std::memory_order_acquire);
+        if (cur == tag) return &slot;
+        if (cur == nullptr) {
+            if (slot.tag.compare_exchange_strong(cur, tag, std::memory_order_acq_rel)) return &slot;
+            if (cur == tag) return &slot;
+        }
+    }
+    return nullptr;
+}
+
+/*
+ * The registry every instrumented_allocator reports to. Like the default
+ * size class pool it is never destroyed, so containers with static storage
+ * duration may still free memory during exit.
+ */
+inline allocation_registry &global_allocation_registry() {
+    static allocation_registry *registry = new allocation_registry;
+    return *registry;
+}
+
+/*
+ * Wraps another allocator and reports every allocation and deallocation to
+ * the global registry, optionally under a tag naming the container or call
+ * site, e.g. instrumented_allocator<int>(TINYSTL_CALL_SITE). Rebinding keeps
+ * the tag, so the nodes and control blocks of a container are counted with it.
+ */
+template <typename T, typename Base = allocator<T>>
+class instrumented_allocator {
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using base_type = Base;
+
+    template <typename U>
+    struct rebind {
+        using other = instrumented_allocator<U, typename Base::template rebind<U>::other>;
+    };
+
+public:
+    instrumented_allocator() = default;
+    explicit instrumented_allocator(const char *tag, const Base &base = Base()) : base_(base), tag_(tag) {}
+    instrumented_allocator(const instrumented_allocator &other) = default;
+    instrumented_allocator(instrumented_allocator &&other) = default;
+    instrumented_allocator &operator=(const instrumented_allocator &other) = default;
+    instrumented_allocator &operator=(instrumented_allocator &&other) = default;
+    template <typename U, typename B>
+    instrumented_allocator(const instrumented_allocator<U, B> &other) : base_(other.base()), tag_(other.tag()) {}
+
+    pointer allocate(size_type n);
+    void deallocate(pointer p, size_type n);
+    template <typename... Args>
+    void construct(pointer p, Args &&...args);
+    void destroy(pointer p);
+    pointer address(reference x) const noexcept;
+    size_type max_size() const noexcept;
+    const Base &base() const noexcept;
+    const char *tag() const noexcept;
+
+private:
+    Base base_;
+    const char *tag_ = nullptr;
+};
+
+template <typename T, typename B>
+typename instrumented_allocator<T, B>::pointer instrumented_allocator<T, B>::allocate(instrumented_allocator<T, B>::size_type n) {
+    pointer p = this->base_.allocate(n);
+    if constexpr (allocation_registry::enabled) {
+        if (p != nullptr) global_allocation_registry().record_allocate(n * sizeof(T), this->tag_);
+    }
+    return p;
+}
+
+template <typename T, typename B>
+void instrumented_allocator<T, B>::deallocate(instrumented_allocator<T, B>::pointer p, instrumented_allocator<T, B>::size_type n) {
+    if constexpr (allocation_registry::enabled) {
+        if (p != nullptr) global_allocation_registry().record_deallocate(n * sizeof(T), this->tag_);
+    }
+    this->base_.deallocate(p, n);
+}
+
+template <typename T, typename B>
+template <typename... Args>
+void instrumented_allocator<T, B>::construct(instrumented_allocator<T, B>::pointer p, Args &&...args) {
+    this->base_.construct(p, std::forward<Args>(args)...);
+}
+
+template <typename T, typename B>
+void instrumented_allocator<T, B>::destroy(instrumented_allocator<T, B>::pointer p) {
+    this->base_.destroy(p);
+}
+
+template <typename T, typename B>
+typename instrumented_allocator<T, B>::pointer instrumented_allocator<T, B>::address(instrumented_allocator<T, B>::reference x) const noexcept {
+    return std::addressof(x);
+}
+
+template <typename T, typename B>
+typename instrumented_allocator<T, B>::size_type instrumented_allocator<T, B>::max_size() const noexcept {
+    return this->base_.max_size();
+}
+
+template <typename T, typename B>
+const B &instrumented_allocator<T, B>::base() const noexcept {
+    return this->base_;
+}
+
+template <typename T, typename B>
+const char *instrumented_allocator<T, B>::tag() const noexcept {
+    return this->tag_;
+}
+
+template <typename T, typename B, typename U, typename C>
+bool operator==(const instrumented_allocator<T, B> &lhs, const instrumented_allocator<U, C> &rhs) noexcept {
+    return lhs.base() == rhs.base();
+}
+
+template <typename T, typename B, typename U, typename C>
+bool operator!=(const instrumented_allocator<T, B> &lhs, const instrumented_allocator<U, C> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Bump-pointer memory resource. Memory is handed out from a caller-provided
+ * buffer first and then from a chain of heap chunks that grow geometrically.
+ * Individual deallocations are ignored; release() frees everything at once.
+ */
+class monotonic_arena {
+public:
+    static constexpr std::size_t default_chunk_size = 4096;
+    static constexpr std::size_t max_chunk_size = 1024 * 1024;
+
+public:
+    monotonic_arena() noexcept : monotonic_arena(default_chunk_size) {}
+    explicit monotonic_arena(std::size_t chunk_size) noexcept;
+    monotonic_arena(void *buffer, std::size_t size) noexcept;
+    monotonic_arena(const monotonic_arena &other) = delete;
+    monotonic_arena &operator=(const monotonic_arena &other) = delete;
+    ~monotonic_arena();
+
+    void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+    void deallocate(void *p, std::size_t bytes) noexcept;
+    void release() noexcept;
+
+private:
+    struct chunk_header {
+        chunk_header *next;
+    };
+
+    void *allocate_from_new_chunk(std::size_t bytes, std::size_t align);
+
+private:
+    char *cursor_;
+    char *end_;
+    char *initial_buffer_;
+    std::size_t initial_size_;
+    chunk_header *chunks_ = nullptr;
+    std::size_t first_chunk_size_;
+    std::size_t next_chunk_size_;
+};
+
+inline monotonic_arena::monotonic_arena(std::size_t chunk_size) noexcept
+    : cursor_(nullptr), end_(nullptr), initial_buffer_(nullptr), initial_size_(0),
+      first_chunk_size_(chunk_size), next_chunk_size_(chunk_size) {}
+
+inline monotonic_arena::monotonic_arena(void *buffer, std::size_t size) noexcept
+    : cursor_(static_cast<char *>(buffer)), end_(static_cast<char *>(buffer) + size),
+      initial_buffer_(static_cast<char *>(buffer)), initial_size_(size),
+      first_chunk_size_(default_chunk_size), next_chunk_size_(default_chunk_size) {}
+
+inline monotonic_arena::~monotonic_arena() {
+    release();
+}
+
+inline void *monotonic_arena::allocate(std::size_t bytes, std::size_t align) {
+    std::uintptr_t cur = reinterpret_cast<std::uintptr_t>(this->cursor_);
+    std::uintptr_t aligned = (cur + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+    if (this->cursor_ != nullptr && aligned - cur + bytes <= static_cast<std::size_t>(this->end_ - this->cursor_)) {
+        this->cursor_ = reinterpret_cast<char *>(aligned) + bytes;
+        return reinterpret_cast<void *>(aligned);
+    }
+    return allocate_from_new_chunk(bytes, align);
+}
+
+inline void monotonic_arena::deallocate(void *, std::size_t) noexcept {}
+
+inline void monotonic_arena::release() noexcept {
+    while (this->chunks_ != nullptr) {
+        chunk_header *next = this->chunks_->next;
+        ::operator delete(this->chunks_);
+        this->chunks_ = next;
+    }
+    this->cursor_ = this->initial_buffer_;
+    this->end_ = this->initial_buffer_ + this->initial_size_;
+    this->next_chunk_size_ = this->first_chunk_size_;
+}
+
+inline void *monotonic_arena::allocate_from_new_chunk(std::size_t bytes, std::size_t align) {
+    const std::size_t header = (sizeof(chunk_header) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    std::size_t size = this->next_chunk_size_;
+    // oversized requests get a chunk of their own
+    if (size < header + bytes + align) size = header + bytes + align;
+    chunk_header *chunk = static_cast<chunk_header *>(::operator new(size));
+    chunk->next = this->chunks_;
+    this->chunks_ = chunk;
+    if (this->next_chunk_size_ < max_chunk_size) this->next_chunk_size_ *= 2;
+
+    this->cursor_ = reinterpret_cast<char *>(chunk) + header;
+    this->end_ = reinterpret_cast<char *>(chunk) + size;
+    return allocate(bytes, align);
+}
+
+/*
+ * An arena whose first buffer lives inside the object itself, so short-lived
+ * scratch data placed on the stack never touches the heap unless it outgrows N.
+ */
+template <std::size_t N>
+class inline_arena : public monotonic_arena {
+public:
+    inline_arena() noexcept : monotonic_arena(buffer_, N) {}
+
+private:
+    alignas(std::max_align_t) unsigned char buffer_[N];
+};
+
+template <typename T>
+class arena_allocator {
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+public:
+    arena_allocator(monotonic_arena &arena) noexcept : arena_(&arena) {}
+    arena_allocator(const arena_allocator &other) = default;
+    arena_allocator(arena_allocator &&other) = default;
+    arena_allocator<T> &operator=(const arena_allocator &other) = default;
+    arena_allocator<T> &operator=(arena_allocator &&other) = default;
+    template <typename U>
+    arena_allocator(const arena_allocator<U> &other) noexcept : arena_(other.arena()) {}
+
+    pointer allocate(size_type n);
+    void deallocate(pointer p, size_type n);
+    template <typename... Args>
+    void construct(pointer p, Args &&...args);
+    void destroy(pointer p);
+    pointer address(reference x) const noexcept;
+    size_type max_size() const noexcept;
+    monotonic_arena *arena() const noexcept;
+
+private:
+    monotonic_arena *arena_;
+};
+
+template <typename T>
+typename arena_allocator<T>::pointer arena_allocator<T>::allocate(arena_allocator<T>::size_type n) {
+    if (n == 0) return nullptr;
+    return static_cast<arena_allocator<T>::pointer>(this->arena_->allocate(n * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void arena_allocator<T>::deallocate(arena_allocator<T>::pointer p, arena_allocator<T>::size_type n) {
+    this->arena_->deallocate(p, n * sizeof(T));
+}
+
+template <typename T>
+template <typename... Args>
+void arena_allocator<T>::construct(arena_allocator<T>::pointer p, Args &&...args) {
+    new (p) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void arena_allocator<T>::destroy(arena_allocator<T>::pointer p) {
+    p->~T();
+}
+
+template <typename T>
+typename arena_allocator<T>::pointer arena_allocator<T>::address(arena_allocator<T>::reference x) const noexcept {
+    return std::addressof(x);
+}
+
+template <typename T>
+typename arena_allocator<T>::size_type arena_allocator<T>::max_size() const noexcept {
+    return static_cast<arena_allocator<T>::size_type>(-1) / sizeof(T);
+}
+
+template <typename T>
+monotonic_arena *arena_allocator<T>::arena() const noexcept {
+    return this->arena_;
+}
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T> &lhs, const arena_allocator<U> &rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T> &lhs, const arena_allocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <tinystl/memory.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * A shared_ptr slot that can be read and replaced concurrently without locks,
+ * built on split reference counts.
+ *
+ * The slot keeps the control block pointer in the low 48 bits of a single
+ * atomic word and a local count in the top 16 bits. While a control block is
+ * installed, the slot owns `batch` strong references to it. A reader takes
+ * one of them with a single fetch_add on the word, which bumps the local
+ * count and hands the reader a reference it owns outright, so load() never
+ * touches the shared count on the fast path and never waits. Once half the
+ * batch is handed out, a reader tops the slot up again by adding the local
+ * count to the strong count and resetting the local count with a CAS.
+ * Whoever swaps a control block out returns the references the slot still
+ * owns, batch minus the local count.
+ *
+ * This relies on user-space addresses fitting in 48 bits, as they do on
+ * x86-64 and AArch64. use_count() of a pointer loaded from the slot includes
+ * the references the slot holds in reserve.
+ */
+template <typename T, typename D = default_deleter<T>>
+class atomic_shared_ptr {
+    static_assert(sizeof(void *) == sizeof(std::uint64_t), "atomic_shared_ptr packs pointers into 48 bits");
+
+public:
+    using value_type = shared_ptr<T, D, atomic_count_policy>;
+
+    static constexpr std::size_t batch = std::size_t(1) << 15;
+
+public:
+    atomic_shared_ptr() noexcept : word_(0) {}
+    atomic_shared_ptr(value_type desired) noexcept;
+    atomic_shared_ptr(const atomic_shared_ptr &other) = delete;
+    atomic_shared_ptr &operator=(const atomic_shared_ptr &other) = delete;
+    atomic_shared_ptr &operator=(value_type desired) noexcept;
+    ~atomic_shared_ptr();
+
+    bool is_lock_free() const noexcept;
+    value_type load() const noexcept;
+    operator value_type() const noexcept;
+    void store(value_type desired) noexcept;
+    value_type exchange(value_type desired) noexcept;
+    bool compare_exchange_weak(value_type &expected, value_type desired) noexcept;
+    bool compare_exchange_strong(value_type &expected, value_type desired) noexcept;
+
+private:
+    using counter = reference_counter<T, atomic_count_policy>;
+
+    static constexpr int local_shift = 48;
+    static constexpr std::uint64_t local_one = std::uint64_t(1) << local_shift;
+    static constexpr std::uint64_t pointer_mask = local_one - 1;
+
+    static std::uint64_t pack(counter *rc) noexcept;
+    static counter *unpack(std::uint64_t w) noexcept;
+    static std::size_t local_count(std::uint64_t w) noexcept;
+    static counter *acquire_batch(value_type &sp) noexcept;
+    static void release_batch(std::uint64_t w, std::size_t keep) noexcept;
+    static value_type adopt(counter *rc) noexcept;
+    void replenish(counter *rc, std::uint64_t seen) const noexcept;
+
+private:
+    mutable std::atomic<std::uint64_t> word_;
+};
+
+template <typename T, typename D>
+atomic_shared_ptr<T, D>::atomic_shared_ptr(value_type desired) noexcept
+    : word_(pack(acquire_batch(desired))) {}
+
+template <typename T, typename D>
+atomic_shared_ptr<T, D> &atomic_shared_ptr<T, D>::operator=(value_type desired) noexcept {
+    store(std::move(desired));
+    return *this;
+}
+
+template <typename T, typename D>
+atomic_shared_ptr<T, D>::~atomic_shared_ptr() {
+    release_batch(this->word_.load(std::memory_order_acquire), 0);
+}
+
+template <typename T, typename D>
+bool atomic_shared_ptr<T, D>::is_lock_free() const noexcept {
+    return this->word_.is_lock_free();
+}
+
+template <typename T, typename D>
+typename atomic_shared_ptr<T, D>::value_type atomic_shared_ptr<T, D>::load() const noexcept {
+    // readers of an empty slot do not write to it
+    if (unpack(this->word_.load(std::memory_order_acquire)) == nullptr) return value_type();
+    std::uint64_t w = this->word_.fetch_add(local_one, std::memory_order_acquire) + local_one;
+    counter *rc = unpack(w);
+    // the local count of an empty slot is meaningless, a carry out of the
+    // top bits cannot reach the pointer
+    if (rc == nullptr) return value_type();
+    if (local_count(w) >= batch / 2) replenish(rc, w);
+    return adopt(rc);
+}
+
+template <typename T, typename D>
+atomic_shared_ptr<T, D>::operator value_type() const noexcept {
+    return load();
+}
+
+template <typename T, typename D>
+void atomic_shared_ptr<T, D>::store(value_type desired) noexcept {
+    std::uint64_t old = this->word_.exchange(pack(acquire_batch(desired)), std::memory_order_acq_rel);
+    release_batch(old, 0);
+}
+
+template <typename T, typename D>
+typename atomic_shared_ptr<T, D>::value_type atomic_shared_ptr<T, D>::exchange(value_type desired) noexcept {
+    std::uint64_t old = this->word_.exchange(pack(acquire_batch(desired)), std::memory_order_acq_rel);
+    release_batch(old, 1);
+    return adopt(unpack(old));
+}
+
+template <typename T, typename D>
+bool atomic_shared_ptr<T, D>::compare_exchange_weak(value_type &expected, value_type desired) noexcept {
+    return compare_exchange_strong(expected, std::move(desired));
+}
+
+/*
+ * Succeeds if the slot holds the same control block as expected; changes to
+ * the local count alone are retried. On failure expected receives the
+ * current value.
+ */
+template <typename T, typename D>
+bool atomic_shared_ptr<T, D>::compare_exchange_strong(value_type &expected, value_type desired) noexcept {
+    counter *target = expected.rc_;
+    std::uint64_t w = this->word_.load(std::memory_order_acquire);
+    if (unpack(w) == target) {
+        std::uint64_t next = pack(acquire_batch(desired));
+        while (unpack(w) == target) {
+            if (this->word_.compare_exchange_weak(w, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                release_batch(w, 0);
+                return true;
+            }
+        }
+        release_batch(next, 0);
+    }
+    expected = load();
+    return false;
+}
+
+template <typename T, typename D>
+std::uint64_t atomic_shared_ptr<T, D>::pack(counter *rc) noexcept {
+    return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(rc));
+}
+
+template <typename T, typename D>
+typename atomic_shared_ptr<T, D>::counter *atomic_shared_ptr<T, D>::unpack(std::uint64_t w) noexcept {
+    return reinterpret_cast<counter *>(static_cast<std::uintptr_t>(w & pointer_mask));
+}
+
+template <typename T, typename D>
+std::size_t atomic_shared_ptr<T, D>::local_count(std::uint64_t w) noexcept {
+    return static_cast<std::size_t>(w >> local_shift);
+}
+
+// takes over the reference of sp and tops it up to a full batch
+template <typename T, typename D>
+typename atomic_shared_ptr<T, D>::counter *atomic_shared_ptr<T, D>::acquire_batch(value_type &sp) noexcept {
+    counter *rc = sp.rc_;
+    sp.rc_ = nullptr;
+    if (rc != nullptr) rc->add_strong_references(batch - 1);
+    return rc;
+}
+
+// returns what the slot still owns of the batch in w, except `keep` references
+template <typename T, typename D>
+void atomic_shared_ptr<T, D>::release_batch(std::uint64_t w, std::size_t keep) noexcept {
+    counter *rc = unpack(w);
+    if (rc == nullptr) return;
+    std::size_t owned = batch - local_count(w) - keep;
+    if (owned != 0) rc->release_strong_references(owned);
+}
+
+template <typename T, typename D>
+typename atomic_shared_ptr<T, D>::value_type atomic_shared_ptr<T, D>::adopt(counter *rc) noexcept {
+    value_type ret;
+    ret.rc_ = rc;
+    return ret;
+}
+
+/*
+ * Turns the references handed out so far into ordinary strong references
+ * and resets the local count. The caller owns a reference to rc, so the
+ * undo after a lost race can never drop the count to zero.
+ */
+template <typename T, typename D>
+void atomic_shared_ptr<T, D>::replenish(counter *rc, std::uint64_t seen) const noexcept {
+    while (unpack(seen) == rc && local_count(seen) >= batch / 2) {
+        std::size_t n = local_count(seen);
+        rc->add_strong_references(n);
+        if (this->word_.compare_exchange_weak(seen, pack(rc), std::memory_order_release, std::memory_order_relaxed)) return;
+        rc->release_strong_references(n);
+    }
+}
+
+}  // namespace tinystl
@@ -0,0 +1,759 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl {
+
+// elements per block: about 4 KiB worth, as a power of two, and at least 16
+constexpr std::size_t deque_block_size(std::size_t element_size) noexcept {
+    std::size_t n = 16;
+    while (n * 2 * element_size <= 4096) n *= 2;
+    return n;
+}
+
+/*
+ * Iterator over a deque: a position counted from the start of the block map,
+ * so that stepping is plain arithmetic and the block is only looked up on
+ * dereference. Positions do not depend on which block comes first, so
+ * iterators to elements that survive a pop_front() still compare with new
+ * ones. T is const-qualified for const_iterator.
+ */
+template <typename T, std::size_t BlockSize>
+class deque_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename std::remove_const<T>::type;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using pointer = T *;
+
+public:
+    deque_iterator() noexcept : blocks_(nullptr), pos_(0) {}
+    deque_iterator(T *const *blocks, std::size_t pos) noexcept : blocks_(blocks), pos_(pos) {}
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    deque_iterator(const deque_iterator<U, BlockSize> &other) noexcept : blocks_(other.blocks()), pos_(other.position()) {}
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    reference operator[](difference_type n) const noexcept;
+    deque_iterator &operator++() noexcept;
+    deque_iterator operator++(int) noexcept;
+    deque_iterator &operator--() noexcept;
+    deque_iterator operator--(int) noexcept;
+    deque_iterator &operator+=(difference_type n) noexcept;
+    deque_iterator &operator-=(difference_type n) noexcept;
+    deque_iterator operator+(difference_type n) const noexcept;
+    deque_iterator operator-(difference_type n) const noexcept;
+    difference_type operator-(const deque_iterator &other) const noexcept;
+
+    bool operator==(const deque_iterator &other) const noexcept;
+    bool operator!=(const deque_iterator &other) const noexcept;
+    bool operator<(const deque_iterator &other) const noexcept;
+    bool operator>(const deque_iterator &other) const noexcept;
+    bool operator<=(const deque_iterator &other) const noexcept;
+    bool operator>=(const deque_iterator &other) const noexcept;
+
+    T *const *blocks() const noexcept;
+    std::size_t position() const noexcept;
+
+private:
+    T *const *blocks_;
+    std::size_t pos_;
+};
+
+template <typename T, std::size_t B>
+typename deque_iterator<T, B>::reference deque_iterator<T, B>::operator*() const noexcept {
+    return this->blocks_[this->pos_ / B][this->pos_ % B];
+}
+
+template <typename T, std::size_t B>
+typename deque_iterator<T, B>::pointer deque_iterator<T, B>::operator->() const noexcept {
+    return this->blocks_[this->pos_ / B] + this->pos_ % B;
+}
+
+template <typename T, std::size_t B>
+typename deque_iterator<T, B>::reference deque_iterator<T, B>::operator[](difference_type n) const noexcept {
+    return *(*this + n);
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> &deque_iterator<T, B>::operator++() noexcept {
+    ++this->pos_;
+    return *this;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> deque_iterator<T, B>::operator++(int) noexcept {
+    deque_iterator tmp = *this;
+    ++this->pos_;
+    return tmp;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> &deque_iterator<T, B>::operator--() noexcept {
+    --this->pos_;
+    return *this;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> deque_iterator<T, B>::operator--(int) noexcept {
+    deque_iterator tmp = *this;
+    --this->pos_;
+    return tmp;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> &deque_iterator<T, B>::operator+=(difference_type n) noexcept {
+    this->pos_ += static_cast<std::size_t>(n);
+    return *this;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> &deque_iterator<T, B>::operator-=(difference_type n) noexcept {
+    this->pos_ -= static_cast<std::size_t>(n);
+    return *this;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> deque_iterator<T, B>::operator+(difference_type n) const noexcept {
+    return deque_iterator(this->blocks_, this->pos_ + static_cast<std::size_t>(n));
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> deque_iterator<T, B>::operator-(difference_type n) const noexcept {
+    return deque_iterator(this->blocks_, this->pos_ - static_cast<std::size_t>(n));
+}
+
+template <typename T, std::size_t B>
+typename deque_iterator<T, B>::difference_type deque_iterator<T, B>::operator-(const deque_iterator &other) const noexcept {
+    return static_cast<difference_type>(this->pos_ - other.pos_);
+}
+
+template <typename T, std::size_t B>
+bool deque_iterator<T, B>::operator==(const deque_iterator &other) const noexcept {
+    return this->pos_ == other.pos_;
+}
+
+template <typename T, std::size_t B>
+bool deque_iterator<T, B>::operator!=(const deque_iterator &other) const noexcept {
+    return this->pos_ != other.pos_;
+}
+
+template <typename T, std::size_t B>
+bool deque_iterator<T, B>::operator<(const deque_iterator &other) const noexcept {
+    return this->pos_ < other.pos_;
+}
+
+template <typename T, std::size_t B>
+bool deque_iterator<T, B>::operator>(const deque_iterator &other) const noexcept {
+    return this->pos_ > other.pos_;
+}
+
+template <typename T, std::size_t B>
+bool deque_iterator<T, B>::operator<=(const deque_iterator &other) const noexcept {
+    return this->pos_ <= other.pos_;
+}
+
+template <typename T, std::size_t B>
+bool deque_iterator<T, B>::operator>=(const deque_iterator &other) const noexcept {
+    return this->pos_ >= other.pos_;
+}
+
+template <typename T, std::size_t B>
+T *const *deque_iterator<T, B>::blocks() const noexcept {
+    return this->blocks_;
+}
+
+template <typename T, std::size_t B>
+std::size_t deque_iterator<T, B>::position() const noexcept {
+    return this->pos_;
+}
+
+template <typename T, std::size_t B>
+deque_iterator<T, B> operator+(typename deque_iterator<T, B>::difference_type n, const deque_iterator<T, B> &it) noexcept {
+    return it + n;
+}
+
+/*
+ * Double-ended queue made of fixed-size blocks and a map of block pointers.
+ * Elements never move once constructed, so pushing at either end leaves
+ * pointers and references to the others valid and costs at most one block
+ * allocation; only the map of pointers is ever copied when it fills up, and
+ * it is block_size times smaller than the elements.
+ *
+ * The blocks in use sit contiguously in map_[first_block_, last_block_), and
+ * the elements occupy positions [offset_, offset_ + size_) counted from the
+ * start of map_[first_block_]. A block emptied at either end is kept as a
+ * spare for the next block needed, so a deque used as a queue settles into
+ * reusing the same blocks instead of going back to the allocator.
+ *
+ * tail_ and tail_end_ cache where the next push_back goes and the end of
+ * its block, or are both null when the next push_back needs a new block.
+ */
+template <typename T, typename Allocator = allocator<T>>
+class deque {
+public:
+    static constexpr std::size_t block_size = deque_block_size(sizeof(T));
+
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = deque_iterator<T, block_size>;
+    using const_iterator = deque_iterator<const T, block_size>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    template <typename It>
+    using enable_if_iterator = typename std::enable_if<
+        std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>::type;
+
+public:
+    deque() noexcept : deque(Allocator()) {}
+    explicit deque(const Allocator &alloc) noexcept;
+    explicit deque(size_type n, const Allocator &alloc = Allocator());
+    deque(size_type n, const T &value, const Allocator &alloc = Allocator());
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    deque(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+    deque(std::initializer_list<T> il, const Allocator &alloc = Allocator());
+    deque(const deque &other);
+    deque(deque &&other) noexcept;
+    deque &operator=(const deque &other);
+    deque &operator=(deque &&other) noexcept;
+    deque &operator=(std::initializer_list<T> il);
+    ~deque();
+
+    allocator_type get_allocator() const;
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) noexcept;
+    const_reference operator[](size_type pos) const noexcept;
+    reference front() noexcept;
+    const_reference front() const noexcept;
+    reference back() noexcept;
+    const_reference back() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void shrink_to_fit();
+
+    void clear() noexcept;
+    void push_back(const T &value);
+    void push_back(T &&value);
+    template <typename... Args>
+    reference emplace_back(Args &&...args);
+    void push_front(const T &value);
+    void push_front(T &&value);
+    template <typename... Args>
+    reference emplace_front(Args &&...args);
+    void pop_back() noexcept;
+    void pop_front() noexcept;
+    void resize(size_type n);
+    void resize(size_type n, const T &value);
+    void swap(deque &other) noexcept;
+
+private:
+    using map_allocator = typename Allocator::template rebind<T *>::other;
+
+    T *slot(size_type pos) const noexcept;
+    size_type block_count() const noexcept;
+    void sync_tail() noexcept;
+    void reserve_map_back();
+    void reserve_map_front();
+    void reshape_map();
+    T *acquire_block();
+    void release_block(T *block) noexcept;
+    void release_all() noexcept;
+
+private:
+    T **map_;
+    size_type map_cap_;
+    size_type first_block_;
+    size_type last_block_;
+    size_type offset_;
+    size_type size_;
+    T *tail_;
+    T *tail_end_;
+    T *spare_;
+    Allocator alloc_;
+};
+
+template <typename T, typename A>
+deque<T, A>::deque(const A &alloc) noexcept
+    : map_(nullptr), map_cap_(0), first_block_(0), last_block_(0), offset_(0), size_(0), tail_(nullptr), tail_end_(nullptr),
+      spare_(nullptr), alloc_(alloc) {}
+
+/*
+ * The constructors below delegate to the allocator constructor, so the
+ * destructor cleans up whatever they have built if they throw.
+ */
+template <typename T, typename A>
+deque<T, A>::deque(size_type n, const A &alloc)
+    : deque(alloc) {
+    resize(n);
+}
+
+template <typename T, typename A>
+deque<T, A>::deque(size_type n, const T &value, const A &alloc)
+    : deque(alloc) {
+    resize(n, value);
+}
+
+template <typename T, typename A>
+template <typename InputIt, typename>
+deque<T, A>::deque(InputIt first, InputIt last, const A &alloc)
+    : deque(alloc) {
+    for (; first != last; ++first) emplace_back(*first);
+}
+
+template <typename T, typename A>
+deque<T, A>::deque(std::initializer_list<T> il, const A &alloc)
+    : deque(il.begin(), il.end(), alloc) {}
+
+template <typename T, typename A>
+deque<T, A>::deque(const deque &other)
+    : deque(other.begin(), other.end(), other.alloc_) {}
+
+template <typename T, typename A>
+deque<T, A>::deque(deque &&other) noexcept
+    : map_(other.map_), map_cap_(other.map_cap_), first_block_(other.first_block_), last_block_(other.last_block_),
+      offset_(other.offset_), size_(other.size_), tail_(other.tail_), tail_end_(other.tail_end_), spare_(other.spare_),
+      alloc_(std::move(other.alloc_)) {
+    other.map_ = nullptr;
+    other.tail_ = other.tail_end_ = other.spare_ = nullptr;
+    other.map_cap_ = other.first_block_ = other.last_block_ = other.offset_ = other.size_ = 0;
+}
+
+template <typename T, typename A>
+deque<T, A> &deque<T, A>::operator=(const deque &other) {
+    if (this != &other) {
+        deque tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename T, typename A>
+deque<T, A> &deque<T, A>::operator=(deque &&other) noexcept {
+    if (this != &other) {
+        deque tmp(std::move(other));
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename T, typename A>
+deque<T, A> &deque<T, A>::operator=(std::initializer_list<T> il) {
+    deque tmp(il, this->alloc_);
+    swap(tmp);
+    return *this;
+}
+
+template <typename T, typename A>
+deque<T, A>::~deque() {
+    clear();
+    release_all();
+}
+
+template <typename T, typename A>
+typename deque<T, A>::allocator_type deque<T, A>::get_allocator() const {
+    return this->alloc_;
+}
+
+template <typename T, typename A>
+typename deque<T, A>::reference deque<T, A>::at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("tinystl::deque::at");
+    return *slot(pos);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reference deque<T, A>::at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("tinystl::deque::at");
+    return *slot(pos);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::reference deque<T, A>::operator[](size_type pos) noexcept {
+    return *slot(pos);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reference deque<T, A>::operator[](size_type pos) const noexcept {
+    return *slot(pos);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::reference deque<T, A>::front() noexcept {
+    return this->map_[this->first_block_][this->offset_];
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reference deque<T, A>::front() const noexcept {
+    return this->map_[this->first_block_][this->offset_];
+}
+
+template <typename T, typename A>
+typename deque<T, A>::reference deque<T, A>::back() noexcept {
+    return *slot(this->size_ - 1);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reference deque<T, A>::back() const noexcept {
+    return *slot(this->size_ - 1);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::iterator deque<T, A>::begin() noexcept {
+    return iterator(this->map_, this->first_block_ * block_size + this->offset_);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_iterator deque<T, A>::begin() const noexcept {
+    return const_iterator(this->map_, this->first_block_ * block_size + this->offset_);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_iterator deque<T, A>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, typename A>
+typename deque<T, A>::iterator deque<T, A>::end() noexcept {
+    return iterator(this->map_, this->first_block_ * block_size + this->offset_ + this->size_);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_iterator deque<T, A>::end() const noexcept {
+    return const_iterator(this->map_, this->first_block_ * block_size + this->offset_ + this->size_);
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_iterator deque<T, A>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, typename A>
+typename deque<T, A>::reverse_iterator deque<T, A>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reverse_iterator deque<T, A>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reverse_iterator deque<T, A>::crbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename A>
+typename deque<T, A>::reverse_iterator deque<T, A>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reverse_iterator deque<T, A>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, typename A>
+typename deque<T, A>::const_reverse_iterator deque<T, A>::crend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, typename A>
+bool deque<T, A>::empty() const noexcept {
+    return this->size_ == 0;
+}
+
+template <typename T, typename A>
+typename deque<T, A>::size_type deque<T, A>::size() const noexcept {
+    return this->size_;
+}
+
+template <typename T, typename A>
+typename deque<T, A>::size_type deque<T, A>::max_size() const noexcept {
+    return this->alloc_.max_size();
+}
+
+// hands the spare block back; blocks in use and the map stay as they are
+template <typename T, typename A>
+void deque<T, A>::shrink_to_fit() {
+    if (this->spare_ != nullptr) {
+        this->alloc_.deallocate(this->spare_, block_size);
+        this->spare_ = nullptr;
+    }
+}
+
+template <typename T, typename A>
+void deque<T, A>::clear() noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        // one destroy_n per block rather than a lookup per element
+        size_type pos = this->offset_;
+        size_type end = this->offset_ + this->size_;
+        while (pos < end) {
+            size_type n = std::min(block_size - pos % block_size, end - pos);
+            destroy_n(this->alloc_, slot(pos - this->offset_), n);
+            pos += n;
+        }
+    }
+    // keep the first block, so the next push does not allocate
+    while (block_count() > 1) release_block(this->map_[--this->last_block_]);
+    this->offset_ = 0;
+    this->size_ = 0;
+    sync_tail();
+}
+
+template <typename T, typename A>
+void deque<T, A>::push_back(const T &value) {
+    emplace_back(value);
+}
+
+template <typename T, typename A>
+void deque<T, A>::push_back(T &&value) {
+    emplace_back(std::move(value));
+}
+
+/*
+ * Elements never move, so args may refer into the deque. A new block is
+ * only linked in once its first element is built, which keeps every block
+ * in the map non-empty while the deque is.
+ */
+template <typename T, typename A>
+template <typename... Args>
+typename deque<T, A>::reference deque<T, A>::emplace_back(Args &&...args) {
+    if (this->tail_ != this->tail_end_) {
+        T *p = this->tail_;
+        this->alloc_.construct(p, std::forward<Args>(args)...);
+        ++this->tail_;
+        ++this->size_;
+        return *p;
+    }
+    reserve_map_back();
+    T *block = acquire_block();
+    try {
+        this->alloc_.construct(block, std::forward<Args>(args)...);
+    } catch (...) {
+        release_block(block);
+        throw;
+    }
+    this->map_[this->last_block_++] = block;
+    ++this->size_;
+    this->tail_ = block + 1;
+    this->tail_end_ = block + block_size;
+    return *block;
+}
+
+template <typename T, typename A>
+void deque<T, A>::push_front(const T &value) {
+    emplace_front(value);
+}
+
+template <typename T, typename A>
+void deque<T, A>::push_front(T &&value) {
+    emplace_front(std::move(value));
+}
+
+template <typename T, typename A>
+template <typename... Args>
+typename deque<T, A>::reference deque<T, A>::emplace_front(Args &&...args) {
+    if (this->offset_ != 0) {
+        T *p = this->map_[this->first_block_] + (this->offset_ - 1);
+        this->alloc_.construct(p, std::forward<Args>(args)...);
+        --this->offset_;
+        ++this->size_;
+        return *p;
+    }
+    reserve_map_front();
+    T *block = acquire_block();
+    T *p = block + (block_size - 1);
+    try {
+        this->alloc_.construct(p, std::forward<Args>(args)...);
+    } catch (...) {
+        release_block(block);
+        throw;
+    }
+    this->map_[--this->first_block_] = block;
+    this->offset_ = block_size - 1;
+    ++this->size_;
+    return *p;
+}
+
+template <typename T, typename A>
+void deque<T, A>::pop_back() noexcept {
+    --this->size_;
+    this->alloc_.destroy(slot(this->size_));
+    if (this->offset_ + this->size_ <= (block_count() - 1) * block_size) {
+        release_block(this->map_[--this->last_block_]);
+    }
+    sync_tail();
+}
+
+template <typename T, typename A>
+void deque<T, A>::pop_front() noexcept {
+    this->alloc_.destroy(this->map_[this->first_block_] + this->offset_);
+    --this->size_;
+    if (++this->offset_ == block_size) {
+        release_block(this->map_[this->first_block_++]);
+        this->offset_ = 0;
+        // the block released may have been the last one
+        if (this->size_ == 0) sync_tail();
+    }
+}
+
+template <typename T, typename A>
+void deque<T, A>::resize(size_type n) {
+    while (this->size_ > n) pop_back();
+    while (this->size_ < n) emplace_back();
+}
+
+template <typename T, typename A>
+void deque<T, A>::resize(size_type n, const T &value) {
+    while (this->size_ > n) pop_back();
+    while (this->size_ < n) emplace_back(value);
+}
+
+template <typename T, typename A>
+void deque<T, A>::swap(deque &other) noexcept {
+    std::swap(this->map_, other.map_);
+    std::swap(this->map_cap_, other.map_cap_);
+    std::swap(this->first_block_, other.first_block_);
+    std::swap(this->last_block_, other.last_block_);
+    std::swap(this->offset_, other.offset_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->tail_, other.tail_);
+    std::swap(this->tail_end_, other.tail_end_);
+    std::swap(this->spare_, other.spare_);
+    std::swap(this->alloc_, other.alloc_);
+}
+
+// block_size is a power of two, so this is a shift and a mask; offset_ is
+// always inside the first block, which front() and pop_front() rely on
+template <typename T, typename A>
+T *deque<T, A>::slot(size_type pos) const noexcept {
+    pos += this->offset_;
+    return this->map_[this->first_block_ + pos / block_size] + pos % block_size;
+}
+
+template <typename T, typename A>
+typename deque<T, A>::size_type deque<T, A>::block_count() const noexcept {
+    return this->last_block_ - this->first_block_;
+}
+
+template <typename T, typename A>
+void deque<T, A>::sync_tail() noexcept {
+    size_type pos = this->offset_ + this->size_;
+    if (pos == block_count() * block_size) {
+        this->tail_ = this->tail_end_ = nullptr;
+    } else {
+        T *block = this->map_[this->first_block_ + pos / block_size];
+        this->tail_ = block + pos % block_size;
+        this->tail_end_ = block + block_size;
+    }
+}
+
+template <typename T, typename A>
+void deque<T, A>::reserve_map_back() {
+    if (this->last_block_ == this->map_cap_) reshape_map();
+}
+
+template <typename T, typename A>
+void deque<T, A>::reserve_map_front() {
+    if (this->first_block_ == 0) reshape_map();
+}
+
+/*
+ * Centres the block pointers in the map, doubling it first unless they fill
+ * less than half of it, so that both ends have room again.
+ */
+template <typename T, typename A>
+void deque<T, A>::reshape_map() {
+    size_type used = block_count();
+    if ((used + 1) * 2 <= this->map_cap_) {
+        size_type first = (this->map_cap_ - used) / 2;
+        std::memmove(this->map_ + first, this->map_ + this->first_block_, used * sizeof(T *));
+        this->first_block_ = first;
+        this->last_block_ = first + used;
+        return;
+    }
+    map_allocator map_alloc(this->alloc_);
+    size_type new_cap = std::max<size_type>(8, this->map_cap_ * 2);
+    T **new_map = map_alloc.allocate(new_cap);
+    size_type first = (new_cap - used) / 2;
+    if (used != 0) std::memcpy(new_map + first, this->map_ + this->first_block_, used * sizeof(T *));
+    if (this->map_ != nullptr) map_alloc.deallocate(this->map_, this->map_cap_);
+    this->map_ = new_map;
+    this->map_cap_ = new_cap;
+    this->first_block_ = first;
+    this->last_block_ = first + used;
+}
+
+template <typename T, typename A>
+T *deque<T, A>::acquire_block() {
+    if (this->spare_ == nullptr) return this->alloc_.allocate(block_size);
+    T *block = this->spare_;
+    this->spare_ = nullptr;
+    return block;
+}
+
+template <typename T, typename A>
+void deque<T, A>::release_block(T *block) noexcept {
+    if (this->spare_ == nullptr) {
+        this->spare_ = block;
+    } else {
+        this->alloc_.deallocate(block, block_size);
+    }
+}
+
+template <typename T, typename A>
+void deque<T, A>::release_all() noexcept {
+    for (size_type i = this->first_block_; i < this->last_block_; ++i) this->alloc_.deallocate(this->map_[i], block_size);
+    shrink_to_fit();
+    if (this->map_ != nullptr) map_allocator(this->alloc_).deallocate(this->map_, this->map_cap_);
+}
+
+template <typename T, typename A>
+bool operator==(const deque<T, A> &lhs, const deque<T, A> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename A>
+bool operator!=(const deque<T, A> &lhs, const deque<T, A> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename A>
+void swap(deque<T, A> &lhs, deque<T, A> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,960 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TINYSTL_HAVE_SSE2 1
+#endif
+
+namespace tinystl {
+
+/*
+ * Control bytes of an open-addressing table, one per slot and kept apart from
+ * the slots themselves. A full slot stores the low 7 bits of its hash (h2),
+ * so a probe compares 16 control bytes against h2 at once and only touches
+ * slots whose byte matches.
+ */
+using hash_ctrl_t = signed char;
+
+constexpr hash_ctrl_t hash_ctrl_empty = -128;
+constexpr hash_ctrl_t hash_ctrl_deleted = -2;
+
+/*
+ * A window of group_width control bytes starting at any slot. Bit i of each
+ * mask stands for the i-th byte of the window.
+ */
+class hash_group {
+public:
+    static constexpr std::size_t width = 16;
+
+public:
+    explicit hash_group(const hash_ctrl_t *ctrl) noexcept;
+
+    std::uint32_t match(hash_ctrl_t h2) const noexcept;
+    std::uint32_t match_empty() const noexcept;
+    std::uint32_t match_empty_or_deleted() const noexcept;
+
+    static unsigned trailing_zeros(std::uint32_t mask) noexcept;
+    static unsigned leading_zeros(std::uint32_t mask) noexcept;
+
+private:
+#ifdef TINYSTL_HAVE_SSE2
+    __m128i ctrl_;
+#else
+    const hash_ctrl_t *ctrl_;
+#endif
+};
+
+#ifdef TINYSTL_HAVE_SSE2
+
+inline hash_group::hash_group(const hash_ctrl_t *ctrl) noexcept
+    : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+inline std::uint32_t hash_group::match(hash_ctrl_t h2) const noexcept {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), this->ctrl_)));
+}
+
+inline std::uint32_t hash_group::match_empty() const noexcept {
+    return match(hash_ctrl_empty);
+}
+
+// empty and deleted are the only control values below -1
+inline std::uint32_t hash_group::match_empty_or_deleted() const noexcept {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), this->ctrl_)));
+}
+
+#else
+
+inline hash_group::hash_group(const hash_ctrl_t *ctrl) noexcept : ctrl_(ctrl) {}
+
+inline std::uint32_t hash_group::match(hash_ctrl_t h2) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+        if (this->ctrl_[i] == h2) mask |= std::uint32_t(1) << i;
+    }
+    return mask;
+}
+
+inline std::uint32_t hash_group::match_empty() const noexcept {
+    return match(hash_ctrl_empty);
+}
+
+inline std::uint32_t hash_group::match_empty_or_deleted() const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+        if (this->ctrl_[i] < -1) mask |= std::uint32_t(1) << i;
+    }
+    return mask;
+}
+
+#endif
+
+inline unsigned hash_group::trailing_zeros(std::uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// counted within the 16 bits of a group mask
+inline unsigned hash_group::leading_zeros(std::uint32_t mask) noexcept {
+    unsigned n = 0;
+    for (std::uint32_t bit = std::uint32_t(1) << (width - 1); bit != 0 && (mask & bit) == 0; bit >>= 1) ++n;
+    return n;
+}
+
+template <typename T, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+/*
+ * Swiss-table style hash map. Capacity is a power of two of at least one
+ * group; the control array has group_width extra bytes at the end that mirror
+ * the first ones, so a group can be loaded at any slot without wrapping.
+ * Probing moves in group-sized steps of growing length (triangular numbers),
+ * which visits every group of a power-of-two table. Tables are kept at most
+ * 7/8 full, counting tombstones; when they run out, the table is rebuilt at
+ * the same size if tombstones take most of the room and at twice the size
+ * otherwise.
+ *
+ * Lookups with a type other than K are enabled when both Hash and Eq define
+ * is_transparent. References and iterators are invalidated by any insertion
+ * that rehashes.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>,
+          typename Allocator = allocator<std::pair<const K, V>>>
+class flat_hash_map {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+    using allocator_type = Allocator;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+
+private:
+    using slot_allocator = typename Allocator::template rebind<value_type>::other;
+    using ctrl_allocator = typename Allocator::template rebind<hash_ctrl_t>::other;
+
+    template <typename Q, typename R = void>
+    using enable_if_transparent = typename std::enable_if<!std::is_same<Q, K>::value && is_transparent<Hash>::value && is_transparent<Eq>::value, R>::type;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = flat_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const value_type *, value_type *>::type;
+        using reference = typename std::conditional<Const, const value_type &, value_type &>::type;
+
+    public:
+        basic_iterator() noexcept : ctrl_(nullptr), slot_(nullptr), end_(nullptr) {}
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        basic_iterator(const basic_iterator<false> &other) noexcept : ctrl_(other.ctrl_), slot_(other.slot_), end_(other.end_) {}
+
+        reference operator*() const noexcept { return *this->slot_; }
+        pointer operator->() const noexcept { return this->slot_; }
+        basic_iterator &operator++() noexcept {
+            ++this->ctrl_;
+            ++this->slot_;
+            skip_empty();
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            basic_iterator ret(*this);
+            ++*this;
+            return ret;
+        }
+        friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.ctrl_ == rhs.ctrl_; }
+        friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.ctrl_ != rhs.ctrl_; }
+
+    private:
+        basic_iterator(const hash_ctrl_t *ctrl, value_type *slot, const hash_ctrl_t *end) noexcept
+            : ctrl_(ctrl), slot_(slot), end_(end) {}
+        void skip_empty() noexcept {
+            while (this->ctrl_ != this->end_ && *this->ctrl_ < 0) {
+                ++this->ctrl_;
+                ++this->slot_;
+            }
+        }
+
+    private:
+        const hash_ctrl_t *ctrl_;
+        value_type *slot_;
+        const hash_ctrl_t *end_;
+
+    private:
+        friend class flat_hash_map;
+        friend class basic_iterator<!Const>;
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+public:
+    flat_hash_map() noexcept(std::is_nothrow_default_constructible<Hash>::value && std::is_nothrow_default_constructible<Eq>::value);
+    explicit flat_hash_map(size_type bucket_count, const Hash &hash = Hash(), const Eq &eq = Eq(), const Allocator &alloc = Allocator());
+    template <typename InputIt>
+    flat_hash_map(InputIt first, InputIt last, size_type bucket_count = 0, const Hash &hash = Hash(), const Eq &eq = Eq(), const Allocator &alloc = Allocator());
+    flat_hash_map(std::initializer_list<value_type> il, size_type bucket_count = 0, const Hash &hash = Hash(), const Eq &eq = Eq(), const Allocator &alloc = Allocator());
+    flat_hash_map(const flat_hash_map &other);
+    flat_hash_map(flat_hash_map &&other) noexcept;
+    flat_hash_map &operator=(const flat_hash_map &other);
+    flat_hash_map &operator=(flat_hash_map &&other) noexcept;
+    ~flat_hash_map();
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    size_type capacity() const noexcept;
+    float load_factor() const noexcept;
+    void reserve(size_type n);
+    void rehash(size_type n);
+
+    void clear() noexcept;
+    std::pair<iterator, bool> insert(const value_type &value);
+    std::pair<iterator, bool> insert(value_type &&value);
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last);
+    void insert(std::initializer_list<value_type> il);
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K &key, M &&obj);
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(K &&key, M &&obj);
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args);
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&...args);
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K &&key, Args &&...args);
+    iterator erase(const_iterator pos);
+    iterator erase(iterator pos);
+    size_type erase(const K &key);
+    template <typename Q, typename = enable_if_transparent<Q>>
+    size_type erase(const Q &key);
+    void swap(flat_hash_map &other) noexcept;
+
+    V &at(const K &key);
+    const V &at(const K &key) const;
+    V &operator[](const K &key);
+    V &operator[](K &&key);
+    iterator find(const K &key);
+    const_iterator find(const K &key) const;
+    template <typename Q, typename = enable_if_transparent<Q>>
+    iterator find(const Q &key);
+    template <typename Q, typename = enable_if_transparent<Q>>
+    const_iterator find(const Q &key) const;
+    size_type count(const K &key) const;
+    template <typename Q, typename = enable_if_transparent<Q>>
+    size_type count(const Q &key) const;
+    bool contains(const K &key) const;
+    template <typename Q, typename = enable_if_transparent<Q>>
+    bool contains(const Q &key) const;
+
+    hasher hash_function() const;
+    key_equal key_eq() const;
+    allocator_type get_allocator() const;
+
+private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type min_capacity = hash_group::width;
+    // whether hashing a key and moving an element, key included, never throw
+    static constexpr bool nothrow_rehash =
+        noexcept(std::declval<const Hash &>()(std::declval<const K &>())) &&
+        (is_trivially_relocatable<value_type>::value || (std::is_nothrow_move_constructible<K>::value && std::is_nothrow_move_constructible<V>::value));
+
+    static std::size_t mix(std::size_t h) noexcept;
+    static std::size_t h1(std::size_t hash) noexcept;
+    static hash_ctrl_t h2(std::size_t hash) noexcept;
+    static size_type max_load(size_type capacity) noexcept;
+    static size_type capacity_for(size_type n) noexcept;
+
+    template <typename Q>
+    std::size_t hash_of(const Q &key) const;
+    template <typename Q>
+    size_type find_index(const Q &key, std::size_t hash) const;
+    size_type find_first_non_full(std::size_t hash) const noexcept;
+    size_type prepare_insert(std::size_t hash);
+    void commit_insert(size_type i, std::size_t hash) noexcept;
+    template <typename Q, typename... Args>
+    std::pair<iterator, bool> emplace_key(Q &&key, Args &&...args);
+    void set_ctrl(size_type i, hash_ctrl_t h) noexcept;
+    void erase_at(size_type i) noexcept;
+    void rehash_and_grow();
+    void resize(size_type new_capacity);
+    void allocate_storage(size_type capacity);
+    void relocate_slot(value_type *from, value_type *to) noexcept;
+    void destroy_slots() noexcept;
+    void deallocate_storage() noexcept;
+    iterator iterator_at(size_type i) noexcept;
+    const_iterator iterator_at(size_type i) const noexcept;
+
+private:
+    hash_ctrl_t *ctrl_;
+    value_type *slots_;
+    size_type capacity_;
+    size_type size_;
+    size_type growth_left_;
+    Hash hash_;
+    Eq eq_;
+    slot_allocator alloc_;
+};
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A>::flat_hash_map() noexcept(std::is_nothrow_default_constructible<H>::value && std::is_nothrow_default_constructible<E>::value)
+    : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0), hash_(), eq_(), alloc_() {}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A>::flat_hash_map(size_type bucket_count, const H &hash, const E &eq, const A &alloc)
+    : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0), hash_(hash), eq_(eq), alloc_(alloc) {
+    if (bucket_count != 0) reserve(bucket_count);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename InputIt>
+flat_hash_map<K, V, H, E, A>::flat_hash_map(InputIt first, InputIt last, size_type bucket_count, const H &hash, const E &eq, const A &alloc)
+    : flat_hash_map(bucket_count, hash, eq, alloc) {
+    insert(first, last);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A>::flat_hash_map(std::initializer_list<value_type> il, size_type bucket_count, const H &hash, const E &eq, const A &alloc)
+    : flat_hash_map(il.begin(), il.end(), bucket_count, hash, eq, alloc) {}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A>::flat_hash_map(const flat_hash_map &other)
+    : flat_hash_map(0, other.hash_, other.eq_, other.alloc_) {
+    reserve(other.size());
+    for (const value_type &value : other) {
+        size_type i = prepare_insert(hash_of(value.first));
+        this->alloc_.construct(this->slots_ + i, value);
+        commit_insert(i, hash_of(value.first));
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A>::flat_hash_map(flat_hash_map &&other) noexcept
+    : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_), growth_left_(other.growth_left_),
+      hash_(std::move(other.hash_)), eq_(std::move(other.eq_)), alloc_(std::move(other.alloc_)) {
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+    other.capacity_ = other.size_ = other.growth_left_ = 0;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A> &flat_hash_map<K, V, H, E, A>::operator=(const flat_hash_map &other) {
+    if (this != &other) {
+        flat_hash_map tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A> &flat_hash_map<K, V, H, E, A>::operator=(flat_hash_map &&other) noexcept {
+    if (this != &other) {
+        flat_hash_map tmp(std::move(other));
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+flat_hash_map<K, V, H, E, A>::~flat_hash_map() {
+    destroy_slots();
+    deallocate_storage();
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::begin() noexcept {
+    iterator it(this->ctrl_, this->slots_, this->ctrl_ + this->capacity_);
+    it.skip_empty();
+    return it;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::begin() const noexcept {
+    const_iterator it(this->ctrl_, this->slots_, this->ctrl_ + this->capacity_);
+    it.skip_empty();
+    return it;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::end() noexcept {
+    return iterator_at(this->capacity_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::end() const noexcept {
+    return iterator_at(this->capacity_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::cend() const noexcept {
+    return end();
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool flat_hash_map<K, V, H, E, A>::empty() const noexcept {
+    return this->size_ == 0;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::size() const noexcept {
+    return this->size_;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::max_size() const noexcept {
+    return max_load(this->alloc_.max_size());
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::capacity() const noexcept {
+    return this->capacity_;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+float flat_hash_map<K, V, H, E, A>::load_factor() const noexcept {
+    return (this->capacity_ == 0) ? 0.0f : static_cast<float>(this->size_) / static_cast<float>(this->capacity_);
+}
+
+// makes room for n elements without rehashing
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::reserve(size_type n) {
+    if (n > max_size()) throw std::length_error("tinystl::flat_hash_map::reserve");
+    if (n <= this->size_ + this->growth_left_) return;
+    resize(capacity_for(n));
+}
+
+// rebuilds the table with room for at least max(n, size()) elements, which
+// also drops every tombstone
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::rehash(size_type n) {
+    if (n < this->size_) n = this->size_;
+    if (n == 0 && this->capacity_ == 0) return;
+    resize(capacity_for(n));
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::clear() noexcept {
+    if (this->capacity_ == 0) return;
+    destroy_slots();
+    std::memset(this->ctrl_, hash_ctrl_empty, this->capacity_ + hash_group::width);
+    this->size_ = 0;
+    this->growth_left_ = max_load(this->capacity_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::insert(const value_type &value) {
+    return emplace_key(value.first, value.second);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::insert(value_type &&value) {
+    // the key of a pair<const K, V> cannot be moved from
+    return emplace_key(value.first, std::move(value.second));
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename InputIt>
+void flat_hash_map<K, V, H, E, A>::insert(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        reserve(this->size_ + static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) insert(*first);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::insert(std::initializer_list<value_type> il) {
+    insert(il.begin(), il.end());
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename M>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::insert_or_assign(const K &key, M &&obj) {
+    auto ret = emplace_key(key, std::forward<M>(obj));
+    if (!ret.second) ret.first->second = std::forward<M>(obj);
+    return ret;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename M>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::insert_or_assign(K &&key, M &&obj) {
+    auto ret = emplace_key(std::move(key), std::forward<M>(obj));
+    if (!ret.second) ret.first->second = std::forward<M>(obj);
+    return ret;
+}
+
+// builds the element first to learn its key, then moves it into the table
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename... Args>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::emplace(Args &&...args) {
+    std::pair<K, V> tmp(std::forward<Args>(args)...);
+    return emplace_key(std::move(tmp.first), std::move(tmp.second));
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename... Args>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::try_emplace(const K &key, Args &&...args) {
+    return emplace_key(key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename... Args>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::try_emplace(K &&key, Args &&...args) {
+    return emplace_key(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::erase(const_iterator pos) {
+    size_type i = static_cast<size_type>(pos.ctrl_ - this->ctrl_);
+    erase_at(i);
+    iterator next = iterator_at(i);
+    next.skip_empty();
+    return next;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::erase(iterator pos) {
+    return erase(const_iterator(pos));
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::erase(const K &key) {
+    size_type i = find_index(key, hash_of(key));
+    if (i == npos) return 0;
+    erase_at(i);
+    return 1;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q, typename>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::erase(const Q &key) {
+    size_type i = find_index(key, hash_of(key));
+    if (i == npos) return 0;
+    erase_at(i);
+    return 1;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::swap(flat_hash_map &other) noexcept {
+    std::swap(this->ctrl_, other.ctrl_);
+    std::swap(this->slots_, other.slots_);
+    std::swap(this->capacity_, other.capacity_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->growth_left_, other.growth_left_);
+    std::swap(this->hash_, other.hash_);
+    std::swap(this->eq_, other.eq_);
+    std::swap(this->alloc_, other.alloc_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+V &flat_hash_map<K, V, H, E, A>::at(const K &key) {
+    size_type i = find_index(key, hash_of(key));
+    if (i == npos) throw std::out_of_range("tinystl::flat_hash_map::at");
+    return this->slots_[i].second;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+const V &flat_hash_map<K, V, H, E, A>::at(const K &key) const {
+    size_type i = find_index(key, hash_of(key));
+    if (i == npos) throw std::out_of_range("tinystl::flat_hash_map::at");
+    return this->slots_[i].second;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+V &flat_hash_map<K, V, H, E, A>::operator[](const K &key) {
+    return emplace_key(key).first->second;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+V &flat_hash_map<K, V, H, E, A>::operator[](K &&key) {
+    return emplace_key(std::move(key)).first->second;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::find(const K &key) {
+    size_type i = find_index(key, hash_of(key));
+    return (i == npos) ? end() : iterator_at(i);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::find(const K &key) const {
+    size_type i = find_index(key, hash_of(key));
+    return (i == npos) ? end() : iterator_at(i);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q, typename>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::find(const Q &key) {
+    size_type i = find_index(key, hash_of(key));
+    return (i == npos) ? end() : iterator_at(i);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q, typename>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::find(const Q &key) const {
+    size_type i = find_index(key, hash_of(key));
+    return (i == npos) ? end() : iterator_at(i);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::count(const K &key) const {
+    return contains(key) ? 1 : 0;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q, typename>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::count(const Q &key) const {
+    return contains(key) ? 1 : 0;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool flat_hash_map<K, V, H, E, A>::contains(const K &key) const {
+    return find_index(key, hash_of(key)) != npos;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q, typename>
+bool flat_hash_map<K, V, H, E, A>::contains(const Q &key) const {
+    return find_index(key, hash_of(key)) != npos;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::hasher flat_hash_map<K, V, H, E, A>::hash_function() const {
+    return this->hash_;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::key_equal flat_hash_map<K, V, H, E, A>::key_eq() const {
+    return this->eq_;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::allocator_type flat_hash_map<K, V, H, E, A>::get_allocator() const {
+    return allocator_type(this->alloc_);
+}
+
+/*
+ * std::hash of an integer is usually the identity, which would leave h2
+ * equal to the low bits of the key and h1 clustered; the finalizer of
+ * MurmurHash3 spreads every input bit over the whole word first.
+ */
+template <typename K, typename V, typename H, typename E, typename A>
+std::size_t flat_hash_map<K, V, H, E, A>::mix(std::size_t h) noexcept {
+    std::uint64_t x = static_cast<std::uint64_t>(h);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+std::size_t flat_hash_map<K, V, H, E, A>::h1(std::size_t hash) noexcept {
+    return hash >> 7;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+hash_ctrl_t flat_hash_map<K, V, H, E, A>::h2(std::size_t hash) noexcept {
+    return static_cast<hash_ctrl_t>(hash & 0x7f);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::max_load(size_type capacity) noexcept {
+    return capacity - capacity / 8;
+}
+
+// smallest power-of-two capacity that holds n elements under the load limit
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::capacity_for(size_type n) noexcept {
+    size_type cap = min_capacity;
+    while (max_load(cap) < n) cap *= 2;
+    return cap;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q>
+std::size_t flat_hash_map<K, V, H, E, A>::hash_of(const Q &key) const {
+    return mix(this->hash_(key));
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::find_index(const Q &key, std::size_t hash) const {
+    if (this->capacity_ == 0) return npos;
+    const size_type mask = this->capacity_ - 1;
+    const hash_ctrl_t tag = h2(hash);
+    size_type pos = h1(hash) & mask;
+    size_type step = 0;
+    for (;;) {
+        hash_group g(this->ctrl_ + pos);
+        for (std::uint32_t bits = g.match(tag); bits != 0; bits &= bits - 1) {
+            size_type i = (pos + hash_group::trailing_zeros(bits)) & mask;
+            if (this->eq_(this->slots_[i].first, key)) return i;
+        }
+        if (g.match_empty() != 0) return npos;
+        step += hash_group::width;
+        pos = (pos + step) & mask;
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::find_first_non_full(std::size_t hash) const noexcept {
+    const size_type mask = this->capacity_ - 1;
+    size_type pos = h1(hash) & mask;
+    size_type step = 0;
+    for (;;) {
+        std::uint32_t bits = hash_group(this->ctrl_ + pos).match_empty_or_deleted();
+        if (bits != 0) return (pos + hash_group::trailing_zeros(bits)) & mask;
+        step += hash_group::width;
+        pos = (pos + step) & mask;
+    }
+}
+
+// returns the slot a new element with this hash goes to, growing if needed
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::size_type flat_hash_map<K, V, H, E, A>::prepare_insert(std::size_t hash) {
+    if (this->capacity_ == 0) rehash_and_grow();
+    size_type i = find_first_non_full(hash);
+    // a tombstone can be reused without using up growth
+    if (this->growth_left_ == 0 && this->ctrl_[i] != hash_ctrl_deleted) {
+        rehash_and_grow();
+        i = find_first_non_full(hash);
+    }
+    return i;
+}
+
+// marks slot i as full once its element has been constructed
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::commit_insert(size_type i, std::size_t hash) noexcept {
+    if (this->ctrl_[i] == hash_ctrl_empty) --this->growth_left_;
+    set_ctrl(i, h2(hash));
+    ++this->size_;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+template <typename Q, typename... Args>
+std::pair<typename flat_hash_map<K, V, H, E, A>::iterator, bool> flat_hash_map<K, V, H, E, A>::emplace_key(Q &&key, Args &&...args) {
+    std::size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if (i != npos) return {iterator_at(i), false};
+    i = prepare_insert(hash);
+    this->alloc_.construct(this->slots_ + i, std::piecewise_construct, std::forward_as_tuple(std::forward<Q>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    commit_insert(i, hash);
+    return {iterator_at(i), true};
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::set_ctrl(size_type i, hash_ctrl_t h) noexcept {
+    this->ctrl_[i] = h;
+    // keep the mirrored bytes after the end in sync
+    if (i < hash_group::width) this->ctrl_[this->capacity_ + i] = h;
+}
+
+/*
+ * A slot can go back to empty only if no probe sequence ever had to step
+ * over it, i.e. every group-sized window containing it still has an empty
+ * slot. Otherwise it becomes a tombstone so that lookups keep probing past it.
+ */
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::erase_at(size_type i) noexcept {
+    this->alloc_.destroy(this->slots_ + i);
+    --this->size_;
+    const size_type before = (i - hash_group::width) & (this->capacity_ - 1);
+    std::uint32_t empty_after = hash_group(this->ctrl_ + i).match_empty();
+    std::uint32_t empty_before = hash_group(this->ctrl_ + before).match_empty();
+    bool was_never_full = empty_before != 0 && empty_after != 0 &&
+                          hash_group::trailing_zeros(empty_after) + hash_group::leading_zeros(empty_before) < hash_group::width;
+    if (was_never_full) {
+        set_ctrl(i, hash_ctrl_empty);
+        ++this->growth_left_;
+    } else {
+        set_ctrl(i, hash_ctrl_deleted);
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::rehash_and_grow() {
+    if (this->capacity_ == 0) {
+        resize(min_capacity);
+    } else if (this->size_ <= max_load(this->capacity_) / 2) {
+        // mostly tombstones: rebuilding at the same size frees enough room
+        resize(this->capacity_);
+    } else {
+        resize(this->capacity_ * 2);
+    }
+}
+
+/*
+ * The new table is built on the side and only replaces the old one once
+ * every element is in it. When nothing can throw, elements are relocated
+ * key included, so growing never copies a key. Otherwise they are copied,
+ * and a throw leaves the map as it was; an element that can only be moved,
+ * and whose move may throw, gives no such guarantee, and the map is left
+ * empty instead.
+ */
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::resize(size_type new_capacity) {
+    flat_hash_map table(0, this->hash_, this->eq_, this->alloc_);
+    table.allocate_storage(new_capacity);
+    if constexpr (nothrow_rehash) {
+        for (size_type i = 0; i < this->capacity_; ++i) {
+            if (this->ctrl_[i] < 0) continue;
+            std::size_t hash = hash_of(this->slots_[i].first);
+            size_type j = table.find_first_non_full(hash);
+            relocate_slot(this->slots_ + i, table.slots_ + j);
+            table.commit_insert(j, hash);
+        }
+    } else {
+        try {
+            for (size_type i = 0; i < this->capacity_; ++i) {
+                if (this->ctrl_[i] < 0) continue;
+                std::size_t hash = hash_of(this->slots_[i].first);
+                size_type j = table.find_first_non_full(hash);
+                if constexpr (std::is_copy_constructible<value_type>::value) {
+                    table.alloc_.construct(table.slots_ + j, this->slots_[i]);
+                } else {
+                    table.alloc_.construct(table.slots_ + j, std::piecewise_construct, std::forward_as_tuple(std::move(const_cast<K &>(this->slots_[i].first))),
+                                           std::forward_as_tuple(std::move(this->slots_[i].second)));
+                }
+                table.commit_insert(j, hash);
+            }
+        } catch (...) {
+            if constexpr (!std::is_copy_constructible<value_type>::value) clear();
+            throw;
+        }
+        destroy_slots();
+    }
+    deallocate_storage();
+    this->ctrl_ = table.ctrl_;
+    this->slots_ = table.slots_;
+    this->capacity_ = table.capacity_;
+    this->growth_left_ = table.growth_left_;
+    table.ctrl_ = nullptr;
+    table.slots_ = nullptr;
+    table.capacity_ = table.size_ = table.growth_left_ = 0;
+}
+
+// gives an empty map fresh, empty arrays for capacity slots
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::allocate_storage(size_type capacity) {
+    ctrl_allocator ctrl_alloc(this->alloc_);
+    hash_ctrl_t *ctrl = ctrl_alloc.allocate(capacity + hash_group::width);
+    try {
+        this->slots_ = this->alloc_.allocate(capacity);
+    } catch (...) {
+        ctrl_alloc.deallocate(ctrl, capacity + hash_group::width);
+        throw;
+    }
+    std::memset(ctrl, hash_ctrl_empty, capacity + hash_group::width);
+    this->ctrl_ = ctrl;
+    this->capacity_ = capacity;
+    this->growth_left_ = max_load(capacity);
+}
+
+/*
+ * Moves the element at from into the raw slot to and ends the lifetime of
+ * from. The key is moved even though it is const, as abseil's map_slot_policy
+ * does: it is destroyed right afterwards, so no one sees it moved from.
+ */
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::relocate_slot(value_type *from, value_type *to) noexcept {
+    if constexpr (is_trivially_relocatable<value_type>::value) {
+        relocate_n(this->alloc_, from, 1, to);
+    } else {
+        this->alloc_.construct(to, std::piecewise_construct, std::forward_as_tuple(std::move(const_cast<K &>(from->first))),
+                               std::forward_as_tuple(std::move(from->second)));
+        this->alloc_.destroy(from);
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::destroy_slots() noexcept {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+        for (size_type i = 0; i < this->capacity_; ++i) {
+            if (this->ctrl_[i] >= 0) this->alloc_.destroy(this->slots_ + i);
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void flat_hash_map<K, V, H, E, A>::deallocate_storage() noexcept {
+    if (this->ctrl_ == nullptr) return;
+    ctrl_allocator ctrl_alloc(this->alloc_);
+    ctrl_alloc.deallocate(this->ctrl_, this->capacity_ + hash_group::width);
+    this->alloc_.deallocate(this->slots_, this->capacity_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::iterator flat_hash_map<K, V, H, E, A>::iterator_at(size_type i) noexcept {
+    return iterator(this->ctrl_ + i, this->slots_ + i, this->ctrl_ + this->capacity_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+typename flat_hash_map<K, V, H, E, A>::const_iterator flat_hash_map<K, V, H, E, A>::iterator_at(size_type i) const noexcept {
+    return const_iterator(this->ctrl_ + i, this->slots_ + i, this->ctrl_ + this->capacity_);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool operator==(const flat_hash_map<K, V, H, E, A> &lhs, const flat_hash_map<K, V, H, E, A> &rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (const auto &value : lhs) {
+        auto it = rhs.find(value.first);
+        if (it == rhs.end() || !(it->second == value.second)) return false;
+    }
+    return true;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool operator!=(const flat_hash_map<K, V, H, E, A> &lhs, const flat_hash_map<K, V, H, E, A> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void swap(flat_hash_map<K, V, H, E, A> &lhs, flat_hash_map<K, V, H, E, A> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <tinystl/memory.h>
+#include <cstddef>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * CRTP base that puts the reference count inside the object. intrusive_ptr
+ * finds it through the intrusive_ptr_add_ref / intrusive_ptr_release hooks
+ * below, so classes with a count of their own can provide their own hooks.
+ * P is one of the counting policies of shared_ptr.
+ */
+template <typename Derived, typename P = atomic_count_policy>
+class intrusive_ref_counter {
+public:
+    intrusive_ref_counter() noexcept : ref_count_(0) {}
+    // a copy is a new object, nobody refers to it yet
+    intrusive_ref_counter(const intrusive_ref_counter &) noexcept : ref_count_(0) {}
+    intrusive_ref_counter &operator=(const intrusive_ref_counter &) noexcept { return *this; }
+
+    std::size_t use_count() const noexcept { return P::load(this->ref_count_); }
+
+protected:
+    ~intrusive_ref_counter() = default;
+
+private:
+    mutable typename P::count_type ref_count_;
+
+private:
+    friend void intrusive_ptr_add_ref(const intrusive_ref_counter *p) noexcept {
+        P::increment(p->ref_count_);
+    }
+    friend void intrusive_ptr_release(const intrusive_ref_counter *p) noexcept {
+        if (P::decrement(p->ref_count_)) delete static_cast<const Derived *>(p);
+    }
+};
+
+template <typename T>
+class intrusive_ptr {
+public:
+    using element_type = T;
+
+public:
+    intrusive_ptr() noexcept : p_(nullptr) {}
+    intrusive_ptr(T *p, bool add_ref = true);
+    intrusive_ptr(const intrusive_ptr<T> &other);
+    template <typename U>
+    intrusive_ptr(const intrusive_ptr<U> &other);
+    intrusive_ptr(intrusive_ptr<T> &&other) noexcept;
+    intrusive_ptr<T> &operator=(const intrusive_ptr<T> &other);
+    intrusive_ptr<T> &operator=(intrusive_ptr<T> &&other) noexcept;
+    ~intrusive_ptr();
+
+    void reset() noexcept;
+    void reset(T *p, bool add_ref = true);
+    T *get() const noexcept;
+    T *detach() noexcept;
+    T &operator*() const noexcept;
+    T *operator->() const noexcept;
+    explicit operator bool() const noexcept;
+    void swap(intrusive_ptr<T> &other) noexcept;
+
+private:
+    T *p_;
+};
+
+template <typename T>
+struct is_trivially_relocatable<intrusive_ptr<T>> : std::true_type {};
+
+template <typename T>
+intrusive_ptr<T>::intrusive_ptr(T *p, bool add_ref) : p_(p) {
+    if (this->p_ != nullptr && add_ref) intrusive_ptr_add_ref(this->p_);
+}
+
+template <typename T>
+intrusive_ptr<T>::intrusive_ptr(const intrusive_ptr<T> &other) : p_(other.p_) {
+    if (this->p_ != nullptr) intrusive_ptr_add_ref(this->p_);
+}
+
+template <typename T>
+template <typename U>
+intrusive_ptr<T>::intrusive_ptr(const intrusive_ptr<U> &other) : p_(other.get()) {
+    if (this->p_ != nullptr) intrusive_ptr_add_ref(this->p_);
+}
+
+template <typename T>
+intrusive_ptr<T>::intrusive_ptr(intrusive_ptr<T> &&other) noexcept : p_(other.p_) {
+    other.p_ = nullptr;
+}
+
+template <typename T>
+intrusive_ptr<T> &intrusive_ptr<T>::operator=(const intrusive_ptr<T> &other) {
+    intrusive_ptr<T>(other).swap(*this);
+    return *this;
+}
+
+template <typename T>
+intrusive_ptr<T> &intrusive_ptr<T>::operator=(intrusive_ptr<T> &&other) noexcept {
+    intrusive_ptr<T>(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename T>
+intrusive_ptr<T>::~intrusive_ptr() {
+    if (this->p_ != nullptr) intrusive_ptr_release(this->p_);
+}
+
+template <typename T>
+void intrusive_ptr<T>::reset() noexcept {
+    intrusive_ptr<T>().swap(*this);
+}
+
+template <typename T>
+void intrusive_ptr<T>::reset(T *p, bool add_ref) {
+    intrusive_ptr<T>(p, add_ref).swap(*this);
+}
+
+template <typename T>
+T *intrusive_ptr<T>::get() const noexcept {
+    return this->p_;
+}
+
+// gives up ownership without touching the count
+template <typename T>
+T *intrusive_ptr<T>::detach() noexcept {
+    T *ret = this->p_;
+    this->p_ = nullptr;
+    return ret;
+}
+
+template <typename T>
+T &intrusive_ptr<T>::operator*() const noexcept {
+    return *(this->p_);
+}
+
+template <typename T>
+T *intrusive_ptr<T>::operator->() const noexcept {
+    return this->p_;
+}
+
+template <typename T>
+intrusive_ptr<T>::operator bool() const noexcept {
+    return this->p_ != nullptr;
+}
+
+template <typename T>
+void intrusive_ptr<T>::swap(intrusive_ptr<T> &other) noexcept {
+    std::swap(this->p_, other.p_);
+}
+
+template <typename T, typename U>
+bool operator==(const intrusive_ptr<T> &lhs, const intrusive_ptr<U> &rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const intrusive_ptr<T> &lhs, const intrusive_ptr<U> &rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+template <typename T, typename... Args>
+intrusive_ptr<T> make_intrusive(Args &&...args) {
+    return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+}  // namespace tinystl
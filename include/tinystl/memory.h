@@ -1,6 +1,10 @@
 #pragma once
 
+#include <tinystl/allocator.h>
+#include <tinystl/util.h>
+#include <atomic>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 namespace tinystl {
@@ -9,15 +13,30 @@ template <typename T>
 class default_deleter {
 public:
     default_deleter() = default;
-    void operator()(T *p) {
+    void operator()(T *p) const {
         ::delete (p);
     }
 };
 
+template <typename T>
+class default_deleter<T[]> {
+public:
+    default_deleter() = default;
+    void operator()(T *p) const {
+        ::delete[] (p);
+    }
+};
+
+/*
+ * The deleter is stored next to the pointer in a compressed_pair, so an empty
+ * deleter such as default_deleter adds nothing to sizeof(unique_ptr) while a
+ * stateful one is kept, moved and swapped together with the pointer.
+ */
 template <typename T, typename D = default_deleter<T>>
 class unique_ptr {
 public:
     using element_type = T;
+    using deleter_type = D;
     using pointer = T *;
     using reference = T &;
 
@@ -25,13 +44,17 @@ public:
     unique_ptr(const unique_ptr<T, D> &other) = delete;
     unique_ptr<T, D> &operator=(const unique_ptr<T, D> &other) = delete;
 
-    unique_ptr() noexcept : el_(nullptr) {}
-    explicit unique_ptr(pointer p) : el_(p) {}
+    unique_ptr() noexcept : pair_() {}
+    explicit unique_ptr(pointer p) noexcept : pair_(D(), p) {}
+    unique_ptr(pointer p, const D &d) noexcept : pair_(d, p) {}
+    unique_ptr(pointer p, D &&d) noexcept : pair_(std::move(d), p) {}
 
     unique_ptr(unique_ptr<T, D> &&other) noexcept;
-    unique_ptr<T, D> &operator=(unique_ptr<T, D> &&other);
+    unique_ptr<T, D> &operator=(unique_ptr<T, D> &&other) noexcept;
     ~unique_ptr();
     pointer get() const noexcept;
+    D &get_deleter() noexcept;
+    const D &get_deleter() const noexcept;
     explicit operator bool() const noexcept;
     pointer release() noexcept;
     void reset(pointer p = pointer{}) noexcept;
@@ -40,28 +63,233 @@ public:
     pointer operator->() const;
 
 private:
-    pointer el_;
+    compressed_pair<D, pointer> pair_;
+};
+
+template <typename T, typename D>
+class unique_ptr<T[], D> {
+public:
+    using element_type = T;
+    using deleter_type = D;
+    using pointer = T *;
+    using reference = T &;
+
+public:
+    unique_ptr(const unique_ptr<T[], D> &other) = delete;
+    unique_ptr<T[], D> &operator=(const unique_ptr<T[], D> &other) = delete;
+
+    unique_ptr() noexcept : pair_() {}
+    explicit unique_ptr(pointer p) noexcept : pair_(D(), p) {}
+    unique_ptr(pointer p, const D &d) noexcept : pair_(d, p) {}
+    unique_ptr(pointer p, D &&d) noexcept : pair_(std::move(d), p) {}
+
+    unique_ptr(unique_ptr<T[], D> &&other) noexcept;
+    unique_ptr<T[], D> &operator=(unique_ptr<T[], D> &&other) noexcept;
+    ~unique_ptr();
+    pointer get() const noexcept;
+    D &get_deleter() noexcept;
+    const D &get_deleter() const noexcept;
+    explicit operator bool() const noexcept;
+    pointer release() noexcept;
+    void reset(pointer p = pointer{}) noexcept;
+    void swap(unique_ptr &x) noexcept;
+    reference operator[](std::size_t i) const;
+
+private:
+    compressed_pair<D, pointer> pair_;
 };
 
 template <typename T, typename D = default_deleter<T>, typename... Args>
-unique_ptr<T, D> make_unique(Args &&...args) {
+typename std::enable_if<!std::is_array<T>::value, unique_ptr<T, D>>::type make_unique(Args &&...args) {
     return unique_ptr<T, D>(new T(std::forward<Args>(args)...));
 }
 
-template <typename T>
+template <typename T, typename D = default_deleter<T>>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, unique_ptr<T, D>>::type make_unique(std::size_t n) {
+    return unique_ptr<T, D>(new typename std::remove_extent<T>::type[n]());
+}
+
+/*
+ * Counting policies for reference_counter. atomic_count_policy makes
+ * shared_ptr and weak_ptr safe to copy and destroy from different threads;
+ * plain_count_policy avoids the locked instructions when every owner stays
+ * on one thread.
+ */
+struct atomic_count_policy {
+    using count_type = std::atomic<std::size_t>;
+
+    static std::size_t load(const count_type &c) noexcept {
+        return c.load(std::memory_order_acquire);
+    }
+    // a new owner is always derived from an existing one, which keeps the
+    // object alive, so nothing needs to be ordered here
+    static void increment(count_type &c) noexcept {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+    // release publishes this owner's writes, acquire makes every other
+    // owner's writes visible to whoever ends up destroying the object
+    static bool decrement(count_type &c) noexcept {
+        return c.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+    static void increment(count_type &c, std::size_t n) noexcept {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+    static bool decrement(count_type &c, std::size_t n) noexcept {
+        return c.fetch_sub(n, std::memory_order_acq_rel) == n;
+    }
+    static bool increment_if_nonzero(count_type &c) noexcept {
+        std::size_t n = c.load(std::memory_order_relaxed);
+        while (n != 0) {
+            if (c.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+};
+
+struct plain_count_policy {
+    using count_type = std::size_t;
+
+    static std::size_t load(const count_type &c) noexcept { return c; }
+    static void increment(count_type &c) noexcept { c += 1; }
+    static bool decrement(count_type &c) noexcept { return --c == 0; }
+    static void increment(count_type &c, std::size_t n) noexcept { c += n; }
+    static bool decrement(count_type &c, std::size_t n) noexcept { return (c -= n) == 0; }
+    static bool increment_if_nonzero(count_type &c) noexcept {
+        if (c == 0) return false;
+        c += 1;
+        return true;
+    }
+};
+
+/*
+ * weak_reference_count holds one extra reference on behalf of all the strong
+ * owners together, so whichever of the last shared_ptr and the last weak_ptr
+ * goes away second frees the counter, without the two racing on both counts.
+ */
+template <typename T, typename P = atomic_count_policy>
 struct reference_counter {
     T *resource;
-    std::size_t strong_reference_count;
-    std::size_t weak_reference_count;
+    typename P::count_type strong_reference_count;
+    typename P::count_type weak_reference_count;
+
+    reference_counter(T *p) : resource(p), strong_reference_count(1), weak_reference_count(1) {}
+    virtual ~reference_counter() = default;
+    // called when the last shared_ptr goes away
+    virtual void dispose() noexcept = 0;
+    // called when no shared_ptr or weak_ptr refers to the counter any more
+    virtual void destroy() noexcept = 0;
+
+    std::size_t strong_count() const noexcept { return P::load(this->strong_reference_count); }
+    void add_strong_reference() noexcept { P::increment(this->strong_reference_count); }
+    bool try_add_strong_reference() noexcept { return P::increment_if_nonzero(this->strong_reference_count); }
+    void release_strong_reference() noexcept {
+        if (P::decrement(this->strong_reference_count)) {
+            dispose();
+            release_weak_reference();
+        }
+    }
+    // batched variants for owners that hold several references at once
+    void add_strong_references(std::size_t n) noexcept { P::increment(this->strong_reference_count, n); }
+    void release_strong_references(std::size_t n) noexcept {
+        if (P::decrement(this->strong_reference_count, n)) {
+            dispose();
+            release_weak_reference();
+        }
+    }
+    void add_weak_reference() noexcept { P::increment(this->weak_reference_count); }
+    void release_weak_reference() noexcept {
+        if (P::decrement(this->weak_reference_count)) destroy();
+    }
+};
+
+/*
+ * Control block for a pointer adopted by shared_ptr. It owns a copy of the
+ * deleter and of the allocator it was allocated with, so neither shows up in
+ * the type of the shared_ptr.
+ */
+template <typename T, typename D, typename P, typename A = allocator<T>>
+struct pointer_reference_counter : reference_counter<T, P> {
+    using counter_allocator = typename A::template rebind<pointer_reference_counter>::other;
+
+    compressed_pair<D, counter_allocator> deleter_and_allocator;
+
+    pointer_reference_counter(T *p, D &&d, const counter_allocator &a)
+        : reference_counter<T, P>(p), deleter_and_allocator(std::move(d), a) {}
+    void dispose() noexcept override { this->deleter_and_allocator.first()(this->resource); }
+    void destroy() noexcept override {
+        counter_allocator a(this->deleter_and_allocator.second());
+        this->~pointer_reference_counter();
+        a.deallocate(this, 1);
+    }
 
-    reference_counter(T *p) : resource(p), strong_reference_count(1), weak_reference_count(0) {}
-    ~reference_counter() { delete resource; }
+    // if the counter cannot be allocated or built, p is deleted before rethrowing
+    static pointer_reference_counter *create(T *p, D &&d, const A &alloc) {
+        counter_allocator a(alloc);
+        pointer_reference_counter *rc;
+        try {
+            rc = a.allocate(1);
+        } catch (...) {
+            d(p);
+            throw;
+        }
+        try {
+            return ::new (static_cast<void *>(rc)) pointer_reference_counter(p, std::move(d), a);
+        } catch (...) {
+            a.deallocate(rc, 1);
+            d(p);
+            throw;
+        }
+    }
 };
 
-template <typename T>
+/*
+ * Control block used by make_shared and allocate_shared: the object lives
+ * right after the counts, so both come from a single allocation and usually
+ * share a cache line.
+ */
+template <typename T, typename P, typename A = allocator<T>>
+struct inplace_reference_counter : reference_counter<T, P> {
+    using counter_allocator = typename A::template rebind<inplace_reference_counter>::other;
+
+    alignas(T) unsigned char storage[sizeof(T)];
+    counter_allocator alloc;
+
+    template <typename... Args>
+    explicit inplace_reference_counter(const counter_allocator &a, Args &&...args) : reference_counter<T, P>(nullptr), alloc(a) {
+        this->resource = ::new (static_cast<void *>(storage)) T(std::forward<Args>(args)...);
+    }
+    void dispose() noexcept override { this->resource->~T(); }
+    void destroy() noexcept override {
+        counter_allocator a(this->alloc);
+        this->~inplace_reference_counter();
+        a.deallocate(this, 1);
+    }
+
+    template <typename... Args>
+    static inplace_reference_counter *create(const A &alloc, Args &&...args) {
+        counter_allocator a(alloc);
+        inplace_reference_counter *rc = a.allocate(1);
+        try {
+            return ::new (static_cast<void *>(rc)) inplace_reference_counter(a, std::forward<Args>(args)...);
+        } catch (...) {
+            a.deallocate(rc, 1);
+            throw;
+        }
+    }
+};
+
+template <typename T, typename P = atomic_count_policy>
 class weak_ptr;
 
-template <typename T, typename D = default_deleter<T>>
+template <typename T, typename D>
+class atomic_shared_ptr;
+
+/*
+ * D is only the deleter that shared_ptr(T *) and reset(T *) adopt pointers
+ * with. The control block owns the deleter a pointer was adopted with, so
+ * shared_ptrs that differ only in D share ownership and convert freely.
+ */
+template <typename T, typename D = default_deleter<T>, typename P = atomic_count_policy>
 class shared_ptr {
 public:
     using element_type = T;
@@ -69,13 +297,25 @@ public:
 public:
     shared_ptr() : rc_(nullptr) {}
     explicit shared_ptr(T *p);
-    shared_ptr(const shared_ptr<T, D> &other);
-    shared_ptr<T, D> &operator=(const shared_ptr<T, D> &other);
-    shared_ptr(shared_ptr<T, D> &&other);
-    shared_ptr<T, D> &operator=(shared_ptr<T, D> &&other);
+    template <typename E>
+    shared_ptr(T *p, E deleter);
+    template <typename E, typename A>
+    shared_ptr(T *p, E deleter, const A &alloc);
+    shared_ptr(const shared_ptr<T, D, P> &other);
+    shared_ptr<T, D, P> &operator=(const shared_ptr<T, D, P> &other);
+    shared_ptr(shared_ptr<T, D, P> &&other) noexcept;
+    shared_ptr<T, D, P> &operator=(shared_ptr<T, D, P> &&other) noexcept;
+    template <typename E>
+    shared_ptr(const shared_ptr<T, E, P> &other);
+    template <typename E>
+    shared_ptr<T, D, P> &operator=(const shared_ptr<T, E, P> &other);
+    template <typename E>
+    shared_ptr(shared_ptr<T, E, P> &&other) noexcept;
+    template <typename E>
+    shared_ptr<T, D, P> &operator=(shared_ptr<T, E, P> &&other) noexcept;
     ~shared_ptr();
-    shared_ptr(const weak_ptr<T> &wp);
-    void swap(shared_ptr<T, D> &other) noexcept;
+    shared_ptr(const weak_ptr<T, P> &wp);
+    void swap(shared_ptr<T, D, P> &other) noexcept;
     void reset(T *p = nullptr);
     element_type *get() const noexcept;
     element_type &operator*() const noexcept;
@@ -85,13 +325,18 @@ public:
     explicit operator bool() const noexcept;
 
 private:
-    reference_counter<T> *rc_ {};
+    reference_counter<T, P> *rc_ {};
 
 private:
-    friend class weak_ptr<T>;
+    friend class weak_ptr<T, P>;
+    friend class atomic_shared_ptr<T, D>;
+    template <typename U, typename E, typename Q>
+    friend class shared_ptr;
+    template <typename U, typename E, typename Q, typename A, typename... Args>
+    friend shared_ptr<U, E, Q> allocate_shared(const A &alloc, Args &&...args);
 };
 
-template <typename T>
+template <typename T, typename P>
 class weak_ptr {
 public:
     using element_type = T;
@@ -99,263 +344,404 @@ public:
 public:
     weak_ptr() : rc_(nullptr) {}
     template <typename D>
-    weak_ptr(const shared_ptr<T, D> &sp);
+    weak_ptr(const shared_ptr<T, D, P> &sp);
+    weak_ptr(const weak_ptr<T, P> &other);
     ~weak_ptr();
-    weak_ptr<T> &operator=(const weak_ptr<T> &other);
+    weak_ptr<T, P> &operator=(const weak_ptr<T, P> &other);
 
-    weak_ptr(weak_ptr<T> &&other);
-    weak_ptr<T> &operator=(weak_ptr<T> &&other);
+    weak_ptr(weak_ptr<T, P> &&other) noexcept;
+    weak_ptr<T, P> &operator=(weak_ptr<T, P> &&other) noexcept;
 
     void reset();
     void swap(weak_ptr &other);
     bool expired() const;
-    shared_ptr<T> lock() const;
+    shared_ptr<T, default_deleter<T>, P> lock() const;
     std::size_t use_count() const;
 
 private:
-    reference_counter<T> *rc_ {};
+    reference_counter<T, P> *rc_ {};
+
+private:
+    template <typename U, typename E, typename Q>
+    friend class shared_ptr;
 };
 
+// the smart pointers only point away from themselves, so their bytes can move
+template <typename T, typename D>
+struct is_trivially_relocatable<unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+template <typename T, typename D, typename P>
+struct is_trivially_relocatable<shared_ptr<T, D, P>> : std::true_type {};
+
+template <typename T, typename P>
+struct is_trivially_relocatable<weak_ptr<T, P>> : std::true_type {};
+
 template <typename T, typename D>
 unique_ptr<T, D>::unique_ptr(unique_ptr<T, D> &&other) noexcept
-    : el_(nullptr) {
-    std::swap(this->el_, other.el_);
-}
+    : pair_(std::move(other.get_deleter()), other.release()) {}
 
 template <typename T, typename D>
-unique_ptr<T, D> &unique_ptr<T, D>::operator=(unique_ptr<T, D> &&other) {
-    std::swap(this->el_, other.el_);
+unique_ptr<T, D> &unique_ptr<T, D>::operator=(unique_ptr<T, D> &&other) noexcept {
+    reset(other.release());
+    this->get_deleter() = std::move(other.get_deleter());
     return *this;
 }
 
 template <typename T, typename D>
 unique_ptr<T, D>::~unique_ptr() {
-    if (this->el_ != nullptr) {
-        D deleter;
-        deleter(this->el_);
-        this->el_ = nullptr;
+    if (this->pair_.second() != nullptr) {
+        this->get_deleter()(this->pair_.second());
     }
 }
 
 template <typename T, typename D>
 T *unique_ptr<T, D>::get() const noexcept {
-    return this->el_;
+    return this->pair_.second();
+}
+
+template <typename T, typename D>
+D &unique_ptr<T, D>::get_deleter() noexcept {
+    return this->pair_.first();
+}
+
+template <typename T, typename D>
+const D &unique_ptr<T, D>::get_deleter() const noexcept {
+    return this->pair_.first();
 }
 
 template <typename T, typename D>
 unique_ptr<T, D>::operator bool() const noexcept {
-    return this->el_ != nullptr;
+    return this->pair_.second() != nullptr;
 }
 
 template <typename T, typename D>
 T *unique_ptr<T, D>::release() noexcept {
     T *ret = nullptr;
-    std::swap(ret, this->el_);
+    std::swap(ret, this->pair_.second());
     return ret;
 }
 
 template <typename T, typename D>
 void unique_ptr<T, D>::reset(T *p) noexcept {
-    if (this->el_ != nullptr) {
-        D deleter;
-        deleter(this->el_);
-        this->el_ = nullptr;
+    T *old = this->pair_.second();
+    this->pair_.second() = p;
+    if (old != nullptr) {
+        this->get_deleter()(old);
     }
-    this->el_ = p;
 }
 
 template <typename T, typename D>
 void unique_ptr<T, D>::swap(unique_ptr<T, D> &x) noexcept {
-    std::swap(this->el, x.el_);
+    std::swap(this->pair_.first(), x.pair_.first());
+    std::swap(this->pair_.second(), x.pair_.second());
 }
 
 template <typename T, typename D>
 T &unique_ptr<T, D>::operator*() const {
-    return *(this->el_);
+    return *(this->pair_.second());
 }
 
 template <typename T, typename D>
 T *unique_ptr<T, D>::operator->() const {
-    return this->el_;
+    return this->pair_.second();
+}
+
+template <typename T, typename D>
+unique_ptr<T[], D>::unique_ptr(unique_ptr<T[], D> &&other) noexcept
+    : pair_(std::move(other.get_deleter()), other.release()) {}
+
+template <typename T, typename D>
+unique_ptr<T[], D> &unique_ptr<T[], D>::operator=(unique_ptr<T[], D> &&other) noexcept {
+    reset(other.release());
+    this->get_deleter() = std::move(other.get_deleter());
+    return *this;
 }
 
 template <typename T, typename D>
-shared_ptr<T, D>::shared_ptr(T *p) {
-    this->rc_ = new reference_counter{p};
+unique_ptr<T[], D>::~unique_ptr() {
+    if (this->pair_.second() != nullptr) {
+        this->get_deleter()(this->pair_.second());
+    }
 }
 
 template <typename T, typename D>
-shared_ptr<T, D>::shared_ptr(const shared_ptr<T, D> &other) {
-    this->rc_ = other.rc_;
-    this->rc_->strong_reference_count += 1;
+T *unique_ptr<T[], D>::get() const noexcept {
+    return this->pair_.second();
+}
+
+template <typename T, typename D>
+D &unique_ptr<T[], D>::get_deleter() noexcept {
+    return this->pair_.first();
+}
+
+template <typename T, typename D>
+const D &unique_ptr<T[], D>::get_deleter() const noexcept {
+    return this->pair_.first();
 }
 
 template <typename T, typename D>
-shared_ptr<T, D> &shared_ptr<T, D>::operator=(const shared_ptr<T, D> &other) {
+unique_ptr<T[], D>::operator bool() const noexcept {
+    return this->pair_.second() != nullptr;
+}
+
+template <typename T, typename D>
+T *unique_ptr<T[], D>::release() noexcept {
+    T *ret = nullptr;
+    std::swap(ret, this->pair_.second());
+    return ret;
+}
+
+template <typename T, typename D>
+void unique_ptr<T[], D>::reset(T *p) noexcept {
+    T *old = this->pair_.second();
+    this->pair_.second() = p;
+    if (old != nullptr) {
+        this->get_deleter()(old);
+    }
+}
+
+template <typename T, typename D>
+void unique_ptr<T[], D>::swap(unique_ptr<T[], D> &x) noexcept {
+    std::swap(this->pair_.first(), x.pair_.first());
+    std::swap(this->pair_.second(), x.pair_.second());
+}
+
+template <typename T, typename D>
+T &unique_ptr<T[], D>::operator[](std::size_t i) const {
+    return this->pair_.second()[i];
+}
+
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P>::shared_ptr(T *p) {
+    this->rc_ = pointer_reference_counter<T, D, P>::create(p, D(), allocator<T>());
+}
+
+template <typename T, typename D, typename P>
+template <typename E>
+shared_ptr<T, D, P>::shared_ptr(T *p, E deleter) {
+    this->rc_ = pointer_reference_counter<T, E, P>::create(p, std::move(deleter), allocator<T>());
+}
+
+template <typename T, typename D, typename P>
+template <typename E, typename A>
+shared_ptr<T, D, P>::shared_ptr(T *p, E deleter, const A &alloc) {
+    this->rc_ = pointer_reference_counter<T, E, P, A>::create(p, std::move(deleter), alloc);
+}
+
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P>::shared_ptr(const shared_ptr<T, D, P> &other) {
+    this->rc_ = other.rc_;
+    if (this->rc_ != nullptr) {
+        this->rc_->add_strong_reference();
+    }
+}
+
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P> &shared_ptr<T, D, P>::operator=(const shared_ptr<T, D, P> &other) {
+    if (this->rc_ == other.rc_) return *this;
     reset();
     this->rc_ = other.rc_;
-    this->rc_->strong_reference_count += 1;
+    if (this->rc_ != nullptr) {
+        this->rc_->add_strong_reference();
+    }
     return *this;
 }
 
-template <typename T, typename D>
-shared_ptr<T, D>::shared_ptr(shared_ptr<T, D> &&other) {
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P>::shared_ptr(shared_ptr<T, D, P> &&other) noexcept {
     this->rc_ = nullptr;
     std::swap(this->rc_, other.rc_);
 }
 
-template <typename T, typename D>
-shared_ptr<T, D> &shared_ptr<T, D>::operator=(shared_ptr<T, D> &&other) {
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P> &shared_ptr<T, D, P>::operator=(shared_ptr<T, D, P> &&other) noexcept {
     reset();
     std::swap(this->rc_, other.rc_);
     return *this;
 }
 
-template <typename T, typename D>
-shared_ptr<T, D>::~shared_ptr() {
+template <typename T, typename D, typename P>
+template <typename E>
+shared_ptr<T, D, P>::shared_ptr(const shared_ptr<T, E, P> &other) {
+    this->rc_ = other.rc_;
+    if (this->rc_ != nullptr) {
+        this->rc_->add_strong_reference();
+    }
+}
+
+template <typename T, typename D, typename P>
+template <typename E>
+shared_ptr<T, D, P> &shared_ptr<T, D, P>::operator=(const shared_ptr<T, E, P> &other) {
+    if (this->rc_ == other.rc_) return *this;
     reset();
+    this->rc_ = other.rc_;
+    if (this->rc_ != nullptr) {
+        this->rc_->add_strong_reference();
+    }
+    return *this;
 }
 
-template <typename T, typename D>
-shared_ptr<T, D>::shared_ptr(const weak_ptr<T> &wp) {
+template <typename T, typename D, typename P>
+template <typename E>
+shared_ptr<T, D, P>::shared_ptr(shared_ptr<T, E, P> &&other) noexcept {
+    this->rc_ = nullptr;
+    std::swap(this->rc_, other.rc_);
+}
+
+template <typename T, typename D, typename P>
+template <typename E>
+shared_ptr<T, D, P> &shared_ptr<T, D, P>::operator=(shared_ptr<T, E, P> &&other) noexcept {
+    reset();
+    std::swap(this->rc_, other.rc_);
+    return *this;
+}
+
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P>::~shared_ptr() {
     reset();
-    if (wp.rc_ != nullptr) {
+}
+
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P>::shared_ptr(const weak_ptr<T, P> &wp) {
+    if (wp.rc_ != nullptr && wp.rc_->try_add_strong_reference()) {
         this->rc_ = wp.rc_;
-        this->rc_->strong_reference_count += 1;
     }
 }
 
-template <typename T, typename D>
-void shared_ptr<T, D>::swap(shared_ptr<T, D> &other) noexcept {
+template <typename T, typename D, typename P>
+void shared_ptr<T, D, P>::swap(shared_ptr<T, D, P> &other) noexcept {
     std::swap(this->rc_, other.rc_);
 }
 
-template <typename T, typename D>
-void shared_ptr<T, D>::reset(T *p) {
-    D deleter;
+template <typename T, typename D, typename P>
+void shared_ptr<T, D, P>::reset(T *p) {
+    reference_counter<T, P> *rc = (p != nullptr) ? pointer_reference_counter<T, D, P>::create(p, D(), allocator<T>()) : nullptr;
     if (this->rc_ != nullptr) {
-        if (this->rc_->strong_reference_count == 1) {
-            deleter(this->rc_->resource);
-            this->rc_->resource = nullptr;
-            if (this->rc_->weak_reference_count == 0) {
-                delete this->rc_;
-            }
-        } else {
-            this->rc_->strong_reference_count -= 1;
-        }
+        this->rc_->release_strong_reference();
     }
-    this->rc_ = (p != nullptr) ? new reference_counter{p} : nullptr;
+    this->rc_ = rc;
 }
 
-template <typename T, typename D>
-typename shared_ptr<T, D>::element_type *shared_ptr<T, D>::get() const noexcept {
+template <typename T, typename D, typename P>
+typename shared_ptr<T, D, P>::element_type *shared_ptr<T, D, P>::get() const noexcept {
     return (this->rc_ != nullptr) ? this->rc_->resource : nullptr;
 }
 
-template <typename T, typename D>
-typename shared_ptr<T, D>::element_type &shared_ptr<T, D>::operator*() const noexcept {
+template <typename T, typename D, typename P>
+typename shared_ptr<T, D, P>::element_type &shared_ptr<T, D, P>::operator*() const noexcept {
     return *(this->rc_->resource);
 }
 
-template <typename T, typename D>
-typename shared_ptr<T, D>::element_type *shared_ptr<T, D>::operator->() const noexcept {
+template <typename T, typename D, typename P>
+typename shared_ptr<T, D, P>::element_type *shared_ptr<T, D, P>::operator->() const noexcept {
     return this->rc_->resource;
 }
 
-template <typename T, typename D>
-std::size_t shared_ptr<T, D>::use_count() const noexcept {
-    return (this->rc_ != nullptr) ? this->rc_->strong_reference_count : 0;
+template <typename T, typename D, typename P>
+std::size_t shared_ptr<T, D, P>::use_count() const noexcept {
+    return (this->rc_ != nullptr) ? this->rc_->strong_count() : 0;
 }
 
-template <typename T, typename D>
-bool shared_ptr<T, D>::unique() const noexcept {
+template <typename T, typename D, typename P>
+bool shared_ptr<T, D, P>::unique() const noexcept {
     if (this->rc_ == nullptr) return false;
-    return this->rc_->strong_reference_count == 1;
+    return this->rc_->strong_count() == 1;
 }
 
-template <typename T, typename D>
-shared_ptr<T, D>::operator bool() const noexcept {
-    if (this->rc_ == nullptr) return false;
-    return this->rc_->resource != nullptr;
+template <typename T, typename D, typename P>
+shared_ptr<T, D, P>::operator bool() const noexcept {
+    return get() != nullptr;
 }
 
-template <typename T, typename D = default_deleter<T>, typename... Args>
-shared_ptr<T, D> make_shared(Args &&...args) {
-    return shared_ptr<T, D>(new T(std::forward<Args>(args)...));
+template <typename T, typename D = default_deleter<T>, typename P = atomic_count_policy, typename A, typename... Args>
+shared_ptr<T, D, P> allocate_shared(const A &alloc, Args &&...args) {
+    shared_ptr<T, D, P> ret;
+    ret.rc_ = inplace_reference_counter<T, P, A>::create(alloc, std::forward<Args>(args)...);
+    return ret;
 }
 
-template <typename T>
+template <typename T, typename D = default_deleter<T>, typename P = atomic_count_policy, typename... Args>
+shared_ptr<T, D, P> make_shared(Args &&...args) {
+    return allocate_shared<T, D, P>(allocator<T>(), std::forward<Args>(args)...);
+}
+
+template <typename T, typename P>
 template <typename D>
-weak_ptr<T>::weak_ptr(const shared_ptr<T, D> &sp) {
-    // if (sp.rc_ == nullptr) {
-    //     this->rc_ = nullptr;
-    //     return;
-    // }
-    reset();
+weak_ptr<T, P>::weak_ptr(const shared_ptr<T, D, P> &sp) {
     this->rc_ = sp.rc_;
-    this->rc_->weak_reference_count += 1;
+    if (this->rc_ != nullptr) {
+        this->rc_->add_weak_reference();
+    }
 }
 
-template <typename T>
-weak_ptr<T>::~weak_ptr() {
+template <typename T, typename P>
+weak_ptr<T, P>::weak_ptr(const weak_ptr<T, P> &other) {
+    this->rc_ = other.rc_;
+    if (this->rc_ != nullptr) {
+        this->rc_->add_weak_reference();
+    }
+}
+
+template <typename T, typename P>
+weak_ptr<T, P>::~weak_ptr() {
     reset();
 }
 
-template <typename T>
-weak_ptr<T> &weak_ptr<T>::operator=(const weak_ptr<T> &other) {
+template <typename T, typename P>
+weak_ptr<T, P> &weak_ptr<T, P>::operator=(const weak_ptr<T, P> &other) {
+    if (this->rc_ == other.rc_) return *this;
     reset();
     if (other.rc_ != nullptr) {
         this->rc_ = other.rc_;
-        this->rc_->weak_reference_count += 1;
+        this->rc_->add_weak_reference();
     }
     return *this;
 }
 
-template <typename T>
-weak_ptr<T>::weak_ptr(weak_ptr<T> &&other) {
+template <typename T, typename P>
+weak_ptr<T, P>::weak_ptr(weak_ptr<T, P> &&other) noexcept {
     std::swap(this->rc_, other.rc_);
 }
 
-template <typename T>
-weak_ptr<T> &weak_ptr<T>::operator=(weak_ptr<T> &&other) {
+template <typename T, typename P>
+weak_ptr<T, P> &weak_ptr<T, P>::operator=(weak_ptr<T, P> &&other) noexcept {
     reset();
     std::swap(this->rc_, other.rc_);
+    return *this;
 }
 
-template <typename T>
-void weak_ptr<T>::reset() {
+template <typename T, typename P>
+void weak_ptr<T, P>::reset() {
     if (this->rc_ == nullptr) return;
-    this->rc_->weak_reference_count -= 1;
-    if (this->rc_->weak_reference_count == 0 && this->rc_->strong_reference_count == 0) {
-        delete this->rc_;
-    }
+    this->rc_->release_weak_reference();
+    this->rc_ = nullptr;
 }
 
-template <typename T>
-void weak_ptr<T>::swap(weak_ptr<T> &other) {
+template <typename T, typename P>
+void weak_ptr<T, P>::swap(weak_ptr<T, P> &other) {
     std::swap(this->rc_, other.rc_);
 }
 
-template <typename T>
-bool weak_ptr<T>::expired() const {
+template <typename T, typename P>
+bool weak_ptr<T, P>::expired() const {
     if (this->rc_ == nullptr) return true;
-    if (this->rc_->resource == nullptr) return true;
-    return false;
+    return this->rc_->strong_count() == 0;
 }
 
-template <typename T>
-shared_ptr<T> weak_ptr<T>::lock() const {
-    if (this->rc_ == nullptr) return {};
-    shared_ptr<T> ret;
-    ret.rc_ = this->rc_;
-    ret.rc_->strong_reference_count += 1;
-    return ret;
+/*
+ * The strong count is only bumped while it is still non-zero, so a lock()
+ * racing with the last shared_ptr either wins and keeps the object alive or
+ * sees zero and returns an empty pointer; it never resurrects the object.
+ */
+template <typename T, typename P>
+shared_ptr<T, default_deleter<T>, P> weak_ptr<T, P>::lock() const {
+    return shared_ptr<T, default_deleter<T>, P>(*this);
 }
 
-template <typename T>
-std::size_t weak_ptr<T>::use_count() const {
+template <typename T, typename P>
+std::size_t weak_ptr<T, P>::use_count() const {
     if (this->rc_ == nullptr) return 0;
-    return this->rc_->strong_reference_count;
+    return this->rc_->strong_count();
 }
 
-}  // namespace tinystl
\ No newline at end of file
+}  // namespace tinystl
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace tinystl {
+
+enum class huge_page_mode {
+    // ordinary pages
+    none,
+    // madvise(MADV_HUGEPAGE) on 2 MiB aligned mappings, for transparent huge pages
+    transparent,
+    // MAP_HUGETLB from the reserved pool, falling back to ordinary pages when it is empty
+    hugetlb,
+};
+
+/*
+ * Memory resource that maps large requests straight from the kernel with
+ * mmap and sends smaller ones to ::operator new, the aligned form when the
+ * alignment asked for is stricter than new guarantees. Whether a block was
+ * mapped follows from its size alone, so deallocate() and reallocate() need
+ * the size and alignment the block was allocated with.
+ *
+ * reallocate() grows and shrinks mapped blocks with mremap, which moves page
+ * table entries instead of copying bytes; it is only meant for trivially
+ * copyable contents. decommit() hands the pages of a range back to the
+ * kernel while keeping it mapped; they read as zero afterwards.
+ */
+class mmap_resource {
+public:
+    static constexpr std::size_t default_threshold = std::size_t(1) << 20;
+    static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+public:
+    explicit mmap_resource(huge_page_mode mode = huge_page_mode::none, std::size_t threshold = default_threshold) noexcept;
+    mmap_resource(const mmap_resource &other) = delete;
+    mmap_resource &operator=(const mmap_resource &other) = delete;
+
+    void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+    void deallocate(void *p, std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept;
+    void *reallocate(void *p, std::size_t old_bytes, std::size_t new_bytes, std::size_t align = alignof(std::max_align_t));
+    void decommit(void *p, std::size_t bytes) noexcept;
+
+    bool is_mapped(std::size_t bytes) const noexcept;
+    std::size_t mapped_bytes() const noexcept;
+    std::size_t threshold() const noexcept;
+    huge_page_mode mode() const noexcept;
+    static std::size_t page_size() noexcept;
+
+private:
+    std::size_t mapping_length(std::size_t bytes) const noexcept;
+    void *map(std::size_t length);
+    void advise(void *p, std::size_t length) noexcept;
+
+private:
+    huge_page_mode mode_;
+    std::size_t threshold_;
+    std::atomic<std::size_t> mapped_{0};
+};
+
+inline mmap_resource::mmap_resource(huge_page_mode mode, std::size_t threshold) noexcept
+    : mode_(mode), threshold_(std::max(threshold, page_size())) {}
+
+inline void *mmap_resource::allocate(std::size_t bytes, std::size_t align) {
+    if (!is_mapped(bytes)) {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) return ::operator new(bytes, std::align_val_t(align));
+        return ::operator new(bytes);
+    }
+    if (align > page_size()) throw std::bad_alloc();
+    return map(mapping_length(bytes));
+}
+
+inline void mmap_resource::deallocate(void *p, std::size_t bytes, std::size_t align) noexcept {
+    if (p == nullptr) return;
+    if (!is_mapped(bytes)) {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(align));
+        } else {
+            ::operator delete(p);
+        }
+        return;
+    }
+    std::size_t length = mapping_length(bytes);
+    ::munmap(p, length);
+    this->mapped_.fetch_sub(length, std::memory_order_relaxed);
+}
+
+/*
+ * Resizes a block, keeping its first min(old_bytes, new_bytes) bytes. On
+ * failure the old block is left as it was.
+ */
+inline void *mmap_resource::reallocate(void *p, std::size_t old_bytes, std::size_t new_bytes, std::size_t align) {
+    if (p == nullptr) return allocate(new_bytes, align);
+    if (is_mapped(old_bytes) && is_mapped(new_bytes)) {
+        std::size_t old_length = mapping_length(old_bytes);
+        std::size_t new_length = mapping_length(new_bytes);
+        if (old_length == new_length) return p;
+#ifdef __linux__
+        void *q = ::mremap(p, old_length, new_length, MREMAP_MAYMOVE);
+        if (q != MAP_FAILED) {
+            if (new_length > old_length) {
+                this->mapped_.fetch_add(new_length - old_length, std::memory_order_relaxed);
+                advise(q, new_length);
+            } else {
+                this->mapped_.fetch_sub(old_length - new_length, std::memory_order_relaxed);
+            }
+            return q;
+        }
+#endif
+    }
+    void *q = allocate(new_bytes, align);
+    std::memcpy(q, p, std::min(old_bytes, new_bytes));
+    deallocate(p, old_bytes, align);
+    return q;
+}
+
+// only whole pages inside [p, p + bytes) of a mapped block are released
+inline void mmap_resource::decommit(void *p, std::size_t bytes) noexcept {
+    const std::uintptr_t page = page_size();
+    std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(p) + page - 1) & ~(page - 1);
+    std::uintptr_t last = (reinterpret_cast<std::uintptr_t>(p) + bytes) & ~(page - 1);
+    if (last > first) ::madvise(reinterpret_cast<void *>(first), last - first, MADV_DONTNEED);
+}
+
+inline bool mmap_resource::is_mapped(std::size_t bytes) const noexcept {
+    return bytes >= this->threshold_;
+}
+
+// total length of the live mappings, rounded to pages
+inline std::size_t mmap_resource::mapped_bytes() const noexcept {
+    return this->mapped_.load(std::memory_order_relaxed);
+}
+
+inline std::size_t mmap_resource::threshold() const noexcept {
+    return this->threshold_;
+}
+
+inline huge_page_mode mmap_resource::mode() const noexcept {
+    return this->mode_;
+}
+
+inline std::size_t mmap_resource::page_size() noexcept {
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// a mapping backed by huge pages must span whole huge pages, and a fallback
+// to ordinary pages keeps that length so munmap agrees with it
+inline std::size_t mmap_resource::mapping_length(std::size_t bytes) const noexcept {
+    std::size_t unit = (this->mode_ == huge_page_mode::none) ? page_size() : huge_page_size;
+    return (bytes + unit - 1) / unit * unit;
+}
+
+inline void *mmap_resource::map(std::size_t length) {
+    void *p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (this->mode_ == huge_page_mode::hugetlb) {
+        p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (p == MAP_FAILED && this->mode_ == huge_page_mode::transparent) {
+        // over-map and trim so the block starts on a huge page boundary
+        void *raw = ::mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+            std::uintptr_t aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+            std::size_t head = aligned - start;
+            if (head != 0) ::munmap(raw, head);
+            if (huge_page_size - head != 0) ::munmap(reinterpret_cast<void *>(aligned + length), huge_page_size - head);
+            p = reinterpret_cast<void *>(aligned);
+        }
+    } else if (p == MAP_FAILED) {
+        p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    advise(p, length);
+    this->mapped_.fetch_add(length, std::memory_order_relaxed);
+    return p;
+}
+
+inline void mmap_resource::advise(void *p, std::size_t length) noexcept {
+#ifdef MADV_HUGEPAGE
+    if (this->mode_ == huge_page_mode::transparent) ::madvise(p, length, MADV_HUGEPAGE);
+#else
+    (void)p;
+    (void)length;
+#endif
+}
+
+/*
+ * The resource behind default-constructed mmap_allocators. It is never
+ * destroyed, like the other process-wide pools.
+ */
+inline mmap_resource &default_mmap_resource() {
+    static mmap_resource *resource = new mmap_resource;
+    return *resource;
+}
+
+template <typename T>
+class mmap_allocator {
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = mmap_allocator<U>;
+    };
+
+public:
+    mmap_allocator() noexcept : resource_(&default_mmap_resource()) {}
+    mmap_allocator(mmap_resource &resource) noexcept : resource_(&resource) {}
+    mmap_allocator(const mmap_allocator &other) = default;
+    mmap_allocator(mmap_allocator &&other) = default;
+    mmap_allocator<T> &operator=(const mmap_allocator &other) = default;
+    mmap_allocator<T> &operator=(mmap_allocator &&other) = default;
+    template <typename U>
+    mmap_allocator(const mmap_allocator<U> &other) noexcept : resource_(other.resource()) {}
+
+    pointer allocate(size_type n);
+    void deallocate(pointer p, size_type n);
+    pointer reallocate(pointer p, size_type old_n, size_type new_n);
+    void decommit(pointer p, size_type n) noexcept;
+    template <typename... Args>
+    void construct(pointer p, Args &&...args);
+    void destroy(pointer p);
+    pointer address(reference x) const noexcept;
+    size_type max_size() const noexcept;
+    mmap_resource *resource() const noexcept;
+
+private:
+    mmap_resource *resource_;
+};
+
+template <typename T>
+typename mmap_allocator<T>::pointer mmap_allocator<T>::allocate(mmap_allocator<T>::size_type n) {
+    if (n == 0) return nullptr;
+    if (n > max_size()) throw std::bad_alloc();
+    return static_cast<mmap_allocator<T>::pointer>(this->resource_->allocate(n * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void mmap_allocator<T>::deallocate(mmap_allocator<T>::pointer p, mmap_allocator<T>::size_type n) {
+    this->resource_->deallocate(p, n * sizeof(T), alignof(T));
+}
+
+// moves the bytes of the elements, so only for trivially relocatable T
+template <typename T>
+typename mmap_allocator<T>::pointer mmap_allocator<T>::reallocate(mmap_allocator<T>::pointer p, mmap_allocator<T>::size_type old_n,
+                                                                  mmap_allocator<T>::size_type new_n) {
+    if (new_n > max_size()) throw std::bad_alloc();
+    return static_cast<mmap_allocator<T>::pointer>(this->resource_->reallocate(p, old_n * sizeof(T), new_n * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void mmap_allocator<T>::decommit(mmap_allocator<T>::pointer p, mmap_allocator<T>::size_type n) noexcept {
+    this->resource_->decommit(p, n * sizeof(T));
+}
+
+template <typename T>
+template <typename... Args>
+void mmap_allocator<T>::construct(mmap_allocator<T>::pointer p, Args &&...args) {
+    new (p) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void mmap_allocator<T>::destroy(mmap_allocator<T>::pointer p) {
+    p->~T();
+}
+
+template <typename T>
+typename mmap_allocator<T>::pointer mmap_allocator<T>::address(mmap_allocator<T>::reference x) const noexcept {
+    return std::addressof(x);
+}
+
+template <typename T>
+typename mmap_allocator<T>::size_type mmap_allocator<T>::max_size() const noexcept {
+    return static_cast<mmap_allocator<T>::size_type>(-1) / sizeof(T);
+}
+
+template <typename T>
+mmap_resource *mmap_allocator<T>::resource() const noexcept {
+    return this->resource_;
+}
+
+template <typename T, typename U>
+bool operator==(const mmap_allocator<T> &lhs, const mmap_allocator<U> &rhs) noexcept {
+    return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const mmap_allocator<T> &lhs, const mmap_allocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,500 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tinystl {
+
+enum class mmap_mode {
+    read_only,
+    // creates the file if it does not exist
+    read_write,
+};
+
+/*
+ * Vector whose elements live in a shared mapping of a file, so they persist
+ * as they are written and a later open() sees them without reading or
+ * parsing anything: pages are faulted in as they are touched.
+ *
+ * The file starts with a header holding the element count and size, and the
+ * elements follow at data_offset. Growing extends the file with ftruncate
+ * and remaps it, which invalidates pointers and iterators like reallocation
+ * in vector does. The capacity is whatever fits in the file, so the file
+ * keeps its slack across runs until shrink_to_fit().
+ *
+ * Writes reach the file through the page cache on their own; sync() waits
+ * until they are on disk. A read-only vector is mapped without write
+ * permission, so writing through its non-const accessors faults, and
+ * anything that would change its size throws std::logic_error.
+ */
+template <typename T>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector elements are stored as bytes");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr std::size_t data_offset = 64;
+    static_assert(alignof(T) <= data_offset, "mmap_vector elements must not be over-aligned");
+
+public:
+    mmap_vector() noexcept : fd_(-1), base_(nullptr), length_(0), read_only_(false) {}
+    explicit mmap_vector(const std::string &path, mmap_mode mode = mmap_mode::read_write);
+    mmap_vector(const mmap_vector &other) = delete;
+    mmap_vector(mmap_vector &&other) noexcept;
+    mmap_vector &operator=(const mmap_vector &other) = delete;
+    mmap_vector &operator=(mmap_vector &&other) noexcept;
+    ~mmap_vector();
+
+    void open(const std::string &path, mmap_mode mode = mmap_mode::read_write);
+    void close() noexcept;
+    bool is_open() const noexcept;
+    bool read_only() const noexcept;
+    void sync();
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) noexcept;
+    const_reference operator[](size_type pos) const noexcept;
+    reference front() noexcept;
+    const_reference front() const noexcept;
+    reference back() noexcept;
+    const_reference back() const noexcept;
+    T *data() noexcept;
+    const T *data() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void reserve(size_type n);
+    size_type capacity() const noexcept;
+    void shrink_to_fit();
+
+    void clear();
+    void push_back(const T &value);
+    template <typename... Args>
+    reference emplace_back(Args &&...args);
+    void pop_back();
+    void resize(size_type n);
+    void resize(size_type n, const T &value);
+    void swap(mmap_vector &other) noexcept;
+
+private:
+    struct header {
+        std::uint64_t magic;
+        std::uint64_t element_size;
+        std::uint64_t size;
+    };
+
+    static constexpr std::uint64_t file_magic = 0x31564d4c54534e54;  // "TNSTLMV1"
+
+    header *get_header() const noexcept;
+    void check_writable(const char *what) const;
+    void remap(std::size_t new_length);
+    void grow_for(size_type required);
+
+private:
+    int fd_;
+    unsigned char *base_;
+    std::size_t length_;
+    bool read_only_;
+};
+
+template <typename T>
+mmap_vector<T>::mmap_vector(const std::string &path, mmap_mode mode) : mmap_vector() {
+    open(path, mode);
+}
+
+template <typename T>
+mmap_vector<T>::mmap_vector(mmap_vector &&other) noexcept
+    : fd_(other.fd_), base_(other.base_), length_(other.length_), read_only_(other.read_only_) {
+    other.fd_ = -1;
+    other.base_ = nullptr;
+    other.length_ = 0;
+}
+
+template <typename T>
+mmap_vector<T> &mmap_vector<T>::operator=(mmap_vector &&other) noexcept {
+    mmap_vector(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename T>
+mmap_vector<T>::~mmap_vector() {
+    close();
+}
+
+/*
+ * Maps the file at path, closing whatever was open before. A new or empty
+ * file gets a header; an existing one must have been written by an
+ * mmap_vector of an element type with the same size.
+ */
+template <typename T>
+void mmap_vector<T>::open(const std::string &path, mmap_mode mode) {
+    close();
+    const bool writable = (mode == mmap_mode::read_write);
+    int fd = ::open(path.c_str(), writable ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC), 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "tinystl::mmap_vector: open " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "tinystl::mmap_vector: stat " + path);
+    }
+    std::size_t length = static_cast<std::size_t>(st.st_size);
+    if (length == 0 && writable) {
+        length = data_offset;
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "tinystl::mmap_vector: truncate " + path);
+        }
+    }
+    if (length < data_offset) {
+        ::close(fd);
+        throw std::runtime_error("tinystl::mmap_vector: " + path + " is too short");
+    }
+    void *p = ::mmap(nullptr, length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "tinystl::mmap_vector: mmap " + path);
+    }
+    this->fd_ = fd;
+    this->base_ = static_cast<unsigned char *>(p);
+    this->length_ = length;
+    this->read_only_ = !writable;
+
+    header *h = get_header();
+    if (h->magic == 0 && h->element_size == 0 && h->size == 0 && writable) {
+        h->magic = file_magic;
+        h->element_size = sizeof(T);
+    }
+    if (h->magic != file_magic || h->element_size != sizeof(T) || h->size > capacity()) {
+        close();
+        throw std::runtime_error("tinystl::mmap_vector: " + path + " does not hold elements of this type");
+    }
+}
+
+// unmaps without syncing; the kernel still writes dirty pages back later
+template <typename T>
+void mmap_vector<T>::close() noexcept {
+    if (this->base_ != nullptr) ::munmap(this->base_, this->length_);
+    if (this->fd_ >= 0) ::close(this->fd_);
+    this->fd_ = -1;
+    this->base_ = nullptr;
+    this->length_ = 0;
+}
+
+template <typename T>
+bool mmap_vector<T>::is_open() const noexcept {
+    return this->base_ != nullptr;
+}
+
+template <typename T>
+bool mmap_vector<T>::read_only() const noexcept {
+    return this->read_only_;
+}
+
+template <typename T>
+void mmap_vector<T>::sync() {
+    if (this->base_ == nullptr || this->read_only_) return;
+    if (::msync(this->base_, this->length_, MS_SYNC) != 0) {
+        throw std::system_error(errno, std::generic_category(), "tinystl::mmap_vector::sync");
+    }
+}
+
+template <typename T>
+typename mmap_vector<T>::reference mmap_vector<T>::at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("tinystl::mmap_vector::at");
+    return data()[pos];
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reference mmap_vector<T>::at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("tinystl::mmap_vector::at");
+    return data()[pos];
+}
+
+template <typename T>
+typename mmap_vector<T>::reference mmap_vector<T>::operator[](size_type pos) noexcept {
+    return data()[pos];
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reference mmap_vector<T>::operator[](size_type pos) const noexcept {
+    return data()[pos];
+}
+
+template <typename T>
+typename mmap_vector<T>::reference mmap_vector<T>::front() noexcept {
+    return data()[0];
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reference mmap_vector<T>::front() const noexcept {
+    return data()[0];
+}
+
+template <typename T>
+typename mmap_vector<T>::reference mmap_vector<T>::back() noexcept {
+    return data()[size() - 1];
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reference mmap_vector<T>::back() const noexcept {
+    return data()[size() - 1];
+}
+
+template <typename T>
+T *mmap_vector<T>::data() noexcept {
+    return (this->base_ == nullptr) ? nullptr : reinterpret_cast<T *>(this->base_ + data_offset);
+}
+
+template <typename T>
+const T *mmap_vector<T>::data() const noexcept {
+    return (this->base_ == nullptr) ? nullptr : reinterpret_cast<const T *>(this->base_ + data_offset);
+}
+
+template <typename T>
+typename mmap_vector<T>::iterator mmap_vector<T>::begin() noexcept {
+    return data();
+}
+
+template <typename T>
+typename mmap_vector<T>::const_iterator mmap_vector<T>::begin() const noexcept {
+    return data();
+}
+
+template <typename T>
+typename mmap_vector<T>::const_iterator mmap_vector<T>::cbegin() const noexcept {
+    return data();
+}
+
+template <typename T>
+typename mmap_vector<T>::iterator mmap_vector<T>::end() noexcept {
+    return data() + size();
+}
+
+template <typename T>
+typename mmap_vector<T>::const_iterator mmap_vector<T>::end() const noexcept {
+    return data() + size();
+}
+
+template <typename T>
+typename mmap_vector<T>::const_iterator mmap_vector<T>::cend() const noexcept {
+    return data() + size();
+}
+
+template <typename T>
+typename mmap_vector<T>::reverse_iterator mmap_vector<T>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reverse_iterator mmap_vector<T>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reverse_iterator mmap_vector<T>::crbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename mmap_vector<T>::reverse_iterator mmap_vector<T>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reverse_iterator mmap_vector<T>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+typename mmap_vector<T>::const_reverse_iterator mmap_vector<T>::crend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+bool mmap_vector<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template <typename T>
+typename mmap_vector<T>::size_type mmap_vector<T>::size() const noexcept {
+    return (this->base_ == nullptr) ? 0 : static_cast<size_type>(get_header()->size);
+}
+
+template <typename T>
+typename mmap_vector<T>::size_type mmap_vector<T>::max_size() const noexcept {
+    return (static_cast<size_type>(std::numeric_limits<off_t>::max()) - data_offset) / sizeof(T);
+}
+
+template <typename T>
+void mmap_vector<T>::reserve(size_type n) {
+    check_writable("reserve");
+    if (n > capacity()) grow_for(n);
+}
+
+template <typename T>
+typename mmap_vector<T>::size_type mmap_vector<T>::capacity() const noexcept {
+    return (this->base_ == nullptr) ? 0 : (this->length_ - data_offset) / sizeof(T);
+}
+
+// truncates the file to the elements it holds
+template <typename T>
+void mmap_vector<T>::shrink_to_fit() {
+    check_writable("shrink_to_fit");
+    if (size() != capacity()) remap(data_offset + size() * sizeof(T));
+}
+
+template <typename T>
+void mmap_vector<T>::clear() {
+    check_writable("clear");
+    get_header()->size = 0;
+}
+
+template <typename T>
+void mmap_vector<T>::push_back(const T &value) {
+    emplace_back(value);
+}
+
+template <typename T>
+template <typename... Args>
+typename mmap_vector<T>::reference mmap_vector<T>::emplace_back(Args &&...args) {
+    check_writable("emplace_back");
+    size_type n = size();
+    if (n == capacity()) {
+        // args may refer to an element that moves with the mapping
+        T tmp(std::forward<Args>(args)...);
+        grow_for(n + 1);
+        ::new (static_cast<void *>(data() + n)) T(tmp);
+    } else {
+        ::new (static_cast<void *>(data() + n)) T(std::forward<Args>(args)...);
+    }
+    get_header()->size = n + 1;
+    return data()[n];
+}
+
+template <typename T>
+void mmap_vector<T>::pop_back() {
+    check_writable("pop_back");
+    --get_header()->size;
+}
+
+template <typename T>
+void mmap_vector<T>::resize(size_type n) {
+    resize(n, T());
+}
+
+template <typename T>
+void mmap_vector<T>::resize(size_type n, const T &value) {
+    check_writable("resize");
+    size_type old = size();
+    if (n > old) {
+        if (n > capacity()) {
+            T tmp(value);
+            grow_for(n);
+            fill_bytes_n(data() + old, n - old, tmp);
+        } else {
+            fill_bytes_n(data() + old, n - old, value);
+        }
+    }
+    get_header()->size = n;
+}
+
+template <typename T>
+void mmap_vector<T>::swap(mmap_vector &other) noexcept {
+    std::swap(this->fd_, other.fd_);
+    std::swap(this->base_, other.base_);
+    std::swap(this->length_, other.length_);
+    std::swap(this->read_only_, other.read_only_);
+}
+
+template <typename T>
+typename mmap_vector<T>::header *mmap_vector<T>::get_header() const noexcept {
+    return reinterpret_cast<header *>(this->base_);
+}
+
+template <typename T>
+void mmap_vector<T>::check_writable(const char *what) const {
+    if (this->base_ == nullptr) throw std::logic_error(std::string("tinystl::mmap_vector::") + what + ": not open");
+    if (this->read_only_) throw std::logic_error(std::string("tinystl::mmap_vector::") + what + ": read-only");
+}
+
+/*
+ * Resizes the file and the mapping together. If the mapping cannot follow,
+ * the file is put back to its old length so the two stay in step.
+ */
+template <typename T>
+void mmap_vector<T>::remap(std::size_t new_length) {
+    if (::ftruncate(this->fd_, static_cast<off_t>(new_length)) != 0) {
+        throw std::system_error(errno, std::generic_category(), "tinystl::mmap_vector: truncate");
+    }
+#ifdef __linux__
+    void *p = ::mremap(this->base_, this->length_, new_length, MREMAP_MAYMOVE);
+#else
+    void *p = ::mmap(nullptr, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd_, 0);
+    if (p != MAP_FAILED) ::munmap(this->base_, this->length_);
+#endif
+    if (p == MAP_FAILED) {
+        int err = errno;
+        (void)::ftruncate(this->fd_, static_cast<off_t>(this->length_));
+        throw std::system_error(err, std::generic_category(), "tinystl::mmap_vector: mremap");
+    }
+    this->base_ = static_cast<unsigned char *>(p);
+    this->length_ = new_length;
+}
+
+// doubles the capacity at least, and rounds the file up to whole pages
+template <typename T>
+void mmap_vector<T>::grow_for(size_type required) {
+    if (required > max_size()) throw std::length_error("tinystl::mmap_vector");
+    size_type cap = std::max(required, std::min(capacity() * 2, max_size()));
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t length = data_offset + cap * sizeof(T);
+    length = (length + page - 1) / page * page;
+    remap(length);
+}
+
+}  // namespace tinystl
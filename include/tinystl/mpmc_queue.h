@@ -0,0 +1,278 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Bounded multi-producer/multi-consumer queue after Dmitry Vyukov's design.
+ *
+ * Each cell carries a sequence number telling whose turn it is: a cell at
+ * position pos is free for the producer of pos when its sequence equals pos,
+ * and holds an element for the consumer of pos when it equals pos + 1. A
+ * consumer hands the cell on to the producer one lap later by setting it to
+ * pos + capacity. Producers and consumers claim positions with a CAS on head
+ * and tail respectively, so neither side ever waits for the other; a push
+ * into a full queue and a pop from an empty one simply fail.
+ *
+ * The batched variants claim a run of consecutive ready cells with one CAS.
+ * Elements must be nothrow move constructible, because a claimed cell has to
+ * be filled. Elements that cannot be built in place without throwing are
+ * built on the stack first and moved in.
+ */
+template <typename T, typename Allocator = allocator<T>>
+class mpmc_queue {
+    static_assert(std::is_nothrow_move_constructible<T>::value, "mpmc_queue elements must be nothrow move constructible");
+    static_assert(std::is_nothrow_destructible<T>::value, "mpmc_queue elements must be nothrow destructible");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+public:
+    explicit mpmc_queue(size_type capacity, const Allocator &alloc = Allocator());
+    mpmc_queue(const mpmc_queue &other) = delete;
+    mpmc_queue &operator=(const mpmc_queue &other) = delete;
+    ~mpmc_queue();
+
+    bool try_push(const T &value);
+    bool try_push(T &&value) noexcept;
+    template <typename... Args>
+    bool try_emplace(Args &&...args);
+    bool try_pop(T &value) noexcept(std::is_nothrow_move_assignable<T>::value);
+    template <typename InputIt>
+    size_type push_n(InputIt first, size_type n);
+    template <typename OutputIt>
+    size_type pop_n(OutputIt out, size_type n);
+
+    size_type capacity() const noexcept;
+    size_type size_approx() const noexcept;
+    bool empty_approx() const noexcept;
+
+private:
+    struct cell {
+        std::atomic<size_type> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *value() noexcept { return reinterpret_cast<T *>(this->storage); }
+    };
+
+    using cell_allocator = typename Allocator::template rebind<cell>::other;
+
+    static size_type round_up(size_type n);
+    template <typename... Args>
+    bool emplace_in_place(Args &&...args) noexcept;
+    size_type claim_push(size_type n, size_type &pos) noexcept;
+    size_type claim_pop(size_type n, size_type &pos) noexcept;
+
+private:
+    cell *cells_;
+    size_type mask_;
+    cell_allocator alloc_;
+    // producers and consumers each hammer their own index, keep them apart
+    alignas(64) std::atomic<size_type> head_;
+    alignas(64) std::atomic<size_type> tail_;
+};
+
+template <typename T, typename A>
+mpmc_queue<T, A>::mpmc_queue(size_type capacity, const A &alloc)
+    : cells_(nullptr), mask_(round_up(capacity) - 1), alloc_(alloc), head_(0), tail_(0) {
+    this->cells_ = this->alloc_.allocate(this->mask_ + 1);
+    for (size_type i = 0; i <= this->mask_; ++i) {
+        ::new (static_cast<void *>(this->cells_ + i)) cell;
+        this->cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, typename A>
+mpmc_queue<T, A>::~mpmc_queue() {
+    size_type tail = this->tail_.load(std::memory_order_relaxed);
+    size_type head = this->head_.load(std::memory_order_relaxed);
+    for (; tail != head; ++tail) this->cells_[tail & this->mask_].value()->~T();
+    for (size_type i = 0; i <= this->mask_; ++i) this->cells_[i].~cell();
+    this->alloc_.deallocate(this->cells_, this->mask_ + 1);
+}
+
+template <typename T, typename A>
+bool mpmc_queue<T, A>::try_push(const T &value) {
+    return try_emplace(value);
+}
+
+template <typename T, typename A>
+bool mpmc_queue<T, A>::try_push(T &&value) noexcept {
+    return emplace_in_place(std::move(value));
+}
+
+template <typename T, typename A>
+template <typename... Args>
+bool mpmc_queue<T, A>::try_emplace(Args &&...args) {
+    if constexpr (std::is_nothrow_constructible<T, Args &&...>::value) {
+        return emplace_in_place(std::forward<Args>(args)...);
+    } else {
+        T tmp(std::forward<Args>(args)...);
+        return emplace_in_place(std::move(tmp));
+    }
+}
+
+template <typename T, typename A>
+bool mpmc_queue<T, A>::try_pop(T &value) noexcept(std::is_nothrow_move_assignable<T>::value) {
+    size_type pos;
+    if (claim_pop(1, pos) == 0) return false;
+    cell &c = this->cells_[pos & this->mask_];
+    struct release {
+        cell &c;
+        size_type next;
+        ~release() {
+            c.value()->~T();
+            c.sequence.store(next, std::memory_order_release);
+        }
+    } guard{c, pos + this->mask_ + 1};
+    value = std::move(*c.value());
+    return true;
+}
+
+/*
+ * Pushes up to n elements from first and returns how many went in; fewer
+ * than n means the queue filled up. Elements are taken in order, so the
+ * remaining ones start at std::next(first, returned).
+ */
+template <typename T, typename A>
+template <typename InputIt>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::push_n(InputIt first, size_type n) {
+    using source = typename std::iterator_traits<InputIt>::reference;
+    if constexpr (!std::is_nothrow_constructible<T, source>::value) {
+        size_type pushed = 0;
+        for (; pushed < n && try_emplace(*first); ++pushed) ++first;
+        return pushed;
+    } else {
+        size_type pushed = 0;
+        while (pushed < n) {
+            size_type pos;
+            size_type k = claim_push(n - pushed, pos);
+            if (k == 0) break;
+            for (size_type i = 0; i < k; ++i, ++first) {
+                cell &c = this->cells_[(pos + i) & this->mask_];
+                ::new (static_cast<void *>(c.value())) T(*first);
+                c.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            pushed += k;
+        }
+        return pushed;
+    }
+}
+
+/*
+ * Pops up to n elements into out and returns how many came out. Assigning
+ * through out must not throw: the elements are already claimed by then.
+ */
+template <typename T, typename A>
+template <typename OutputIt>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::pop_n(OutputIt out, size_type n) {
+    size_type popped = 0;
+    while (popped < n) {
+        size_type pos;
+        size_type k = claim_pop(n - popped, pos);
+        if (k == 0) break;
+        for (size_type i = 0; i < k; ++i) {
+            cell &c = this->cells_[(pos + i) & this->mask_];
+            *out = std::move(*c.value());
+            ++out;
+            c.value()->~T();
+            c.sequence.store(pos + i + this->mask_ + 1, std::memory_order_release);
+        }
+        popped += k;
+    }
+    return popped;
+}
+
+template <typename T, typename A>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::capacity() const noexcept {
+    return this->mask_ + 1;
+}
+
+// exact only while no other thread is pushing or popping
+template <typename T, typename A>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::size_approx() const noexcept {
+    size_type tail = this->tail_.load(std::memory_order_relaxed);
+    size_type head = this->head_.load(std::memory_order_relaxed);
+    return (head > tail) ? head - tail : 0;
+}
+
+template <typename T, typename A>
+bool mpmc_queue<T, A>::empty_approx() const noexcept {
+    return size_approx() == 0;
+}
+
+// capacity is a power of two so that positions map to cells with a mask
+template <typename T, typename A>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::round_up(size_type n) {
+    if (n == 0) throw std::invalid_argument("tinystl::mpmc_queue: capacity must be positive");
+    size_type cap = 2;
+    while (cap < n) cap *= 2;
+    return cap;
+}
+
+template <typename T, typename A>
+template <typename... Args>
+bool mpmc_queue<T, A>::emplace_in_place(Args &&...args) noexcept {
+    size_type pos;
+    if (claim_push(1, pos) == 0) return false;
+    cell &c = this->cells_[pos & this->mask_];
+    ::new (static_cast<void *>(c.value())) T(std::forward<Args>(args)...);
+    c.sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/*
+ * Claims up to n consecutive free cells starting at head and returns how
+ * many it got, storing the first position in pos. A cell seen free stays
+ * free until someone claims its position, so the cells in front of a
+ * successful CAS are ours.
+ */
+template <typename T, typename A>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::claim_push(size_type n, size_type &pos) noexcept {
+    pos = this->head_.load(std::memory_order_relaxed);
+    for (;;) {
+        size_type seq = this->cells_[pos & this->mask_].sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+        if (diff == 0) {
+            size_type k = 1;
+            while (k < n && this->cells_[(pos + k) & this->mask_].sequence.load(std::memory_order_acquire) == pos + k) ++k;
+            if (this->head_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) return k;
+        } else if (diff < 0) {
+            // the consumer of the previous lap has not freed the cell yet
+            return 0;
+        } else {
+            pos = this->head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, typename A>
+typename mpmc_queue<T, A>::size_type mpmc_queue<T, A>::claim_pop(size_type n, size_type &pos) noexcept {
+    pos = this->tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        size_type seq = this->cells_[pos & this->mask_].sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+        if (diff == 0) {
+            size_type k = 1;
+            while (k < n && this->cells_[(pos + k) & this->mask_].sequence.load(std::memory_order_acquire) == pos + k + 1) ++k;
+            if (this->tail_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) return k;
+        } else if (diff < 0) {
+            // the producer of this position has not published yet
+            return 0;
+        } else {
+            pos = this->tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+}  // namespace tinystl
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <tinystl/memory.h>
+#include <tinystl/vector.h>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl {
+
+// object_pool policy: released objects are destroyed and built anew by acquire()
+struct destroy_on_release {};
+
+// deleter for object_pool handles, returning the object to its pool
+template <typename Pool>
+class pool_deleter {
+public:
+    pool_deleter() noexcept : pool_(nullptr) {}
+    explicit pool_deleter(Pool *pool) noexcept : pool_(pool) {}
+
+    void operator()(typename Pool::value_type *p) const noexcept;
+    Pool *pool() const noexcept;
+
+private:
+    Pool *pool_;
+};
+
+template <typename Pool>
+void pool_deleter<Pool>::operator()(typename Pool::value_type *p) const noexcept {
+    this->pool_->release(p);
+}
+
+template <typename Pool>
+Pool *pool_deleter<Pool>::pool() const noexcept {
+    return this->pool_;
+}
+
+/*
+ * Pool of T objects handed out as unique_ptr handles whose deleter puts
+ * the object back on the pool's free list instead of freeing it. Slots are
+ * carved from chunks that double in size and are only returned to the
+ * allocator when the pool dies, so the pool has to outlive its handles.
+ *
+ * With Reset = destroy_on_release, a released object is destroyed and
+ * acquire() constructs a new one in its slot from its arguments. Any other
+ * Reset is a callable taking T &: released objects stay alive, Reset is
+ * called on them, and acquire() hands them out again as they are, so
+ * buffers they own stay allocated across reuse. Reset must not throw.
+ *
+ * The pool is not synchronized; handles must be released on the thread that
+ * owns the pool.
+ */
+template <typename T, typename Reset = destroy_on_release, typename Allocator = allocator<T>>
+class object_pool {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+    using deleter_type = pool_deleter<object_pool>;
+    using handle = unique_ptr<T, deleter_type>;
+
+    static constexpr bool keeps_objects = !std::is_same<Reset, destroy_on_release>::value;
+
+public:
+    explicit object_pool(size_type first_chunk = 64, const Reset &reset = Reset(), const Allocator &alloc = Allocator());
+    object_pool(const object_pool &other) = delete;
+    object_pool &operator=(const object_pool &other) = delete;
+    ~object_pool();
+
+    template <typename... Args>
+    handle acquire(Args &&...args);
+    void release(T *p) noexcept;
+    void reserve(size_type n);
+
+    size_type capacity() const noexcept;
+    size_type in_use() const noexcept;
+
+private:
+    struct chunk {
+        T *slots;
+        size_type count;
+    };
+
+    T *next_slot();
+    void add_chunk(size_type count);
+    void retire_rest();
+
+private:
+    vector<chunk> chunks_;
+    // released slots, with capacity for every slot so release() never allocates
+    vector<T *> free_;
+    T *cursor_;
+    T *chunk_end_;
+    size_type capacity_;
+    size_type in_use_;
+    size_type first_chunk_;
+    Reset reset_;
+    Allocator alloc_;
+};
+
+template <typename T, typename R, typename A>
+object_pool<T, R, A>::object_pool(size_type first_chunk, const R &reset, const A &alloc)
+    : chunks_(), free_(), cursor_(nullptr), chunk_end_(nullptr), capacity_(0), in_use_(0),
+      first_chunk_(std::max<size_type>(first_chunk, 1)), reset_(reset), alloc_(alloc) {}
+
+template <typename T, typename R, typename A>
+object_pool<T, R, A>::~object_pool() {
+    if constexpr (keeps_objects) {
+        for (T *p : this->free_) this->alloc_.destroy(p);
+    }
+    for (const chunk &c : this->chunks_) this->alloc_.deallocate(c.slots, c.count);
+}
+
+/*
+ * Takes the most recently released slot first, since it is the most likely
+ * to still be in cache. If constructing the object throws, the slot stays
+ * free.
+ */
+template <typename T, typename R, typename A>
+template <typename... Args>
+typename object_pool<T, R, A>::handle object_pool<T, R, A>::acquire(Args &&...args) {
+    if constexpr (keeps_objects) {
+        static_assert(sizeof...(Args) == 0, "objects are reused as they are, acquire() takes no arguments");
+        if (!this->free_.empty()) {
+            T *p = this->free_.back();
+            this->free_.pop_back();
+            ++this->in_use_;
+            return handle(p, deleter_type(this));
+        }
+        T *p = next_slot();
+        this->alloc_.construct(p);
+        ++this->cursor_;
+        ++this->in_use_;
+        return handle(p, deleter_type(this));
+    } else {
+        if (!this->free_.empty()) {
+            T *p = this->free_.back();
+            this->alloc_.construct(p, std::forward<Args>(args)...);
+            this->free_.pop_back();
+            ++this->in_use_;
+            return handle(p, deleter_type(this));
+        }
+        T *p = next_slot();
+        this->alloc_.construct(p, std::forward<Args>(args)...);
+        ++this->cursor_;
+        ++this->in_use_;
+        return handle(p, deleter_type(this));
+    }
+}
+
+template <typename T, typename R, typename A>
+void object_pool<T, R, A>::release(T *p) noexcept {
+    if constexpr (keeps_objects) {
+        this->reset_(*p);
+    } else {
+        this->alloc_.destroy(p);
+    }
+    this->free_.push_back(p);
+    --this->in_use_;
+}
+
+// makes room for n objects in use at once without going to the allocator
+template <typename T, typename R, typename A>
+void object_pool<T, R, A>::reserve(size_type n) {
+    if (n > this->capacity_) add_chunk(n - this->capacity_);
+}
+
+template <typename T, typename R, typename A>
+typename object_pool<T, R, A>::size_type object_pool<T, R, A>::capacity() const noexcept {
+    return this->capacity_;
+}
+
+template <typename T, typename R, typename A>
+typename object_pool<T, R, A>::size_type object_pool<T, R, A>::in_use() const noexcept {
+    return this->in_use_;
+}
+
+// the next never-used slot, adding a chunk when the current one is used up
+template <typename T, typename R, typename A>
+T *object_pool<T, R, A>::next_slot() {
+    if (this->cursor_ == this->chunk_end_) add_chunk(this->chunks_.empty() ? this->first_chunk_ : this->capacity_);
+    return this->cursor_;
+}
+
+template <typename T, typename R, typename A>
+void object_pool<T, R, A>::add_chunk(size_type count) {
+    this->free_.reserve(this->capacity_ + count);
+    this->chunks_.reserve(this->chunks_.size() + 1);
+    T *slots = this->alloc_.allocate(count);
+    this->chunks_.push_back(chunk{slots, count});
+    this->capacity_ += count;
+    retire_rest();
+    this->cursor_ = slots;
+    this->chunk_end_ = slots + count;
+}
+
+/*
+ * Moves the never-used slots of the current chunk to the free list before
+ * the pool switches to a new one. Objects that are kept alive on the free
+ * list are built for them here.
+ */
+template <typename T, typename R, typename A>
+void object_pool<T, R, A>::retire_rest() {
+    for (; this->cursor_ != this->chunk_end_; ++this->cursor_) {
+        if constexpr (keeps_objects) this->alloc_.construct(this->cursor_);
+        this->free_.push_back(this->cursor_);
+    }
+}
+
+}  // namespace tinystl
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <tinystl/thread_pool.h>
+#include <tinystl/vector.h>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Parallel algorithms over random-access ranges such as tinystl::vector
+ * iterators, run on a thread_pool (thread_pool::instance() unless one is
+ * given). Ranges are split in halves recursively, forking one half as a task,
+ * until pieces reach parallel_grain() elements; idle workers steal the
+ * largest pending halves first. A range no longer than one grain goes
+ * straight to the serial std:: algorithm. Operations passed to reduce and
+ * inclusive_scan must be associative, and their results are combined in
+ * range order.
+ */
+
+/*
+ * About eight pieces per thread, including the one that waits: enough for
+ * stealing to even out pieces that take uneven time, few enough that the
+ * forking cost stays small next to the work on a large input. Pieces are
+ * never smaller than parallel_min_grain elements, below which a task costs
+ * more than it saves.
+ */
+constexpr std::size_t parallel_min_grain = 2048;
+
+inline std::size_t parallel_grain(std::size_t n, const thread_pool &pool) noexcept {
+    std::size_t pieces = 8 * (pool.size() + 1);
+    return std::max<std::size_t>((n + pieces - 1) / pieces, parallel_min_grain);
+}
+
+// calls body(lo, hi) on disjoint subranges covering [first, last)
+template <typename F>
+void parallel_for_range(thread_pool &pool, std::size_t first, std::size_t last, std::size_t grain, const F &body) {
+    task_group group(pool);
+    while (last - first > grain) {
+        std::size_t mid = first + (last - first) / 2;
+        group.run([&pool, mid, last, grain, &body] { parallel_for_range(pool, mid, last, grain, body); });
+        last = mid;
+    }
+    body(first, last);
+    group.wait();
+}
+
+template <typename RandomIt, typename F>
+void parallel_for_each(thread_pool &pool, RandomIt first, RandomIt last, F f) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    std::size_t grain = parallel_grain(n, pool);
+    if (n <= grain) {
+        std::for_each(first, last, f);
+        return;
+    }
+    parallel_for_range(pool, 0, n, grain, [first, &f](std::size_t lo, std::size_t hi) {
+        for (RandomIt it = first + lo, end = first + hi; it != end; ++it) f(*it);
+    });
+}
+
+template <typename RandomIt, typename F>
+void parallel_for_each(RandomIt first, RandomIt last, F f) {
+    parallel_for_each(thread_pool::instance(), first, last, std::move(f));
+}
+
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt parallel_transform(thread_pool &pool, RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    std::size_t grain = parallel_grain(n, pool);
+    if (n <= grain) return std::transform(first, last, d_first, op);
+    parallel_for_range(pool, 0, n, grain, [first, d_first, &op](std::size_t lo, std::size_t hi) {
+        std::transform(first + lo, first + hi, d_first + lo, op);
+    });
+    return d_first + n;
+}
+
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt parallel_transform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op) {
+    return parallel_transform(thread_pool::instance(), first, last, d_first, std::move(op));
+}
+
+// reduces the non-empty range [first + lo, first + hi)
+template <typename T, typename RandomIt, typename BinaryOp>
+T parallel_reduce_range(thread_pool &pool, RandomIt first, std::size_t lo, std::size_t hi, std::size_t grain, const BinaryOp &op) {
+    if (hi - lo <= grain) {
+        T acc = first[lo];
+        for (std::size_t i = lo + 1; i < hi; ++i) acc = op(std::move(acc), first[i]);
+        return acc;
+    }
+    std::size_t mid = lo + (hi - lo) / 2;
+    std::optional<T> right;
+    task_group group(pool);
+    group.run([&] { right.emplace(parallel_reduce_range<T>(pool, first, mid, hi, grain, op)); });
+    T left = parallel_reduce_range<T>(pool, first, lo, mid, grain, op);
+    group.wait();
+    return op(std::move(left), std::move(*right));
+}
+
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(thread_pool &pool, RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp()) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    std::size_t grain = parallel_grain(n, pool);
+    if (n <= grain) return std::accumulate(first, last, std::move(init), op);
+    return op(std::move(init), parallel_reduce_range<T>(pool, first, 0, n, grain, op));
+}
+
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp()) {
+    return parallel_reduce(thread_pool::instance(), first, last, std::move(init), std::move(op));
+}
+
+/*
+ * Moves the sorted ranges [a_first, a_last) and [b_first, b_last) into out.
+ * The larger range is split at its middle element and the other at that
+ * element's lower bound, so both halves merge independently.
+ */
+template <typename InputIt, typename OutputIt, typename Compare>
+void parallel_merge(thread_pool &pool, InputIt a_first, InputIt a_last, InputIt b_first, InputIt b_last, OutputIt out, std::size_t grain, const Compare &comp) {
+    std::size_t na = static_cast<std::size_t>(a_last - a_first);
+    std::size_t nb = static_cast<std::size_t>(b_last - b_first);
+    // with fewer than three elements a split might not make progress
+    if (na + nb <= std::max<std::size_t>(grain, 2)) {
+        std::merge(std::make_move_iterator(a_first), std::make_move_iterator(a_last), std::make_move_iterator(b_first),
+                   std::make_move_iterator(b_last), out, comp);
+        return;
+    }
+    if (na < nb) {
+        std::swap(a_first, b_first);
+        std::swap(a_last, b_last);
+        std::swap(na, nb);
+    }
+    InputIt a_mid = a_first + na / 2;
+    InputIt b_mid = std::lower_bound(b_first, b_last, *a_mid, comp);
+    OutputIt out_mid = out + (a_mid - a_first) + (b_mid - b_first);
+    task_group group(pool);
+    group.run([&] { parallel_merge(pool, a_first, a_mid, b_first, b_mid, out, grain, comp); });
+    parallel_merge(pool, a_mid, a_last, b_mid, b_last, out_mid, grain, comp);
+    group.wait();
+}
+
+/*
+ * Sorts the n elements at data, leaving the result at data when into_data is
+ * set and at other otherwise. The halves are sorted into the opposite array
+ * and merged back, so every level moves each element exactly once.
+ */
+template <typename DataIt, typename OtherIt, typename Compare>
+void parallel_sort_step(thread_pool &pool, DataIt data, OtherIt other, std::size_t n, bool into_data, std::size_t grain, const Compare &comp) {
+    if (n <= grain) {
+        std::sort(data, data + n, comp);
+        if (!into_data) std::move(data, data + n, other);
+        return;
+    }
+    std::size_t half = n / 2;
+    task_group group(pool);
+    group.run([&] { parallel_sort_step(pool, data, other, half, !into_data, grain, comp); });
+    parallel_sort_step(pool, data + half, other + half, n - half, !into_data, grain, comp);
+    group.wait();
+    if (into_data) {
+        parallel_merge(pool, other, other + half, other + half, other + n, data, grain, comp);
+    } else {
+        parallel_merge(pool, data, data + half, data + half, data + n, other, grain, comp);
+    }
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(thread_pool &pool, RandomIt first, RandomIt last, Compare comp = Compare()) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    std::size_t n = static_cast<std::size_t>(last - first);
+    std::size_t grain = parallel_grain(n, pool);
+    if (n <= grain) {
+        std::sort(first, last, comp);
+        return;
+    }
+    // the elements start out in the buffer and are sorted back into place
+    vector<value_type> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+    parallel_sort_step(pool, buffer.begin(), first, n, false, grain, comp);
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    parallel_sort(thread_pool::instance(), first, last, std::move(comp));
+}
+
+/*
+ * Two passes over pieces of the range: each piece is scanned on its own,
+ * then the running totals of the pieces before it are folded into all but
+ * the first. d_first may equal first.
+ */
+template <typename RandomIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt parallel_inclusive_scan(thread_pool &pool, RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op = BinaryOp()) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    std::size_t n = static_cast<std::size_t>(last - first);
+    std::size_t grain = parallel_grain(n, pool);
+    if (n <= grain) return std::inclusive_scan(first, last, d_first, op);
+    std::size_t pieces = (n + grain - 1) / grain;
+
+    parallel_for_range(pool, 0, pieces, 1, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t p = lo; p < hi; ++p) {
+            std::size_t begin = p * grain;
+            std::size_t end = std::min(begin + grain, n);
+            value_type acc = first[begin];
+            d_first[begin] = acc;
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                acc = op(std::move(acc), first[i]);
+                d_first[i] = acc;
+            }
+        }
+    });
+
+    // offsets[p - 1] is the total of every piece before p
+    vector<value_type> offsets;
+    offsets.reserve(pieces - 1);
+    for (std::size_t p = 1; p < pieces; ++p) {
+        value_type last_of_previous = d_first[p * grain - 1];
+        offsets.push_back(offsets.empty() ? std::move(last_of_previous) : op(offsets.back(), std::move(last_of_previous)));
+    }
+
+    parallel_for_range(pool, 1, pieces, 1, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t p = lo; p < hi; ++p) {
+            std::size_t begin = p * grain;
+            std::size_t end = std::min(begin + grain, n);
+            for (std::size_t i = begin; i < end; ++i) d_first[i] = op(offsets[p - 1], d_first[i]);
+        }
+    });
+    return d_first + n;
+}
+
+template <typename RandomIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt parallel_inclusive_scan(RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op = BinaryOp()) {
+    return parallel_inclusive_scan(thread_pool::instance(), first, last, d_first, std::move(op));
+}
+
+}  // namespace tinystl
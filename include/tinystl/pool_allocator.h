@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Segregated free lists for small blocks. Requests are rounded up to a
+ * multiple of `alignment` and served from the free list of that size class;
+ * empty lists are refilled by carving a slab of blocks out of a large chunk.
+ * Blocks carry no header, so the caller has to pass the same size back on
+ * deallocate. Chunks are only returned to the system when the pool dies.
+ */
+class size_class_pool {
+public:
+    static constexpr std::size_t alignment = 16;
+    static constexpr std::size_t max_block_size = 256;
+    static constexpr std::size_t class_count = max_block_size / alignment;
+    static constexpr std::size_t chunk_size = 64 * 1024;
+    static constexpr std::size_t slab_size = 4 * 1024;
+
+public:
+    size_class_pool() = default;
+    size_class_pool(const size_class_pool &other) = delete;
+    size_class_pool &operator=(const size_class_pool &other) = delete;
+    ~size_class_pool();
+
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept;
+    static constexpr std::size_t block_size(std::size_t cls) noexcept;
+
+    void *allocate(std::size_t bytes);
+    void deallocate(void *p, std::size_t bytes) noexcept;
+
+private:
+    struct free_block {
+        free_block *next;
+    };
+    struct chunk_header {
+        chunk_header *next;
+    };
+    static constexpr std::size_t chunk_header_size = (sizeof(chunk_header) + alignment - 1) / alignment * alignment;
+
+    free_block *refill(std::size_t cls);
+    void new_chunk();
+
+private:
+    std::mutex mutex_;
+    free_block *free_lists_[class_count] {};
+    chunk_header *chunks_ = nullptr;
+    char *chunk_cursor_ = nullptr;
+    char *chunk_end_ = nullptr;
+};
+
+inline size_class_pool::~size_class_pool() {
+    while (this->chunks_ != nullptr) {
+        chunk_header *next = this->chunks_->next;
+        ::operator delete(this->chunks_);
+        this->chunks_ = next;
+    }
+}
+
+constexpr std::size_t size_class_pool::size_class(std::size_t bytes) noexcept {
+    return (bytes + alignment - 1) / alignment - 1;
+}
+
+constexpr std::size_t size_class_pool::block_size(std::size_t cls) noexcept {
+    return (cls + 1) * alignment;
+}
+
+inline void *size_class_pool::allocate(std::size_t bytes) {
+    std::size_t cls = size_class(bytes);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    free_block *block = this->free_lists_[cls];
+    if (block == nullptr) block = refill(cls);
+    this->free_lists_[cls] = block->next;
+    return block;
+}
+
+inline void size_class_pool::deallocate(void *p, std::size_t bytes) noexcept {
+    std::size_t cls = size_class(bytes);
+    free_block *block = static_cast<free_block *>(p);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    block->next = this->free_lists_[cls];
+    this->free_lists_[cls] = block;
+}
+
+/*
+ * Carves up to a slab worth of blocks of class `cls` from the current chunk
+ * and threads them onto its free list. Must be called with the mutex held.
+ */
+inline size_class_pool::free_block *size_class_pool::refill(std::size_t cls) {
+    const std::size_t size = block_size(cls);
+    if (static_cast<std::size_t>(this->chunk_end_ - this->chunk_cursor_) < size) new_chunk();
+    std::size_t count = static_cast<std::size_t>(this->chunk_end_ - this->chunk_cursor_) / size;
+    if (count * size > slab_size) count = slab_size / size;
+
+    free_block *head = nullptr;
+    char *block = this->chunk_cursor_ + count * size;
+    while (block != this->chunk_cursor_) {
+        block -= size;
+        free_block *b = reinterpret_cast<free_block *>(block);
+        b->next = head;
+        head = b;
+    }
+    this->chunk_cursor_ += count * size;
+    this->free_lists_[cls] = head;
+    return head;
+}
+
+inline void size_class_pool::new_chunk() {
+    // hand the tail of the old chunk to the largest class it still fits
+    std::size_t rest = static_cast<std::size_t>(this->chunk_end_ - this->chunk_cursor_);
+    if (rest >= alignment) {
+        std::size_t cls = size_class(rest / alignment * alignment);
+        free_block *b = reinterpret_cast<free_block *>(this->chunk_cursor_);
+        b->next = this->free_lists_[cls];
+        this->free_lists_[cls] = b;
+    }
+    chunk_header *chunk = static_cast<chunk_header *>(::operator new(chunk_size));
+    chunk->next = this->chunks_;
+    this->chunks_ = chunk;
+    this->chunk_cursor_ = reinterpret_cast<char *>(chunk) + chunk_header_size;
+    this->chunk_end_ = reinterpret_cast<char *>(chunk) + chunk_size;
+}
+
+/*
+ * The pool shared by every pool_allocator. It is never destroyed, so objects
+ * with static storage duration may still release blocks during exit.
+ */
+inline size_class_pool &default_size_class_pool() {
+    static size_class_pool *pool = new size_class_pool;
+    return *pool;
+}
+
+template <typename T>
+class pool_allocator {
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = pool_allocator<U>;
+    };
+
+public:
+    pool_allocator() = default;
+    pool_allocator(const pool_allocator &other) = default;
+    pool_allocator(pool_allocator &&other) = default;
+    pool_allocator<T> &operator=(const pool_allocator &other) = default;
+    pool_allocator<T> &operator=(pool_allocator &&other) = default;
+    template <typename U>
+    pool_allocator(const pool_allocator<U> &) noexcept {}
+
+    pointer allocate(size_type n);
+    void deallocate(pointer p, size_type n);
+    template <typename... Args>
+    void construct(pointer p, Args &&...args);
+    void destroy(pointer p);
+    pointer address(reference x) const noexcept;
+    size_type max_size() const noexcept;
+
+private:
+    static bool pooled(size_type n) noexcept;
+};
+
+template <typename T>
+bool pool_allocator<T>::pooled(pool_allocator<T>::size_type n) noexcept {
+    return alignof(T) <= size_class_pool::alignment && n <= size_class_pool::max_block_size / sizeof(T);
+}
+
+template <typename T>
+typename pool_allocator<T>::pointer pool_allocator<T>::allocate(pool_allocator<T>::size_type n) {
+    if (n == 0) return nullptr;
+    if (!pooled(n)) return static_cast<pool_allocator<T>::pointer>(::operator new(n * sizeof(T)));
+    return static_cast<pool_allocator<T>::pointer>(default_size_class_pool().allocate(n * sizeof(T)));
+}
+
+template <typename T>
+void pool_allocator<T>::deallocate(pool_allocator<T>::pointer p, pool_allocator<T>::size_type n) {
+    if (p == nullptr) return;
+    if (!pooled(n)) {
+        ::operator delete(p);
+        return;
+    }
+    default_size_class_pool().deallocate(p, n * sizeof(T));
+}
+
+template <typename T>
+template <typename... Args>
+void pool_allocator<T>::construct(pool_allocator<T>::pointer p, Args &&...args) {
+    new (p) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void pool_allocator<T>::destroy(pool_allocator<T>::pointer p) {
+    p->~T();
+}
+
+template <typename T>
+typename pool_allocator<T>::pointer pool_allocator<T>::address(pool_allocator<T>::reference x) const noexcept {
+    return std::addressof(x);
+}
+
+template <typename T>
+typename pool_allocator<T>::size_type pool_allocator<T>::max_size() const noexcept {
+    return static_cast<pool_allocator<T>::size_type>(-1) / sizeof(T);
+}
+
+template <typename T, typename U>
+bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+    return false;
+}
+
+}  // namespace tinystl
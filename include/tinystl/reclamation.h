@@ -0,0 +1,438 @@
+#pragma once
+
+#include <tinystl/memory.h>
+#include <tinystl/util.h>
+#include <tinystl/vector.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Deferred deletion for lock-free data structures. A writer unlinks a node
+ * and hands it to a domain with retire(p, deleter); the deleter runs once no
+ * reader can still be looking at the node. Readers announce themselves with
+ * a guard of the matching domain:
+ *
+ *   epoch_domain / epoch_guard    readers only publish the epoch they entered
+ *                                 in, which makes guards very cheap, but one
+ *                                 stalled reader holds back every retirement.
+ *   hazard_domain / hazard_guard  readers publish each pointer they use, so a
+ *                                 stalled reader only pins what it protects.
+ *
+ * Retired nodes are collected in batches of reclaim_threshold. Neither domain
+ * frees memory while a guard created before the retirement is alive.
+ */
+struct retired_node {
+    retired_node *next = nullptr;
+    const void *address;
+    std::uint64_t epoch = 0;
+
+    explicit retired_node(const void *p) noexcept : address(p) {}
+    virtual ~retired_node() = default;
+    // runs the deleter and frees the node itself
+    virtual void reclaim() noexcept = 0;
+};
+
+template <typename T, typename D>
+struct retired_object : retired_node {
+    compressed_pair<D, T *> deleter_and_pointer;
+
+    retired_object(T *p, D &&d) : retired_node(p), deleter_and_pointer(std::move(d), p) {}
+    void reclaim() noexcept override {
+        this->deleter_and_pointer.first()(this->deleter_and_pointer.second());
+        delete this;
+    }
+};
+
+// lock-free stack of retired nodes shared by all retiring threads
+class retired_stack {
+public:
+    retired_stack() = default;
+    retired_stack(const retired_stack &other) = delete;
+    retired_stack &operator=(const retired_stack &other) = delete;
+
+    std::size_t push(retired_node *first, retired_node *last, std::size_t n) noexcept;
+    retired_node *take_all() noexcept;
+
+private:
+    std::atomic<retired_node *> head_ {nullptr};
+    std::atomic<std::size_t> size_ {0};
+};
+
+// returns the size of the stack after the push
+inline std::size_t retired_stack::push(retired_node *first, retired_node *last, std::size_t n) noexcept {
+    // counted before linking, so take_all() never subtracts more than was added
+    std::size_t size = this->size_.fetch_add(n, std::memory_order_relaxed) + n;
+    retired_node *head = this->head_.load(std::memory_order_relaxed);
+    do {
+        last->next = head;
+    } while (!this->head_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    return size;
+}
+
+inline retired_node *retired_stack::take_all() noexcept {
+    retired_node *head = this->head_.exchange(nullptr, std::memory_order_acquire);
+    std::size_t n = 0;
+    for (retired_node *node = head; node != nullptr; node = node->next) ++n;
+    this->size_.fetch_sub(n, std::memory_order_relaxed);
+    return head;
+}
+
+class epoch_domain {
+public:
+    static constexpr std::size_t reclaim_threshold = 64;
+
+public:
+    epoch_domain() noexcept;
+    epoch_domain(const epoch_domain &other) = delete;
+    epoch_domain &operator=(const epoch_domain &other) = delete;
+    // frees everything still retired; no guard may be alive
+    ~epoch_domain();
+
+    static epoch_domain &instance();
+
+    template <typename T, typename D = default_deleter<T>>
+    void retire(T *p, D deleter = D());
+    void reclaim();
+    std::uint64_t epoch() const noexcept;
+
+private:
+    struct participant {
+        // (epoch << 1) | 1 while inside a guard, 0 otherwise
+        std::atomic<std::uint64_t> state {0};
+        std::atomic<bool> in_use {true};
+        participant *next = nullptr;
+    };
+
+    participant *enter();
+    void leave(participant *p) noexcept;
+    bool try_advance() noexcept;
+    void collect() noexcept;
+
+private:
+    const std::uint64_t id_;
+    std::atomic<std::uint64_t> epoch_ {0};
+    std::atomic<participant *> participants_ {nullptr};
+    retired_stack retired_;
+
+private:
+    friend class epoch_guard;
+};
+
+class epoch_guard {
+public:
+    explicit epoch_guard(epoch_domain &domain = epoch_domain::instance());
+    epoch_guard(const epoch_guard &other) = delete;
+    epoch_guard &operator=(const epoch_guard &other) = delete;
+    ~epoch_guard();
+
+private:
+    epoch_domain *domain_;
+    epoch_domain::participant *participant_;
+};
+
+class hazard_domain {
+public:
+    static constexpr std::size_t reclaim_threshold = 64;
+
+public:
+    hazard_domain() noexcept;
+    hazard_domain(const hazard_domain &other) = delete;
+    hazard_domain &operator=(const hazard_domain &other) = delete;
+    // frees everything still retired; no guard may be alive
+    ~hazard_domain();
+
+    static hazard_domain &instance();
+
+    template <typename T, typename D = default_deleter<T>>
+    void retire(T *p, D deleter = D());
+    void reclaim();
+
+private:
+    struct hazard_record {
+        std::atomic<const void *> pointer {nullptr};
+        std::atomic<bool> in_use {true};
+        hazard_record *next = nullptr;
+    };
+
+    hazard_record *acquire_record();
+    void release_record(hazard_record *r) noexcept;
+
+private:
+    const std::uint64_t id_;
+    std::atomic<hazard_record *> records_ {nullptr};
+    retired_stack retired_;
+
+private:
+    friend class hazard_guard;
+};
+
+/*
+ * Protects one pointer at a time. protect() returns a pointer read from src
+ * that stays valid until the next protect() or reset() or the end of the
+ * guard. Retire nodes through the same pointer type they are protected with,
+ * since the domain matches them by address.
+ */
+class hazard_guard {
+public:
+    explicit hazard_guard(hazard_domain &domain = hazard_domain::instance());
+    hazard_guard(const hazard_guard &other) = delete;
+    hazard_guard &operator=(const hazard_guard &other) = delete;
+    ~hazard_guard();
+
+    template <typename T>
+    T *protect(const std::atomic<T *> &src) noexcept;
+    void reset() noexcept;
+
+private:
+    hazard_domain *domain_;
+    hazard_domain::hazard_record *record_;
+};
+
+/*
+ * A deleter that retires instead of deleting, so a unique_ptr or shared_ptr
+ * to a shared node can be dropped while readers may still hold the node.
+ */
+template <typename T, typename Domain = epoch_domain, typename D = default_deleter<T>>
+class deferred_deleter {
+public:
+    deferred_deleter() noexcept : domain_(&Domain::instance()), deleter_() {}
+    explicit deferred_deleter(Domain &domain, D deleter = D()) : domain_(&domain), deleter_(std::move(deleter)) {}
+
+    void operator()(T *p) const { this->domain_->retire(p, this->deleter_); }
+
+private:
+    Domain *domain_;
+    D deleter_;
+};
+
+// Participant and hazard records are claimed per guard. A thread remembers
+// the record it used last; the domain id keeps the hint from being followed
+// into a different domain that happens to reuse the address.
+inline std::uint64_t next_reclamation_domain_id() noexcept {
+    static std::atomic<std::uint64_t> next {1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Record>
+Record *claim_record(std::atomic<Record *> &records, std::uint64_t domain_id) {
+    static thread_local std::uint64_t hint_domain = 0;
+    static thread_local Record *hint = nullptr;
+    auto claim = [](Record *r) {
+        return !r->in_use.load(std::memory_order_relaxed) && !r->in_use.exchange(true, std::memory_order_acquire);
+    };
+    if (hint_domain == domain_id && claim(hint)) return hint;
+    Record *r = records.load(std::memory_order_acquire);
+    for (; r != nullptr; r = r->next) {
+        if (claim(r)) break;
+    }
+    if (r == nullptr) {
+        r = new Record;
+        Record *head = records.load(std::memory_order_relaxed);
+        do {
+            r->next = head;
+        } while (!records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+    }
+    hint_domain = domain_id;
+    hint = r;
+    return r;
+}
+
+inline epoch_domain::epoch_domain() noexcept : id_(next_reclamation_domain_id()) {}
+
+inline epoch_domain::~epoch_domain() {
+    retired_node *node = this->retired_.take_all();
+    while (node != nullptr) {
+        retired_node *next = node->next;
+        node->reclaim();
+        node = next;
+    }
+    participant *p = this->participants_.load(std::memory_order_acquire);
+    while (p != nullptr) {
+        participant *next = p->next;
+        delete p;
+        p = next;
+    }
+}
+
+// never destroyed, like the other process-wide pools
+inline epoch_domain &epoch_domain::instance() {
+    static epoch_domain *domain = new epoch_domain;
+    return *domain;
+}
+
+template <typename T, typename D>
+void epoch_domain::retire(T *p, D deleter) {
+    if (p == nullptr) return;
+    retired_node *node = new retired_object<T, D>(p, std::move(deleter));
+    node->epoch = this->epoch_.load(std::memory_order_seq_cst);
+    if (this->retired_.push(node, node, 1) >= reclaim_threshold) reclaim();
+}
+
+/*
+ * A node retired in epoch e can still be seen by a reader that entered in e
+ * or e - 1, so it is freed once the epoch reaches e + 2. The epoch advances
+ * only when every active reader has entered in the current one.
+ */
+inline void epoch_domain::reclaim() {
+    try_advance();
+    try_advance();
+    collect();
+}
+
+inline std::uint64_t epoch_domain::epoch() const noexcept {
+    return this->epoch_.load(std::memory_order_acquire);
+}
+
+inline epoch_domain::participant *epoch_domain::enter() {
+    participant *p = claim_record(this->participants_, this->id_);
+    std::uint64_t e = this->epoch_.load(std::memory_order_seq_cst);
+    p->state.store((e << 1) | 1, std::memory_order_relaxed);
+    // the announcement must be visible before any shared node is read
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return p;
+}
+
+inline void epoch_domain::leave(participant *p) noexcept {
+    p->state.store(0, std::memory_order_release);
+    p->in_use.store(false, std::memory_order_release);
+}
+
+inline bool epoch_domain::try_advance() noexcept {
+    std::uint64_t e = this->epoch_.load(std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (participant *p = this->participants_.load(std::memory_order_acquire); p != nullptr; p = p->next) {
+        std::uint64_t s = p->state.load(std::memory_order_seq_cst);
+        if ((s & 1) != 0 && (s >> 1) != e) return false;
+    }
+    return this->epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+}
+
+inline void epoch_domain::collect() noexcept {
+    retired_node *node = this->retired_.take_all();
+    const std::uint64_t e = this->epoch_.load(std::memory_order_acquire);
+    retired_node *keep = nullptr;
+    retired_node *keep_tail = nullptr;
+    std::size_t kept = 0;
+    while (node != nullptr) {
+        retired_node *next = node->next;
+        if (node->epoch + 2 <= e) {
+            node->reclaim();
+        } else {
+            node->next = keep;
+            if (keep_tail == nullptr) keep_tail = node;
+            keep = node;
+            ++kept;
+        }
+        node = next;
+    }
+    if (keep != nullptr) this->retired_.push(keep, keep_tail, kept);
+}
+
+inline epoch_guard::epoch_guard(epoch_domain &domain)
+    : domain_(&domain), participant_(domain.enter()) {}
+
+inline epoch_guard::~epoch_guard() {
+    this->domain_->leave(this->participant_);
+}
+
+inline hazard_domain::hazard_domain() noexcept : id_(next_reclamation_domain_id()) {}
+
+inline hazard_domain::~hazard_domain() {
+    retired_node *node = this->retired_.take_all();
+    while (node != nullptr) {
+        retired_node *next = node->next;
+        node->reclaim();
+        node = next;
+    }
+    hazard_record *r = this->records_.load(std::memory_order_acquire);
+    while (r != nullptr) {
+        hazard_record *next = r->next;
+        delete r;
+        r = next;
+    }
+}
+
+inline hazard_domain &hazard_domain::instance() {
+    static hazard_domain *domain = new hazard_domain;
+    return *domain;
+}
+
+template <typename T, typename D>
+void hazard_domain::retire(T *p, D deleter) {
+    if (p == nullptr) return;
+    retired_node *node = new retired_object<T, D>(p, std::move(deleter));
+    if (this->retired_.push(node, node, 1) >= reclaim_threshold) reclaim();
+}
+
+// frees every retired node whose address no guard currently protects
+inline void hazard_domain::reclaim() {
+    retired_node *node = this->retired_.take_all();
+    if (node == nullptr) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    vector<const void *> hazards;
+    for (hazard_record *r = this->records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+        const void *p = r->pointer.load(std::memory_order_seq_cst);
+        if (p != nullptr) hazards.push_back(p);
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    retired_node *keep = nullptr;
+    retired_node *keep_tail = nullptr;
+    std::size_t kept = 0;
+    while (node != nullptr) {
+        retired_node *next = node->next;
+        if (!std::binary_search(hazards.begin(), hazards.end(), node->address)) {
+            node->reclaim();
+        } else {
+            node->next = keep;
+            if (keep_tail == nullptr) keep_tail = node;
+            keep = node;
+            ++kept;
+        }
+        node = next;
+    }
+    if (keep != nullptr) this->retired_.push(keep, keep_tail, kept);
+}
+
+inline hazard_domain::hazard_record *hazard_domain::acquire_record() {
+    return claim_record(this->records_, this->id_);
+}
+
+inline void hazard_domain::release_record(hazard_record *r) noexcept {
+    r->pointer.store(nullptr, std::memory_order_release);
+    r->in_use.store(false, std::memory_order_release);
+}
+
+inline hazard_guard::hazard_guard(hazard_domain &domain)
+    : domain_(&domain), record_(domain.acquire_record()) {}
+
+inline hazard_guard::~hazard_guard() {
+    this->domain_->release_record(this->record_);
+}
+
+/*
+ * Publishes the pointer, then reads src again: if it still holds the same
+ * pointer, the node had not been unlinked when the hazard became visible,
+ * so any later reclaim() will see the hazard and keep the node.
+ */
+template <typename T>
+T *hazard_guard::protect(const std::atomic<T *> &src) noexcept {
+    T *p = src.load(std::memory_order_relaxed);
+    for (;;) {
+        this->record_->pointer.store(p, std::memory_order_seq_cst);
+        T *again = src.load(std::memory_order_seq_cst);
+        if (again == p) return p;
+        p = again;
+    }
+}
+
+inline void hazard_guard::reset() noexcept {
+    this->record_->pointer.store(nullptr, std::memory_order_release);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <tinystl/vector.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Key handed out by slot_map: a slot index and the generation the slot had
+ * when the value was inserted, 64 bits in all. A default-constructed key
+ * never refers to a value.
+ */
+class slot_key {
+public:
+    constexpr slot_key() noexcept : index_(0), generation_(0) {}
+    constexpr slot_key(std::uint32_t index, std::uint32_t generation) noexcept : index_(index), generation_(generation) {}
+
+    static constexpr slot_key from_bits(std::uint64_t bits) noexcept;
+    constexpr std::uint64_t bits() const noexcept;
+    constexpr std::uint32_t index() const noexcept;
+    constexpr std::uint32_t generation() const noexcept;
+
+private:
+    std::uint32_t index_;
+    std::uint32_t generation_;
+};
+
+constexpr slot_key slot_key::from_bits(std::uint64_t bits) noexcept {
+    return slot_key(static_cast<std::uint32_t>(bits), static_cast<std::uint32_t>(bits >> 32));
+}
+
+constexpr std::uint64_t slot_key::bits() const noexcept {
+    return static_cast<std::uint64_t>(this->generation_) << 32 | this->index_;
+}
+
+constexpr std::uint32_t slot_key::index() const noexcept {
+    return this->index_;
+}
+
+constexpr std::uint32_t slot_key::generation() const noexcept {
+    return this->generation_;
+}
+
+constexpr bool operator==(const slot_key &lhs, const slot_key &rhs) noexcept {
+    return lhs.bits() == rhs.bits();
+}
+
+constexpr bool operator!=(const slot_key &lhs, const slot_key &rhs) noexcept {
+    return lhs.bits() != rhs.bits();
+}
+
+/*
+ * Values stored densely in one array, addressed through stable keys. A slot
+ * table maps each key's index to the value's position in the array; erasing
+ * moves the last value into the hole (swap-and-pop) and patches its slot, so
+ * iteration always runs over a packed array and every operation is O(1).
+ *
+ * Each slot carries a generation that is odd while the slot is in use and
+ * bumped on every insert and erase, so a key outlives its value as a miss:
+ * find() compares two 32-bit words and returns nullptr. A slot whose
+ * generation would wrap is retired instead of reused, so keys are never
+ * handed out twice.
+ *
+ * Iteration order is not insertion order, and erase moves one other value.
+ * Pointers and iterators into the values are invalidated by insertion and
+ * erase; keys stay valid until their own value is erased.
+ */
+template <typename T, typename Allocator = allocator<T>>
+class slot_map {
+public:
+    using key_type = slot_key;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+private:
+    struct slot {
+        // position in values_ while in use, the next free slot otherwise
+        std::uint32_t index;
+        std::uint32_t generation;
+    };
+
+    using slot_allocator = typename Allocator::template rebind<slot>::other;
+    using index_allocator = typename Allocator::template rebind<std::uint32_t>::other;
+
+    static constexpr std::uint32_t no_slot = static_cast<std::uint32_t>(-1);
+
+public:
+    slot_map() noexcept : values_(), slots_(), owners_(), free_head_(no_slot) {}
+    explicit slot_map(const Allocator &alloc);
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    T *data() noexcept;
+    const T *data() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    size_type capacity() const noexcept;
+    void reserve(size_type n);
+
+    T *find(key_type key) noexcept;
+    const T *find(key_type key) const noexcept;
+    bool contains(key_type key) const noexcept;
+    reference at(key_type key);
+    const_reference at(key_type key) const;
+    reference operator[](key_type key) noexcept;
+    const_reference operator[](key_type key) const noexcept;
+    key_type key_at(size_type pos) const noexcept;
+
+    key_type insert(const T &value);
+    key_type insert(T &&value);
+    template <typename... Args>
+    key_type emplace(Args &&...args);
+    bool erase(key_type key);
+    void clear() noexcept;
+    void swap(slot_map &other) noexcept;
+
+private:
+    const slot *live_slot(key_type key) const noexcept;
+    key_type link_back();
+    void free_slot(std::uint32_t index) noexcept;
+
+private:
+    vector<T, Allocator> values_;
+    vector<slot, slot_allocator> slots_;
+    // the slot each value belongs to, parallel to values_
+    vector<std::uint32_t, index_allocator> owners_;
+    std::uint32_t free_head_;
+};
+
+template <typename T, typename A>
+slot_map<T, A>::slot_map(const A &alloc)
+    : values_(alloc), slots_(slot_allocator(alloc)), owners_(index_allocator(alloc)), free_head_(no_slot) {}
+
+template <typename T, typename A>
+typename slot_map<T, A>::iterator slot_map<T, A>::begin() noexcept {
+    return this->values_.begin();
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::const_iterator slot_map<T, A>::begin() const noexcept {
+    return this->values_.begin();
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::const_iterator slot_map<T, A>::cbegin() const noexcept {
+    return this->values_.cbegin();
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::iterator slot_map<T, A>::end() noexcept {
+    return this->values_.end();
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::const_iterator slot_map<T, A>::end() const noexcept {
+    return this->values_.end();
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::const_iterator slot_map<T, A>::cend() const noexcept {
+    return this->values_.cend();
+}
+
+template <typename T, typename A>
+T *slot_map<T, A>::data() noexcept {
+    return this->values_.data();
+}
+
+template <typename T, typename A>
+const T *slot_map<T, A>::data() const noexcept {
+    return this->values_.data();
+}
+
+template <typename T, typename A>
+bool slot_map<T, A>::empty() const noexcept {
+    return this->values_.empty();
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::size_type slot_map<T, A>::size() const noexcept {
+    return this->values_.size();
+}
+
+// slot indices have to fit in a key, and no_slot marks the end of the free list
+template <typename T, typename A>
+typename slot_map<T, A>::size_type slot_map<T, A>::max_size() const noexcept {
+    return std::min<size_type>(this->values_.max_size(), no_slot);
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::size_type slot_map<T, A>::capacity() const noexcept {
+    return this->values_.capacity();
+}
+
+template <typename T, typename A>
+void slot_map<T, A>::reserve(size_type n) {
+    if (n > max_size()) throw std::length_error("tinystl::slot_map");
+    this->values_.reserve(n);
+    this->slots_.reserve(n);
+    this->owners_.reserve(n);
+}
+
+template <typename T, typename A>
+T *slot_map<T, A>::find(key_type key) noexcept {
+    const slot *s = live_slot(key);
+    return s ? this->values_.data() + s->index : nullptr;
+}
+
+template <typename T, typename A>
+const T *slot_map<T, A>::find(key_type key) const noexcept {
+    const slot *s = live_slot(key);
+    return s ? this->values_.data() + s->index : nullptr;
+}
+
+template <typename T, typename A>
+bool slot_map<T, A>::contains(key_type key) const noexcept {
+    return live_slot(key) != nullptr;
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::reference slot_map<T, A>::at(key_type key) {
+    T *p = find(key);
+    if (!p) throw std::out_of_range("tinystl::slot_map::at");
+    return *p;
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::const_reference slot_map<T, A>::at(key_type key) const {
+    const T *p = find(key);
+    if (!p) throw std::out_of_range("tinystl::slot_map::at");
+    return *p;
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::reference slot_map<T, A>::operator[](key_type key) noexcept {
+    return this->values_[this->slots_[key.index()].index];
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::const_reference slot_map<T, A>::operator[](key_type key) const noexcept {
+    return this->values_[this->slots_[key.index()].index];
+}
+
+// the key of the value at position pos of the dense array
+template <typename T, typename A>
+typename slot_map<T, A>::key_type slot_map<T, A>::key_at(size_type pos) const noexcept {
+    const std::uint32_t index = this->owners_[pos];
+    return key_type(index, this->slots_[index].generation);
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::key_type slot_map<T, A>::insert(const T &value) {
+    return emplace(value);
+}
+
+template <typename T, typename A>
+typename slot_map<T, A>::key_type slot_map<T, A>::insert(T &&value) {
+    return emplace(std::move(value));
+}
+
+/*
+ * The value is built first, so arguments that refer into the map are read
+ * before anything moves; if the bookkeeping that follows fails to allocate,
+ * the value is popped again and the map is left as it was.
+ */
+template <typename T, typename A>
+template <typename... Args>
+typename slot_map<T, A>::key_type slot_map<T, A>::emplace(Args &&...args) {
+    if (size() == max_size()) throw std::length_error("tinystl::slot_map");
+    this->values_.emplace_back(std::forward<Args>(args)...);
+    try {
+        return link_back();
+    } catch (...) {
+        this->values_.pop_back();
+        throw;
+    }
+}
+
+template <typename T, typename A>
+bool slot_map<T, A>::erase(key_type key) {
+    const slot *s = live_slot(key);
+    if (!s) return false;
+    const std::uint32_t pos = s->index;
+    const std::uint32_t last = static_cast<std::uint32_t>(this->values_.size() - 1);
+    if (pos != last) {
+        this->values_[pos] = std::move(this->values_[last]);
+        this->owners_[pos] = this->owners_[last];
+        this->slots_[this->owners_[pos]].index = pos;
+    }
+    this->values_.pop_back();
+    this->owners_.pop_back();
+    free_slot(key.index());
+    return true;
+}
+
+// every key handed out so far becomes stale
+template <typename T, typename A>
+void slot_map<T, A>::clear() noexcept {
+    for (std::uint32_t index : this->owners_) free_slot(index);
+    this->values_.clear();
+    this->owners_.clear();
+}
+
+template <typename T, typename A>
+void slot_map<T, A>::swap(slot_map &other) noexcept {
+    this->values_.swap(other.values_);
+    this->slots_.swap(other.slots_);
+    this->owners_.swap(other.owners_);
+    std::swap(this->free_head_, other.free_head_);
+}
+
+// the slot key refers to, or nullptr if its value has been erased
+template <typename T, typename A>
+const typename slot_map<T, A>::slot *slot_map<T, A>::live_slot(key_type key) const noexcept {
+    if (key.index() >= this->slots_.size()) return nullptr;
+    const slot *s = this->slots_.data() + key.index();
+    return s->generation == key.generation() && (key.generation() & 1) ? s : nullptr;
+}
+
+// gives the value just appended to values_ a slot, reusing a free one if there is one
+template <typename T, typename A>
+typename slot_map<T, A>::key_type slot_map<T, A>::link_back() {
+    const std::uint32_t pos = static_cast<std::uint32_t>(this->values_.size() - 1);
+    this->owners_.reserve(this->values_.capacity());
+    std::uint32_t index = this->free_head_;
+    if (index == no_slot) {
+        if (this->slots_.size() == no_slot) throw std::length_error("tinystl::slot_map");
+        index = static_cast<std::uint32_t>(this->slots_.size());
+        this->slots_.push_back(slot{pos, 0});
+    } else {
+        this->free_head_ = this->slots_[index].index;
+        this->slots_[index].index = pos;
+    }
+    this->owners_.push_back(index);
+    slot &s = this->slots_[index];
+    ++s.generation;
+    return key_type(index, s.generation);
+}
+
+template <typename T, typename A>
+void slot_map<T, A>::free_slot(std::uint32_t index) noexcept {
+    slot &s = this->slots_[index];
+    // a slot that has used up its generations is never handed out again
+    if (++s.generation == 0) return;
+    s.index = this->free_head_;
+    this->free_head_ = index;
+}
+
+template <typename T, typename A>
+void swap(slot_map<T, A> &lhs, slot_map<T, A> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace tinystl
+
+namespace std {
+
+template <>
+struct hash<tinystl::slot_key> {
+    std::size_t operator()(const tinystl::slot_key &key) const noexcept {
+        return std::hash<std::uint64_t>()(key.bits());
+    }
+};
+
+}  // namespace std
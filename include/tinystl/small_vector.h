@@ -0,0 +1,700 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * A vector that keeps up to N elements inside the object and only goes to the
+ * allocator once it outgrows them. Moving a small_vector that has spilled
+ * steals its heap buffer; moving one that is still inline has to move the
+ * elements one by one, so iterators into the source are not carried over.
+ */
+template <typename T, std::size_t N, typename Allocator = allocator<T>>
+class small_vector {
+    static_assert(N > 0, "inline capacity must be at least 1");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity = N;
+
+private:
+    template <typename It>
+    using enable_if_iterator = typename std::enable_if<
+        std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>::type;
+
+public:
+    small_vector() noexcept : small_vector(Allocator()) {}
+    explicit small_vector(const Allocator &alloc) noexcept;
+    explicit small_vector(size_type n, const Allocator &alloc = Allocator());
+    small_vector(size_type n, const T &value, const Allocator &alloc = Allocator());
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    small_vector(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+    small_vector(std::initializer_list<T> il, const Allocator &alloc = Allocator());
+    small_vector(const small_vector &other);
+    small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value);
+    small_vector &operator=(const small_vector &other);
+    small_vector &operator=(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value);
+    small_vector &operator=(std::initializer_list<T> il);
+    ~small_vector();
+
+    void assign(size_type n, const T &value);
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> il);
+    allocator_type get_allocator() const;
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) noexcept;
+    const_reference operator[](size_type pos) const noexcept;
+    reference front() noexcept;
+    const_reference front() const noexcept;
+    reference back() noexcept;
+    const_reference back() const noexcept;
+    T *data() noexcept;
+    const T *data() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void reserve(size_type n);
+    size_type capacity() const noexcept;
+    void shrink_to_fit();
+    bool is_inline() const noexcept;
+
+    void clear() noexcept;
+    iterator insert(const_iterator pos, const T &value);
+    iterator insert(const_iterator pos, T &&value);
+    iterator insert(const_iterator pos, size_type n, const T &value);
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> il);
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    void push_back(const T &value);
+    void push_back(T &&value);
+    template <typename... Args>
+    reference emplace_back(Args &&...args);
+    void pop_back();
+    void resize(size_type n);
+    void resize(size_type n, const T &value);
+    void swap(small_vector &other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+private:
+    T *inline_data() noexcept;
+    void reset_to_inline() noexcept;
+    void take(small_vector &other);
+    size_type next_capacity(size_type required) const;
+    void reallocate(size_type new_cap);
+    template <typename... Args>
+    void realloc_emplace_back(Args &&...args);
+    void rotate_in(size_type offset, size_type old_size);
+    void relocate(T *first, T *last, T *dest);
+    void destroy(T *first, T *last) noexcept;
+    void deallocate_storage() noexcept;
+
+private:
+    T *begin_;
+    T *end_;
+    T *cap_;
+    Allocator alloc_;
+    alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::small_vector(const A &alloc) noexcept
+    : begin_(inline_data()), end_(begin_), cap_(begin_ + N), alloc_(alloc) {}
+
+/*
+ * As in vector, the constructors below delegate to the allocator constructor
+ * and leave the cleanup after a throwing element to the destructor.
+ */
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::small_vector(size_type n, const A &alloc)
+    : small_vector(alloc) {
+    resize(n);
+}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::small_vector(size_type n, const T &value, const A &alloc)
+    : small_vector(alloc) {
+    assign(n, value);
+}
+
+template <typename T, std::size_t N, typename A>
+template <typename InputIt, typename>
+small_vector<T, N, A>::small_vector(InputIt first, InputIt last, const A &alloc)
+    : small_vector(alloc) {
+    assign(first, last);
+}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::small_vector(std::initializer_list<T> il, const A &alloc)
+    : small_vector(il.begin(), il.end(), alloc) {}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::small_vector(const small_vector &other)
+    : small_vector(other.begin(), other.end(), other.alloc_) {}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : small_vector(std::move(other.alloc_)) {
+    take(other);
+}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A> &small_vector<T, N, A>::operator=(const small_vector &other) {
+    if (this != &other) assign(other.begin(), other.end());
+    return *this;
+}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A> &small_vector<T, N, A>::operator=(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+        destroy(this->begin_, this->end_);
+        deallocate_storage();
+        reset_to_inline();
+        this->alloc_ = std::move(other.alloc_);
+        take(other);
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A> &small_vector<T, N, A>::operator=(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+    return *this;
+}
+
+template <typename T, std::size_t N, typename A>
+small_vector<T, N, A>::~small_vector() {
+    destroy(this->begin_, this->end_);
+    deallocate_storage();
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::assign(size_type n, const T &value) {
+    if (n > capacity()) {
+        small_vector tmp(this->alloc_);
+        tmp.reserve(n);
+        tmp.end_ = uninitialized_fill_n(tmp.alloc_, tmp.begin_, n, value);
+        swap(tmp);
+    } else {
+        T copy(value);
+        size_type common = std::min(n, size());
+        std::fill_n(this->begin_, common, copy);
+        if (n < size()) {
+            destroy(this->begin_ + n, this->end_);
+            this->end_ = this->begin_ + n;
+        }
+        if (n > size()) this->end_ = uninitialized_fill_n(this->alloc_, this->end_, n - size(), copy);
+    }
+}
+
+template <typename T, std::size_t N, typename A>
+template <typename InputIt, typename>
+void small_vector<T, N, A>::assign(InputIt first, InputIt last) {
+    clear();
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        reserve(n);
+        this->end_ = uninitialized_copy_n(this->alloc_, first, n, this->begin_);
+    } else {
+        for (; first != last; ++first) emplace_back(*first);
+    }
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::assign(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::allocator_type small_vector<T, N, A>::get_allocator() const {
+    return this->alloc_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::reference small_vector<T, N, A>::at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("tinystl::small_vector::at");
+    return this->begin_[pos];
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reference small_vector<T, N, A>::at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("tinystl::small_vector::at");
+    return this->begin_[pos];
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::reference small_vector<T, N, A>::operator[](size_type pos) noexcept {
+    return this->begin_[pos];
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reference small_vector<T, N, A>::operator[](size_type pos) const noexcept {
+    return this->begin_[pos];
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::reference small_vector<T, N, A>::front() noexcept {
+    return *this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reference small_vector<T, N, A>::front() const noexcept {
+    return *this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::reference small_vector<T, N, A>::back() noexcept {
+    return *(this->end_ - 1);
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reference small_vector<T, N, A>::back() const noexcept {
+    return *(this->end_ - 1);
+}
+
+template <typename T, std::size_t N, typename A>
+T *small_vector<T, N, A>::data() noexcept {
+    return this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+const T *small_vector<T, N, A>::data() const noexcept {
+    return this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::begin() noexcept {
+    return this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_iterator small_vector<T, N, A>::begin() const noexcept {
+    return this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_iterator small_vector<T, N, A>::cbegin() const noexcept {
+    return this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::end() noexcept {
+    return this->end_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_iterator small_vector<T, N, A>::end() const noexcept {
+    return this->end_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_iterator small_vector<T, N, A>::cend() const noexcept {
+    return this->end_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::reverse_iterator small_vector<T, N, A>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reverse_iterator small_vector<T, N, A>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reverse_iterator small_vector<T, N, A>::crbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::reverse_iterator small_vector<T, N, A>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reverse_iterator small_vector<T, N, A>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::const_reverse_iterator small_vector<T, N, A>::crend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, std::size_t N, typename A>
+bool small_vector<T, N, A>::empty() const noexcept {
+    return this->begin_ == this->end_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::size_type small_vector<T, N, A>::size() const noexcept {
+    return static_cast<size_type>(this->end_ - this->begin_);
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::size_type small_vector<T, N, A>::max_size() const noexcept {
+    return this->alloc_.max_size();
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::reserve(size_type n) {
+    if (n > max_size()) throw std::length_error("tinystl::small_vector::reserve");
+    if (n > capacity()) reallocate(n);
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::size_type small_vector<T, N, A>::capacity() const noexcept {
+    return static_cast<size_type>(this->cap_ - this->begin_);
+}
+
+// moves the elements back inside the object when they fit again
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::shrink_to_fit() {
+    if (is_inline() || this->end_ == this->cap_) return;
+    reallocate(size());
+}
+
+template <typename T, std::size_t N, typename A>
+bool small_vector<T, N, A>::is_inline() const noexcept {
+    return this->begin_ == reinterpret_cast<const T *>(this->buffer_);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::clear() noexcept {
+    destroy(this->begin_, this->end_);
+    this->end_ = this->begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+}
+
+/*
+ * The insert overloads append the new elements and rotate them into place.
+ * For the short sequences this container is meant for that costs about the
+ * same as shifting, and it keeps the aliasing and exception cases simple.
+ */
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::insert(const_iterator pos, size_type n, const T &value) {
+    size_type offset = static_cast<size_type>(pos - this->begin_);
+    size_type old_size = size();
+    if (n == 0) return this->begin_ + offset;
+    T copy(value);
+    if (n > static_cast<size_type>(this->cap_ - this->end_)) reallocate(next_capacity(old_size + n));
+    this->end_ = uninitialized_fill_n(this->alloc_, this->end_, n, copy);
+    rotate_in(offset, old_size);
+    return this->begin_ + offset;
+}
+
+template <typename T, std::size_t N, typename A>
+template <typename InputIt, typename>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::insert(const_iterator pos, InputIt first, InputIt last) {
+    size_type offset = static_cast<size_type>(pos - this->begin_);
+    size_type old_size = size();
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        if (n > static_cast<size_type>(this->cap_ - this->end_)) reallocate(next_capacity(old_size + n));
+        this->end_ = uninitialized_copy_n(this->alloc_, first, n, this->end_);
+    } else {
+        try {
+            for (; first != last; ++first) emplace_back(*first);
+        } catch (...) {
+            destroy(this->begin_ + old_size, this->end_);
+            this->end_ = this->begin_ + old_size;
+            throw;
+        }
+    }
+    rotate_in(offset, old_size);
+    return this->begin_ + offset;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::insert(const_iterator pos, std::initializer_list<T> il) {
+    return insert(pos, il.begin(), il.end());
+}
+
+template <typename T, std::size_t N, typename A>
+template <typename... Args>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::emplace(const_iterator pos, Args &&...args) {
+    size_type offset = static_cast<size_type>(pos - this->begin_);
+    size_type old_size = size();
+    emplace_back(std::forward<Args>(args)...);
+    rotate_in(offset, old_size);
+    return this->begin_ + offset;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::iterator small_vector<T, N, A>::erase(const_iterator first, const_iterator last) {
+    T *f = this->begin_ + (first - this->begin_);
+    T *l = this->begin_ + (last - this->begin_);
+    if (f == l) return f;
+    if constexpr (is_trivially_relocatable<T>::value) {
+        destroy(f, l);
+        this->end_ = relocate_n(this->alloc_, l, static_cast<size_type>(this->end_ - l), f);
+    } else {
+        T *new_end = std::move(l, this->end_, f);
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+    return f;
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::push_back(const T &value) {
+    emplace_back(value);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::push_back(T &&value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T, std::size_t N, typename A>
+template <typename... Args>
+typename small_vector<T, N, A>::reference small_vector<T, N, A>::emplace_back(Args &&...args) {
+    if (this->end_ != this->cap_) {
+        this->alloc_.construct(this->end_, std::forward<Args>(args)...);
+        ++this->end_;
+    } else {
+        realloc_emplace_back(std::forward<Args>(args)...);
+    }
+    return back();
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::pop_back() {
+    --this->end_;
+    this->alloc_.destroy(this->end_);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::resize(size_type n) {
+    if (n > size()) {
+        if (n > capacity()) reallocate(next_capacity(n));
+        this->end_ = uninitialized_value_construct_n(this->alloc_, this->end_, n - size());
+    } else {
+        T *new_end = this->begin_ + n;
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::resize(size_type n, const T &value) {
+    if (n > size()) {
+        insert(cend(), n - size(), value);
+    } else {
+        T *new_end = this->begin_ + n;
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::swap(small_vector &other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (!is_inline() && !other.is_inline()) {
+        std::swap(this->begin_, other.begin_);
+        std::swap(this->end_, other.end_);
+        std::swap(this->cap_, other.cap_);
+        std::swap(this->alloc_, other.alloc_);
+        return;
+    }
+    small_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+}
+
+template <typename T, std::size_t N, typename A>
+T *small_vector<T, N, A>::inline_data() noexcept {
+    return reinterpret_cast<T *>(this->buffer_);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::reset_to_inline() noexcept {
+    this->begin_ = this->end_ = inline_data();
+    this->cap_ = this->begin_ + N;
+}
+
+/*
+ * Takes over the contents of other, which is left empty and inline. *this
+ * must hold no elements and no heap buffer.
+ */
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::take(small_vector &other) {
+    if (!other.is_inline()) {
+        this->begin_ = other.begin_;
+        this->end_ = other.end_;
+        this->cap_ = other.cap_;
+        other.reset_to_inline();
+        return;
+    }
+    size_type n = other.size();
+    relocate(other.begin_, other.end_, this->begin_);
+    this->end_ = this->begin_ + n;
+    other.end_ = other.begin_;
+}
+
+template <typename T, std::size_t N, typename A>
+typename small_vector<T, N, A>::size_type small_vector<T, N, A>::next_capacity(size_type required) const {
+    const size_type max = max_size();
+    if (required > max) throw std::length_error("tinystl::small_vector");
+    size_type cap = capacity();
+    size_type grown = (cap / 2 > max - cap) ? max : cap + cap / 2;
+    return std::max(required, grown);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::reallocate(size_type new_cap) {
+    T *new_begin = (new_cap <= N) ? inline_data() : this->alloc_.allocate(new_cap);
+    if (new_cap <= N) new_cap = N;
+    try {
+        relocate(this->begin_, this->end_, new_begin);
+    } catch (...) {
+        if (new_begin != inline_data()) this->alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    size_type n = size();
+    deallocate_storage();
+    this->begin_ = new_begin;
+    this->end_ = new_begin + n;
+    this->cap_ = new_begin + new_cap;
+}
+
+template <typename T, std::size_t N, typename A>
+template <typename... Args>
+void small_vector<T, N, A>::realloc_emplace_back(Args &&...args) {
+    size_type n = size();
+    size_type new_cap = next_capacity(n + 1);
+    T *new_begin = this->alloc_.allocate(new_cap);
+    // the new element goes first: its source may alias an element of *this
+    try {
+        this->alloc_.construct(new_begin + n, std::forward<Args>(args)...);
+    } catch (...) {
+        this->alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    try {
+        relocate(this->begin_, this->end_, new_begin);
+    } catch (...) {
+        this->alloc_.destroy(new_begin + n);
+        this->alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    deallocate_storage();
+    this->begin_ = new_begin;
+    this->end_ = new_begin + n + 1;
+    this->cap_ = new_begin + new_cap;
+}
+
+// moves the elements appended after old_size in front of position offset
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::rotate_in(size_type offset, size_type old_size) {
+    std::rotate(this->begin_ + offset, this->begin_ + old_size, this->end_);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::relocate(T *first, T *last, T *dest) {
+    relocate_n(this->alloc_, first, static_cast<size_type>(last - first), dest);
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::destroy(T *first, T *last) noexcept {
+    destroy_n(this->alloc_, first, static_cast<size_type>(last - first));
+}
+
+template <typename T, std::size_t N, typename A>
+void small_vector<T, N, A>::deallocate_storage() noexcept {
+    if (!is_inline()) {
+        this->alloc_.deallocate(this->begin_, capacity());
+    }
+}
+
+template <typename T, std::size_t N, typename A>
+bool operator==(const small_vector<T, N, A> &lhs, const small_vector<T, N, A> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, std::size_t N, typename A>
+bool operator!=(const small_vector<T, N, A> &lhs, const small_vector<T, N, A> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, std::size_t N, typename A>
+bool operator<(const small_vector<T, N, A> &lhs, const small_vector<T, N, A> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, std::size_t N, typename A>
+bool operator>(const small_vector<T, N, A> &lhs, const small_vector<T, N, A> &rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, std::size_t N, typename A>
+bool operator<=(const small_vector<T, N, A> &lhs, const small_vector<T, N, A> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, std::size_t N, typename A>
+bool operator>=(const small_vector<T, N, A> &lhs, const small_vector<T, N, A> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, std::size_t N, typename A>
+void swap(small_vector<T, N, A> &lhs, small_vector<T, N, A> &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+}  // namespace tinystl
@@ -0,0 +1,814 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl {
+
+// a contiguous run of one field, for loops over a single column
+template <typename T>
+class column_span {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = std::size_t;
+    using iterator = T *;
+
+public:
+    column_span() noexcept : data_(nullptr), size_(0) {}
+    column_span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+    T *data() const noexcept;
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+    T &operator[](size_type pos) const noexcept;
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+private:
+    T *data_;
+    size_type size_;
+};
+
+template <typename T>
+T *column_span<T>::data() const noexcept {
+    return this->data_;
+}
+
+template <typename T>
+typename column_span<T>::size_type column_span<T>::size() const noexcept {
+    return this->size_;
+}
+
+template <typename T>
+bool column_span<T>::empty() const noexcept {
+    return this->size_ == 0;
+}
+
+template <typename T>
+T &column_span<T>::operator[](size_type pos) const noexcept {
+    return this->data_[pos];
+}
+
+template <typename T>
+typename column_span<T>::iterator column_span<T>::begin() const noexcept {
+    return this->data_;
+}
+
+template <typename T>
+typename column_span<T>::iterator column_span<T>::end() const noexcept {
+    return this->data_ + this->size_;
+}
+
+/*
+ * Proxy for one row of a soa_vector, holding a pointer into every column.
+ * get<I>() reaches a field, and structured bindings name them:
+ *
+ *     auto [id, score] = v[i];   // references into the columns
+ *
+ * Assigning to a row assigns the fields, it does not rebind the proxy.
+ * Ts are the field types, const-qualified for rows of a const vector.
+ */
+template <typename... Ts>
+class soa_row {
+public:
+    using value_type = std::tuple<typename std::remove_const<Ts>::type...>;
+
+public:
+    explicit soa_row(const std::tuple<Ts *...> &fields) noexcept : fields_(fields) {}
+    soa_row(const soa_row &other) = default;
+    const soa_row &operator=(const soa_row &other) const;
+    template <typename... Us>
+    const soa_row &operator=(const soa_row<Us...> &other) const;
+    const soa_row &operator=(const value_type &values) const;
+    operator value_type() const;
+
+    template <std::size_t I>
+    typename std::tuple_element<I, std::tuple<Ts...>>::type &get() const noexcept;
+
+private:
+    template <typename Row, std::size_t... Is>
+    void assign(const Row &other, std::index_sequence<Is...>) const;
+    template <std::size_t... Is>
+    value_type load(std::index_sequence<Is...>) const;
+
+private:
+    std::tuple<Ts *...> fields_;
+};
+
+template <typename... Ts>
+const soa_row<Ts...> &soa_row<Ts...>::operator=(const soa_row &other) const {
+    assign(other, std::index_sequence_for<Ts...>());
+    return *this;
+}
+
+template <typename... Ts>
+template <typename... Us>
+const soa_row<Ts...> &soa_row<Ts...>::operator=(const soa_row<Us...> &other) const {
+    assign(other, std::index_sequence_for<Ts...>());
+    return *this;
+}
+
+template <typename... Ts>
+const soa_row<Ts...> &soa_row<Ts...>::operator=(const value_type &values) const {
+    assign(values, std::index_sequence_for<Ts...>());
+    return *this;
+}
+
+template <typename... Ts>
+soa_row<Ts...>::operator value_type() const {
+    return load(std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts>
+template <std::size_t I>
+typename std::tuple_element<I, std::tuple<Ts...>>::type &soa_row<Ts...>::get() const noexcept {
+    return *std::get<I>(this->fields_);
+}
+
+template <typename... Ts>
+template <typename Row, std::size_t... Is>
+void soa_row<Ts...>::assign(const Row &other, std::index_sequence<Is...>) const {
+    using std::get;
+    ((*std::get<Is>(this->fields_) = get<Is>(other)), ...);
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+typename soa_row<Ts...>::value_type soa_row<Ts...>::load(std::index_sequence<Is...>) const {
+    return value_type(*std::get<Is>(this->fields_)...);
+}
+
+template <std::size_t I, typename... Ts>
+typename std::tuple_element<I, std::tuple<Ts...>>::type &get(const soa_row<Ts...> &row) noexcept {
+    return row.template get<I>();
+}
+
+// random access over rows; dereferencing yields a soa_row
+template <typename... Ts>
+class soa_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename soa_row<Ts...>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = soa_row<Ts...>;
+    using pointer = void;
+
+public:
+    soa_iterator() noexcept : columns_(), pos_(0) {}
+    soa_iterator(const std::tuple<Ts *...> &columns, difference_type pos) noexcept : columns_(columns), pos_(pos) {}
+
+    reference operator*() const noexcept;
+    reference operator[](difference_type n) const noexcept;
+    soa_iterator &operator++() noexcept;
+    soa_iterator operator++(int) noexcept;
+    soa_iterator &operator--() noexcept;
+    soa_iterator operator--(int) noexcept;
+    soa_iterator &operator+=(difference_type n) noexcept;
+    soa_iterator &operator-=(difference_type n) noexcept;
+    soa_iterator operator+(difference_type n) const noexcept;
+    soa_iterator operator-(difference_type n) const noexcept;
+    difference_type operator-(const soa_iterator &other) const noexcept;
+
+    bool operator==(const soa_iterator &other) const noexcept;
+    bool operator!=(const soa_iterator &other) const noexcept;
+    bool operator<(const soa_iterator &other) const noexcept;
+    bool operator>(const soa_iterator &other) const noexcept;
+    bool operator<=(const soa_iterator &other) const noexcept;
+    bool operator>=(const soa_iterator &other) const noexcept;
+
+private:
+    template <std::size_t... Is>
+    reference row(difference_type pos, std::index_sequence<Is...>) const noexcept;
+
+private:
+    std::tuple<Ts *...> columns_;
+    difference_type pos_;
+};
+
+template <typename... Ts>
+typename soa_iterator<Ts...>::reference soa_iterator<Ts...>::operator*() const noexcept {
+    return row(this->pos_, std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts>
+typename soa_iterator<Ts...>::reference soa_iterator<Ts...>::operator[](difference_type n) const noexcept {
+    return row(this->pos_ + n, std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> &soa_iterator<Ts...>::operator++() noexcept {
+    ++this->pos_;
+    return *this;
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> soa_iterator<Ts...>::operator++(int) noexcept {
+    soa_iterator tmp = *this;
+    ++this->pos_;
+    return tmp;
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> &soa_iterator<Ts...>::operator--() noexcept {
+    --this->pos_;
+    return *this;
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> soa_iterator<Ts...>::operator--(int) noexcept {
+    soa_iterator tmp = *this;
+    --this->pos_;
+    return tmp;
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> &soa_iterator<Ts...>::operator+=(difference_type n) noexcept {
+    this->pos_ += n;
+    return *this;
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> &soa_iterator<Ts...>::operator-=(difference_type n) noexcept {
+    this->pos_ -= n;
+    return *this;
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> soa_iterator<Ts...>::operator+(difference_type n) const noexcept {
+    return soa_iterator(this->columns_, this->pos_ + n);
+}
+
+template <typename... Ts>
+soa_iterator<Ts...> soa_iterator<Ts...>::operator-(difference_type n) const noexcept {
+    return soa_iterator(this->columns_, this->pos_ - n);
+}
+
+template <typename... Ts>
+typename soa_iterator<Ts...>::difference_type soa_iterator<Ts...>::operator-(const soa_iterator &other) const noexcept {
+    return this->pos_ - other.pos_;
+}
+
+template <typename... Ts>
+bool soa_iterator<Ts...>::operator==(const soa_iterator &other) const noexcept {
+    return this->pos_ == other.pos_;
+}
+
+template <typename... Ts>
+bool soa_iterator<Ts...>::operator!=(const soa_iterator &other) const noexcept {
+    return this->pos_ != other.pos_;
+}
+
+template <typename... Ts>
+bool soa_iterator<Ts...>::operator<(const soa_iterator &other) const noexcept {
+    return this->pos_ < other.pos_;
+}
+
+template <typename... Ts>
+bool soa_iterator<Ts...>::operator>(const soa_iterator &other) const noexcept {
+    return this->pos_ > other.pos_;
+}
+
+template <typename... Ts>
+bool soa_iterator<Ts...>::operator<=(const soa_iterator &other) const noexcept {
+    return this->pos_ <= other.pos_;
+}
+
+template <typename... Ts>
+bool soa_iterator<Ts...>::operator>=(const soa_iterator &other) const noexcept {
+    return this->pos_ >= other.pos_;
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+typename soa_iterator<Ts...>::reference soa_iterator<Ts...>::row(difference_type pos, std::index_sequence<Is...>) const noexcept {
+    return reference(std::tuple<Ts *...>((std::get<Is>(this->columns_) + pos)...));
+}
+
+/*
+ * Structure-of-arrays vector: each field lives in its own array, so a loop
+ * over a few fields of many rows only pulls those fields through the cache.
+ * Rows are reached through soa_row proxies and whole fields through
+ * column<I>(), which is what a vectorizing loop wants.
+ *
+ * All columns share one size and one capacity and grow together: new
+ * arrays are allocated for every column before any element moves, and
+ * elements are copied rather than moved when moving could throw, so a
+ * failed growth leaves the vector as it was.
+ */
+template <typename... Fields>
+class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = soa_row<Fields...>;
+    using const_reference = soa_row<const Fields...>;
+    using iterator = soa_iterator<Fields...>;
+    using const_iterator = soa_iterator<const Fields...>;
+
+    template <std::size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+
+    static constexpr std::size_t field_count = sizeof...(Fields);
+
+public:
+    soa_vector() noexcept : columns_(), size_(0), cap_(0) {}
+    explicit soa_vector(size_type n);
+    soa_vector(const soa_vector &other);
+    soa_vector(soa_vector &&other) noexcept;
+    soa_vector &operator=(const soa_vector &other);
+    soa_vector &operator=(soa_vector &&other) noexcept;
+    ~soa_vector();
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) noexcept;
+    const_reference operator[](size_type pos) const noexcept;
+    reference front() noexcept;
+    const_reference front() const noexcept;
+    reference back() noexcept;
+    const_reference back() const noexcept;
+    template <std::size_t I>
+    column_span<field_type<I>> column() noexcept;
+    template <std::size_t I>
+    column_span<const field_type<I>> column() const noexcept;
+    template <std::size_t I>
+    field_type<I> *data() noexcept;
+    template <std::size_t I>
+    const field_type<I> *data() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void reserve(size_type n);
+    size_type capacity() const noexcept;
+    void shrink_to_fit();
+
+    void clear() noexcept;
+    void push_back(const value_type &row);
+    void push_back(value_type &&row);
+    template <typename... Args>
+    reference emplace_back(Args &&...args);
+    void pop_back() noexcept;
+    void resize(size_type n);
+    void swap(soa_vector &other) noexcept;
+
+private:
+    using columns = std::tuple<Fields *...>;
+    using indices = std::index_sequence_for<Fields...>;
+
+    template <typename F, std::size_t... Is>
+    static void for_each_index(F &&f, std::index_sequence<Is...>);
+    template <typename Row, std::size_t... Is>
+    Row row_at(size_type pos, std::index_sequence<Is...>) const noexcept;
+    template <typename Tuple, std::size_t... Is>
+    void construct_row(size_type pos, Tuple &&args, std::index_sequence<Is...>);
+    size_type next_capacity(size_type required) const;
+    void reallocate(size_type new_cap);
+    void destroy_rows(size_type first, size_type last) noexcept;
+    static void deallocate_columns(const columns &cols, size_type cap) noexcept;
+
+private:
+    columns columns_;
+    size_type size_;
+    size_type cap_;
+};
+
+template <typename... Fields>
+soa_vector<Fields...>::soa_vector(size_type n) : soa_vector() {
+    resize(n);
+}
+
+template <typename... Fields>
+soa_vector<Fields...>::soa_vector(const soa_vector &other) : soa_vector() {
+    reserve(other.size_);
+    std::size_t copied = 0;
+    try {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            uninitialized_copy_n(alloc, std::get<I>(other.columns_), other.size_, std::get<I>(this->columns_));
+            ++copied;
+        }, indices());
+    } catch (...) {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            if (I < copied) destroy_n(alloc, std::get<I>(this->columns_), other.size_);
+        }, indices());
+        throw;
+    }
+    this->size_ = other.size_;
+}
+
+template <typename... Fields>
+soa_vector<Fields...>::soa_vector(soa_vector &&other) noexcept
+    : columns_(other.columns_), size_(other.size_), cap_(other.cap_) {
+    other.columns_ = columns();
+    other.size_ = other.cap_ = 0;
+}
+
+template <typename... Fields>
+soa_vector<Fields...> &soa_vector<Fields...>::operator=(const soa_vector &other) {
+    if (this != &other) {
+        soa_vector tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+soa_vector<Fields...> &soa_vector<Fields...>::operator=(soa_vector &&other) noexcept {
+    soa_vector tmp(std::move(other));
+    swap(tmp);
+    return *this;
+}
+
+template <typename... Fields>
+soa_vector<Fields...>::~soa_vector() {
+    destroy_rows(0, this->size_);
+    deallocate_columns(this->columns_, this->cap_);
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::reference soa_vector<Fields...>::at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("tinystl::soa_vector::at");
+    return row_at<reference>(pos, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_reference soa_vector<Fields...>::at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("tinystl::soa_vector::at");
+    return row_at<const_reference>(pos, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::reference soa_vector<Fields...>::operator[](size_type pos) noexcept {
+    return row_at<reference>(pos, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_reference soa_vector<Fields...>::operator[](size_type pos) const noexcept {
+    return row_at<const_reference>(pos, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::reference soa_vector<Fields...>::front() noexcept {
+    return row_at<reference>(0, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_reference soa_vector<Fields...>::front() const noexcept {
+    return row_at<const_reference>(0, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::reference soa_vector<Fields...>::back() noexcept {
+    return row_at<reference>(this->size_ - 1, indices());
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_reference soa_vector<Fields...>::back() const noexcept {
+    return row_at<const_reference>(this->size_ - 1, indices());
+}
+
+template <typename... Fields>
+template <std::size_t I>
+column_span<typename soa_vector<Fields...>::template field_type<I>> soa_vector<Fields...>::column() noexcept {
+    return column_span<field_type<I>>(std::get<I>(this->columns_), this->size_);
+}
+
+template <typename... Fields>
+template <std::size_t I>
+column_span<const typename soa_vector<Fields...>::template field_type<I>> soa_vector<Fields...>::column() const noexcept {
+    return column_span<const field_type<I>>(std::get<I>(this->columns_), this->size_);
+}
+
+template <typename... Fields>
+template <std::size_t I>
+typename soa_vector<Fields...>::template field_type<I> *soa_vector<Fields...>::data() noexcept {
+    return std::get<I>(this->columns_);
+}
+
+template <typename... Fields>
+template <std::size_t I>
+const typename soa_vector<Fields...>::template field_type<I> *soa_vector<Fields...>::data() const noexcept {
+    return std::get<I>(this->columns_);
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::iterator soa_vector<Fields...>::begin() noexcept {
+    return iterator(this->columns_, 0);
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_iterator soa_vector<Fields...>::begin() const noexcept {
+    return const_iterator(std::tuple<const Fields *...>(this->columns_), 0);
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_iterator soa_vector<Fields...>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::iterator soa_vector<Fields...>::end() noexcept {
+    return iterator(this->columns_, static_cast<difference_type>(this->size_));
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_iterator soa_vector<Fields...>::end() const noexcept {
+    return const_iterator(std::tuple<const Fields *...>(this->columns_), static_cast<difference_type>(this->size_));
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::const_iterator soa_vector<Fields...>::cend() const noexcept {
+    return end();
+}
+
+template <typename... Fields>
+bool soa_vector<Fields...>::empty() const noexcept {
+    return this->size_ == 0;
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::size_type soa_vector<Fields...>::size() const noexcept {
+    return this->size_;
+}
+
+// bounded by the widest field, whose column is the largest allocation
+template <typename... Fields>
+typename soa_vector<Fields...>::size_type soa_vector<Fields...>::max_size() const noexcept {
+    constexpr size_type widest = std::max({sizeof(Fields)...});
+    return static_cast<size_type>(-1) / widest;
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::reserve(size_type n) {
+    if (n > max_size()) throw std::length_error("tinystl::soa_vector");
+    if (n > capacity()) reallocate(n);
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::size_type soa_vector<Fields...>::capacity() const noexcept {
+    return this->cap_;
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::shrink_to_fit() {
+    if (this->size_ == this->cap_) return;
+    if (this->size_ == 0) {
+        deallocate_columns(this->columns_, this->cap_);
+        this->columns_ = columns();
+        this->cap_ = 0;
+        return;
+    }
+    reallocate(this->size_);
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::clear() noexcept {
+    destroy_rows(0, this->size_);
+    this->size_ = 0;
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::push_back(const value_type &row) {
+    if (this->size_ == this->cap_) {
+        // row may be a copy of one of our rows; it is read before anything moves
+        value_type tmp(row);
+        reallocate(next_capacity(this->size_ + 1));
+        construct_row(this->size_, std::move(tmp), indices());
+    } else {
+        construct_row(this->size_, row, indices());
+    }
+    ++this->size_;
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::push_back(value_type &&row) {
+    if (this->size_ == this->cap_) reallocate(next_capacity(this->size_ + 1));
+    construct_row(this->size_, std::move(row), indices());
+    ++this->size_;
+}
+
+// one argument per field, each constructing its field
+template <typename... Fields>
+template <typename... Args>
+typename soa_vector<Fields...>::reference soa_vector<Fields...>::emplace_back(Args &&...args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back takes one argument per field");
+    if (this->size_ == this->cap_) {
+        // args may refer to fields that move with the columns
+        value_type tmp(std::forward<Args>(args)...);
+        reallocate(next_capacity(this->size_ + 1));
+        construct_row(this->size_, std::move(tmp), indices());
+    } else {
+        construct_row(this->size_, std::forward_as_tuple(std::forward<Args>(args)...), indices());
+    }
+    ++this->size_;
+    return back();
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::pop_back() noexcept {
+    --this->size_;
+    destroy_rows(this->size_, this->size_ + 1);
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::resize(size_type n) {
+    if (n <= this->size_) {
+        destroy_rows(n, this->size_);
+        this->size_ = n;
+        return;
+    }
+    if (n > this->cap_) reallocate(next_capacity(n));
+    size_type built = 0;
+    try {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            uninitialized_value_construct_n(alloc, std::get<I>(this->columns_) + this->size_, n - this->size_);
+            ++built;
+        }, indices());
+    } catch (...) {
+        // the columns before the one that threw are already built
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            if (I < built) destroy_n(alloc, std::get<I>(this->columns_) + this->size_, n - this->size_);
+        }, indices());
+        throw;
+    }
+    this->size_ = n;
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::swap(soa_vector &other) noexcept {
+    std::swap(this->columns_, other.columns_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->cap_, other.cap_);
+}
+
+template <typename... Fields>
+template <typename F, std::size_t... Is>
+void soa_vector<Fields...>::for_each_index(F &&f, std::index_sequence<Is...>) {
+    (f(std::integral_constant<std::size_t, Is>()), ...);
+}
+
+template <typename... Fields>
+template <typename Row, std::size_t... Is>
+Row soa_vector<Fields...>::row_at(size_type pos, std::index_sequence<Is...>) const noexcept {
+    return Row(std::make_tuple((std::get<Is>(this->columns_) + pos)...));
+}
+
+/*
+ * Builds field I of row pos from element I of args. If a field constructor
+ * throws, the fields already built for this row are destroyed.
+ */
+template <typename... Fields>
+template <typename Tuple, std::size_t... Is>
+void soa_vector<Fields...>::construct_row(size_type pos, Tuple &&args, std::index_sequence<Is...>) {
+    std::size_t built = 0;
+    try {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            alloc.construct(std::get<I>(this->columns_) + pos, std::get<I>(std::forward<Tuple>(args)));
+            ++built;
+        }, indices());
+    } catch (...) {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            if (I < built) alloc.destroy(std::get<I>(this->columns_) + pos);
+        }, indices());
+        throw;
+    }
+}
+
+template <typename... Fields>
+typename soa_vector<Fields...>::size_type soa_vector<Fields...>::next_capacity(size_type required) const {
+    const size_type max = max_size();
+    if (required > max) throw std::length_error("tinystl::soa_vector");
+    if (this->cap_ == 0) return std::max<size_type>(required, 16);
+    size_type grown = (this->cap_ > max - this->cap_ / 2) ? max : this->cap_ + this->cap_ / 2;
+    return std::max(required, grown);
+}
+
+/*
+ * Allocates every new column before touching the old ones, then copies the
+ * columns whose move may throw. Only once every copy has succeeded are the
+ * other columns moved over, or relocated as bytes, in a pass that cannot
+ * throw, so until then the old columns are intact.
+ */
+template <typename... Fields>
+void soa_vector<Fields...>::reallocate(size_type new_cap) {
+    columns fresh;
+    std::size_t allocated = 0;
+    try {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            std::get<I>(fresh) = alloc.allocate(new_cap);
+            ++allocated;
+        }, indices());
+    } catch (...) {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            allocator<field_type<I>> alloc;
+            if (I < allocated) alloc.deallocate(std::get<I>(fresh), new_cap);
+        }, indices());
+        throw;
+    }
+
+    std::size_t copied = 0;
+    try {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            using field = field_type<I>;
+            allocator<field> alloc;
+            if constexpr (!is_trivially_relocatable<field>::value && !std::is_nothrow_move_constructible<field>::value) {
+                uninitialized_copy_n(alloc, std::get<I>(this->columns_), this->size_, std::get<I>(fresh));
+            }
+            ++copied;
+        }, indices());
+    } catch (...) {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            using field = field_type<I>;
+            allocator<field> alloc;
+            if constexpr (!is_trivially_relocatable<field>::value && !std::is_nothrow_move_constructible<field>::value) {
+                if (I < copied) destroy_n(alloc, std::get<I>(fresh), this->size_);
+            }
+        }, indices());
+        deallocate_columns(fresh, new_cap);
+        throw;
+    }
+
+    for_each_index([&](auto i) {
+        constexpr std::size_t I = decltype(i)::value;
+        using field = field_type<I>;
+        allocator<field> alloc;
+        if constexpr (is_trivially_relocatable<field>::value) {
+            relocate_n(alloc, std::get<I>(this->columns_), this->size_, std::get<I>(fresh));
+        } else if constexpr (std::is_nothrow_move_constructible<field>::value) {
+            uninitialized_move_n(alloc, std::get<I>(this->columns_), this->size_, std::get<I>(fresh));
+            destroy_n(alloc, std::get<I>(this->columns_), this->size_);
+        } else {
+            destroy_n(alloc, std::get<I>(this->columns_), this->size_);
+        }
+    }, indices());
+    deallocate_columns(this->columns_, this->cap_);
+    this->columns_ = fresh;
+    this->cap_ = new_cap;
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::destroy_rows(size_type first, size_type last) noexcept {
+    for_each_index([&](auto i) {
+        constexpr std::size_t I = decltype(i)::value;
+        allocator<field_type<I>> alloc;
+        destroy_n(alloc, std::get<I>(this->columns_) + first, last - first);
+    }, indices());
+}
+
+template <typename... Fields>
+void soa_vector<Fields...>::deallocate_columns(const columns &cols, size_type cap) noexcept {
+    if (cap == 0) return;
+    for_each_index([&](auto i) {
+        constexpr std::size_t I = decltype(i)::value;
+        allocator<field_type<I>> alloc;
+        alloc.deallocate(std::get<I>(cols), cap);
+    }, indices());
+}
+
+}  // namespace tinystl
+
+namespace std {
+
+template <typename... Ts>
+struct tuple_size<tinystl::soa_row<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct tuple_element<I, tinystl::soa_row<Ts...>> {
+    using type = typename std::tuple_element<I, std::tuple<Ts...>>::type &;
+};
+
+}  // namespace std
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <tinystl/pool_allocator.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace tinystl {
+
+class thread_cache;
+
+/*
+ * Shared back end of the per-thread caches. Memory is carved from spans of
+ * span_size bytes, aligned to their own size, that each hold blocks of a
+ * single size class. The header at the start of a span names the cache that
+ * carved it, which is how a block freed on another thread finds its owner.
+ * Spans are never returned to the system.
+ */
+class central_pool {
+public:
+    static constexpr std::size_t span_size = 64 * 1024;
+    static constexpr std::size_t class_count = size_class_pool::class_count;
+
+    struct free_block {
+        free_block *next;
+    };
+    struct span_header {
+        thread_cache *owner;
+        std::size_t size_class;
+    };
+
+public:
+    static central_pool &instance();
+    static span_header *span_of(void *p) noexcept;
+
+    std::size_t take(std::size_t cls, std::size_t max, thread_cache *owner, free_block *&head);
+    void give_back(std::size_t cls, free_block *head, free_block *tail) noexcept;
+    void *allocate(std::size_t cls);
+    void deallocate(void *p, std::size_t cls) noexcept;
+    thread_cache *acquire_cache();
+    void retire_cache(thread_cache *cache) noexcept;
+
+private:
+    static constexpr std::size_t span_header_size = (sizeof(span_header) + size_class_pool::alignment - 1) / size_class_pool::alignment * size_class_pool::alignment;
+
+    central_pool() = default;
+    void collect_orphans(std::size_t cls) noexcept;
+    void carve_span(std::size_t cls, thread_cache *owner);
+    void push(std::size_t cls, free_block *head, free_block *tail) noexcept;
+
+private:
+    std::mutex mutex_;
+    free_block *free_lists_[class_count] {};
+    thread_cache *orphans_ = nullptr;
+};
+
+/*
+ * Per-thread front end. Each size class keeps a magazine of free blocks that
+ * is used without any synchronization, refilled from and spilled back to the
+ * central pool a batch at a time. Blocks freed by a thread that does not own
+ * their span are pushed onto the owner's lock-free remote free list, which
+ * the owner drains when its magazine runs dry.
+ *
+ * Caches are never deleted: when a thread exits its cache hands its blocks to
+ * the central pool and is parked for the next new thread, so remote frees
+ * that arrive late still land somewhere valid.
+ */
+class thread_cache {
+public:
+    static constexpr std::size_t magazine_capacity = 64;
+    static constexpr std::size_t batch_size = magazine_capacity / 2;
+    static constexpr std::size_t class_count = central_pool::class_count;
+
+public:
+    thread_cache(const thread_cache &other) = delete;
+    thread_cache &operator=(const thread_cache &other) = delete;
+
+    // nullptr once the calling thread has started tearing down its cache
+    static thread_cache *current();
+
+    void *allocate(std::size_t cls);
+    void deallocate(void *p, std::size_t cls) noexcept;
+
+private:
+    using free_block = central_pool::free_block;
+
+    struct magazine {
+        free_block *head = nullptr;
+        std::size_t count = 0;
+    };
+
+    thread_cache() = default;
+    void push_remote(free_block *block, std::size_t cls) noexcept;
+    free_block *take_remote(std::size_t cls) noexcept;
+    void drain_remote(std::size_t cls) noexcept;
+
+private:
+    magazine magazines_[class_count];
+    thread_cache *next_orphan_ = nullptr;
+    // written by other threads, kept off the magazines' cache lines
+    alignas(64) std::atomic<free_block *> remote_frees_[class_count] {};
+
+private:
+    friend class central_pool;
+};
+
+inline central_pool &central_pool::instance() {
+    static central_pool *pool = new central_pool;
+    return *pool;
+}
+
+inline central_pool::span_header *central_pool::span_of(void *p) noexcept {
+    return reinterpret_cast<span_header *>(reinterpret_cast<std::uintptr_t>(p) & ~static_cast<std::uintptr_t>(span_size - 1));
+}
+
+/*
+ * Moves up to max blocks of class cls into a list starting at head and
+ * returns how many were moved. A new span is carved, on behalf of owner, only
+ * when neither the central lists nor orphaned caches have anything left.
+ */
+inline std::size_t central_pool::take(std::size_t cls, std::size_t max, thread_cache *owner, free_block *&head) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (this->free_lists_[cls] == nullptr) collect_orphans(cls);
+    if (this->free_lists_[cls] == nullptr) carve_span(cls, owner);
+
+    std::size_t n = 0;
+    free_block *first = this->free_lists_[cls];
+    free_block *last = nullptr;
+    free_block *cur = first;
+    while (cur != nullptr && n < max) {
+        last = cur;
+        cur = cur->next;
+        ++n;
+    }
+    last->next = head;
+    head = first;
+    this->free_lists_[cls] = cur;
+    return n;
+}
+
+inline void central_pool::give_back(std::size_t cls, free_block *head, free_block *tail) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    push(cls, head, tail);
+}
+
+inline void *central_pool::allocate(std::size_t cls) {
+    free_block *head = nullptr;
+    take(cls, 1, nullptr, head);
+    return head;
+}
+
+inline void central_pool::deallocate(void *p, std::size_t cls) noexcept {
+    free_block *block = static_cast<free_block *>(p);
+    give_back(cls, block, block);
+}
+
+inline thread_cache *central_pool::acquire_cache() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->orphans_ != nullptr) {
+            thread_cache *cache = this->orphans_;
+            this->orphans_ = cache->next_orphan_;
+            cache->next_orphan_ = nullptr;
+            return cache;
+        }
+    }
+    return new thread_cache;
+}
+
+inline void central_pool::retire_cache(thread_cache *cache) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    for (std::size_t cls = 0; cls < class_count; ++cls) {
+        thread_cache::magazine &m = cache->magazines_[cls];
+        for (free_block *b = m.head; b != nullptr;) {
+            free_block *next = b->next;
+            push(cls, b, b);
+            b = next;
+        }
+        m.head = nullptr;
+        m.count = 0;
+    }
+    cache->next_orphan_ = this->orphans_;
+    this->orphans_ = cache;
+    for (std::size_t cls = 0; cls < class_count; ++cls) collect_orphans(cls);
+}
+
+// Must be called with the mutex held.
+inline void central_pool::collect_orphans(std::size_t cls) noexcept {
+    for (thread_cache *cache = this->orphans_; cache != nullptr; cache = cache->next_orphan_) {
+        for (free_block *b = cache->take_remote(cls); b != nullptr;) {
+            free_block *next = b->next;
+            push(cls, b, b);
+            b = next;
+        }
+    }
+}
+
+// Must be called with the mutex held.
+inline void central_pool::carve_span(std::size_t cls, thread_cache *owner) {
+    const std::size_t size = size_class_pool::block_size(cls);
+    void *memory = ::operator new(span_size, std::align_val_t(span_size));
+    span_header *span = static_cast<span_header *>(memory);
+    span->owner = owner;
+    span->size_class = cls;
+
+    char *first = static_cast<char *>(memory) + span_header_size;
+    std::size_t count = (span_size - span_header_size) / size;
+    free_block *head = nullptr;
+    for (std::size_t i = count; i > 0; --i) {
+        free_block *b = reinterpret_cast<free_block *>(first + (i - 1) * size);
+        b->next = head;
+        head = b;
+    }
+    push(cls, head, reinterpret_cast<free_block *>(first + (count - 1) * size));
+}
+
+// Must be called with the mutex held.
+inline void central_pool::push(std::size_t cls, free_block *head, free_block *tail) noexcept {
+    tail->next = this->free_lists_[cls];
+    this->free_lists_[cls] = head;
+}
+
+inline thread_cache *thread_cache::current() {
+    struct holder {
+        thread_cache **slot;
+        bool *torn_down;
+        ~holder() {
+            central_pool::instance().retire_cache(*this->slot);
+            *this->slot = nullptr;
+            *this->torn_down = true;
+        }
+    };
+    // trivially destructible, so still safe to read after holder is gone
+    static thread_local thread_cache *cache = nullptr;
+    static thread_local bool torn_down = false;
+    if (cache != nullptr) return cache;
+    if (torn_down) return nullptr;
+    cache = central_pool::instance().acquire_cache();
+    static thread_local holder h{&cache, &torn_down};
+    return cache;
+}
+
+inline void *thread_cache::allocate(std::size_t cls) {
+    magazine &m = this->magazines_[cls];
+    if (m.head == nullptr) {
+        drain_remote(cls);
+        if (m.head == nullptr) {
+            m.count = central_pool::instance().take(cls, batch_size, this, m.head);
+        }
+    }
+    free_block *block = m.head;
+    m.head = block->next;
+    --m.count;
+    return block;
+}
+
+inline void thread_cache::deallocate(void *p, std::size_t cls) noexcept {
+    free_block *block = static_cast<free_block *>(p);
+    thread_cache *owner = central_pool::span_of(p)->owner;
+    if (owner != this && owner != nullptr) {
+        owner->push_remote(block, cls);
+        return;
+    }
+    magazine &m = this->magazines_[cls];
+    block->next = m.head;
+    m.head = block;
+    if (++m.count <= magazine_capacity) return;
+
+    // spill the oldest half back to the central pool
+    free_block *keep_tail = m.head;
+    for (std::size_t i = 1; i < magazine_capacity - batch_size; ++i) keep_tail = keep_tail->next;
+    free_block *spill = keep_tail->next;
+    free_block *spill_tail = spill;
+    std::size_t spilled = 1;
+    while (spill_tail->next != nullptr) {
+        spill_tail = spill_tail->next;
+        ++spilled;
+    }
+    keep_tail->next = nullptr;
+    m.count -= spilled;
+    central_pool::instance().give_back(cls, spill, spill_tail);
+}
+
+inline void thread_cache::push_remote(free_block *block, std::size_t cls) noexcept {
+    free_block *head = this->remote_frees_[cls].load(std::memory_order_relaxed);
+    do {
+        block->next = head;
+    } while (!this->remote_frees_[cls].compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Takes the whole list at once, so the usual ABA problem of popping from a
+// lock-free stack cannot occur.
+inline thread_cache::free_block *thread_cache::take_remote(std::size_t cls) noexcept {
+    if (this->remote_frees_[cls].load(std::memory_order_relaxed) == nullptr) return nullptr;
+    return this->remote_frees_[cls].exchange(nullptr, std::memory_order_acquire);
+}
+
+inline void thread_cache::drain_remote(std::size_t cls) noexcept {
+    free_block *list = take_remote(cls);
+    magazine &m = this->magazines_[cls];
+    while (list != nullptr) {
+        free_block *next = list->next;
+        list->next = m.head;
+        m.head = list;
+        ++m.count;
+        list = next;
+    }
+}
+
+/*
+ * Same interface as tinystl::allocator; small requests go through the
+ * calling thread's cache, everything else through ::operator new.
+ */
+template <typename T>
+class thread_cache_allocator {
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = thread_cache_allocator<U>;
+    };
+
+public:
+    thread_cache_allocator() = default;
+    thread_cache_allocator(const thread_cache_allocator &other) = default;
+    thread_cache_allocator(thread_cache_allocator &&other) = default;
+    thread_cache_allocator<T> &operator=(const thread_cache_allocator &other) = default;
+    thread_cache_allocator<T> &operator=(thread_cache_allocator &&other) = default;
+    template <typename U>
+    thread_cache_allocator(const thread_cache_allocator<U> &) noexcept {}
+
+    pointer allocate(size_type n);
+    void deallocate(pointer p, size_type n);
+    template <typename... Args>
+    void construct(pointer p, Args &&...args);
+    void destroy(pointer p);
+    pointer address(reference x) const noexcept;
+    size_type max_size() const noexcept;
+
+private:
+    static bool pooled(size_type n) noexcept;
+};
+
+template <typename T>
+bool thread_cache_allocator<T>::pooled(thread_cache_allocator<T>::size_type n) noexcept {
+    return alignof(T) <= size_class_pool::alignment && n <= size_class_pool::max_block_size / sizeof(T);
+}
+
+template <typename T>
+typename thread_cache_allocator<T>::pointer thread_cache_allocator<T>::allocate(thread_cache_allocator<T>::size_type n) {
+    if (n == 0) return nullptr;
+    if (!pooled(n)) return static_cast<thread_cache_allocator<T>::pointer>(::operator new(n * sizeof(T)));
+    std::size_t cls = size_class_pool::size_class(n * sizeof(T));
+    thread_cache *cache = thread_cache::current();
+    void *p = (cache != nullptr) ? cache->allocate(cls) : central_pool::instance().allocate(cls);
+    return static_cast<thread_cache_allocator<T>::pointer>(p);
+}
+
+template <typename T>
+void thread_cache_allocator<T>::deallocate(thread_cache_allocator<T>::pointer p, thread_cache_allocator<T>::size_type n) {
+    if (p == nullptr) return;
+    if (!pooled(n)) {
+        ::operator delete(p);
+        return;
+    }
+    std::size_t cls = size_class_pool::size_class(n * sizeof(T));
+    thread_cache *cache = thread_cache::current();
+    if (cache != nullptr) {
+        cache->deallocate(p, cls);
+    } else {
+        central_pool::instance().deallocate(p, cls);
+    }
+}
+
+template <typename T>
+template <typename... Args>
+void thread_cache_allocator<T>::construct(thread_cache_allocator<T>::pointer p, Args &&...args) {
+    new (p) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void thread_cache_allocator<T>::destroy(thread_cache_allocator<T>::pointer p) {
+    p->~T();
+}
+
+template <typename T>
+typename thread_cache_allocator<T>::pointer thread_cache_allocator<T>::address(thread_cache_allocator<T>::reference x) const noexcept {
+    return std::addressof(x);
+}
+
+template <typename T>
+typename thread_cache_allocator<T>::size_type thread_cache_allocator<T>::max_size() const noexcept {
+    return static_cast<thread_cache_allocator<T>::size_type>(-1) / sizeof(T);
+}
+
+template <typename T, typename U>
+bool operator==(const thread_cache_allocator<T> &, const thread_cache_allocator<U> &) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const thread_cache_allocator<T> &, const thread_cache_allocator<U> &) noexcept {
+    return false;
+}
+
+}  // namespace tinystl
@@ -0,0 +1,545 @@
+#pragma once
+
+#include <tinystl/allocator.h>
+#include <tinystl/thread_cache.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl {
+
+/*
+ * Chase-Lev work-stealing deque, with the memory orderings of Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models". The owning
+ * thread pushes and pops at the bottom without contention; other threads
+ * steal from the top, and only a steal racing the owner for the last element
+ * costs a CAS. The ring grows on demand; outgrown rings are kept until the
+ * deque is destroyed because a thief may still be reading from one.
+ */
+template <typename T>
+class work_stealing_deque {
+    static_assert(std::is_trivially_copyable<T>::value, "work_stealing_deque holds trivially copyable values");
+
+public:
+    explicit work_stealing_deque(std::size_t capacity = 256);
+    work_stealing_deque(const work_stealing_deque &other) = delete;
+    work_stealing_deque &operator=(const work_stealing_deque &other) = delete;
+    ~work_stealing_deque();
+
+    void push(T value);
+    bool pop(T &value) noexcept;
+    bool steal(T &value) noexcept;
+    std::size_t size_approx() const noexcept;
+    bool empty_approx() const noexcept;
+
+private:
+    struct ring {
+        std::int64_t mask;
+        std::atomic<T> *items;
+        ring *prev;
+
+        T get(std::int64_t i) const noexcept { return this->items[i & this->mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T value) noexcept { this->items[i & this->mask].store(value, std::memory_order_relaxed); }
+    };
+
+    static ring *make_ring(std::size_t capacity, ring *prev);
+    ring *grow(ring *r, std::int64_t top, std::int64_t bottom);
+
+private:
+    alignas(64) std::atomic<std::int64_t> top_;
+    alignas(64) std::atomic<std::int64_t> bottom_;
+    std::atomic<ring *> ring_;
+};
+
+template <typename T>
+work_stealing_deque<T>::work_stealing_deque(std::size_t capacity) : top_(0), bottom_(0), ring_(nullptr) {
+    std::size_t cap = 2;
+    while (cap < capacity) cap *= 2;
+    this->ring_.store(make_ring(cap, nullptr), std::memory_order_relaxed);
+}
+
+template <typename T>
+work_stealing_deque<T>::~work_stealing_deque() {
+    allocator<std::atomic<T>> alloc;
+    for (ring *r = this->ring_.load(std::memory_order_relaxed); r != nullptr;) {
+        ring *prev = r->prev;
+        alloc.deallocate(r->items, static_cast<std::size_t>(r->mask + 1));
+        delete r;
+        r = prev;
+    }
+}
+
+// owner only
+template <typename T>
+void work_stealing_deque<T>::push(T value) {
+    std::int64_t b = this->bottom_.load(std::memory_order_relaxed);
+    std::int64_t t = this->top_.load(std::memory_order_acquire);
+    ring *r = this->ring_.load(std::memory_order_relaxed);
+    if (b - t > r->mask) r = grow(r, t, b);
+    r->put(b, value);
+    this->bottom_.store(b + 1, std::memory_order_release);
+}
+
+// owner only, newest first
+template <typename T>
+bool work_stealing_deque<T>::pop(T &value) noexcept {
+    std::int64_t b = this->bottom_.load(std::memory_order_relaxed) - 1;
+    ring *r = this->ring_.load(std::memory_order_relaxed);
+    this->bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = this->top_.load(std::memory_order_relaxed);
+    if (t > b) {
+        this->bottom_.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    value = r->get(b);
+    if (t == b) {
+        // the last element: race thieves for it through top
+        bool won = this->top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        this->bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+// any thread, oldest first; fails on an empty deque or a lost race
+template <typename T>
+bool work_stealing_deque<T>::steal(T &value) noexcept {
+    std::int64_t t = this->top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = this->bottom_.load(std::memory_order_acquire);
+    if (t >= b) return false;
+    ring *r = this->ring_.load(std::memory_order_acquire);
+    value = r->get(t);
+    return this->top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+template <typename T>
+std::size_t work_stealing_deque<T>::size_approx() const noexcept {
+    std::int64_t b = this->bottom_.load(std::memory_order_relaxed);
+    std::int64_t t = this->top_.load(std::memory_order_relaxed);
+    return (b > t) ? static_cast<std::size_t>(b - t) : 0;
+}
+
+template <typename T>
+bool work_stealing_deque<T>::empty_approx() const noexcept {
+    return size_approx() == 0;
+}
+
+template <typename T>
+typename work_stealing_deque<T>::ring *work_stealing_deque<T>::make_ring(std::size_t capacity, ring *prev) {
+    allocator<std::atomic<T>> alloc;
+    std::atomic<T> *items = alloc.allocate(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) alloc.construct(items + i);
+    try {
+        return new ring{static_cast<std::int64_t>(capacity) - 1, items, prev};
+    } catch (...) {
+        alloc.deallocate(items, capacity);
+        throw;
+    }
+}
+
+template <typename T>
+typename work_stealing_deque<T>::ring *work_stealing_deque<T>::grow(ring *r, std::int64_t top, std::int64_t bottom) {
+    ring *bigger = make_ring(static_cast<std::size_t>(r->mask + 1) * 2, r);
+    for (std::int64_t i = top; i < bottom; ++i) bigger->put(i, r->get(i));
+    this->ring_.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+/*
+ * Unit of work in a thread_pool. execute() runs the task and frees it; tasks
+ * are allocated from the thread caches since they usually die on another
+ * thread than the one that made them. An exception escaping a task passed to
+ * thread_pool::submit() terminates; task_group collects them instead.
+ */
+class pool_task {
+public:
+    virtual void execute() noexcept = 0;
+
+protected:
+    ~pool_task() = default;
+
+private:
+    pool_task *next_ = nullptr;
+
+private:
+    friend class thread_pool;
+};
+
+template <typename F>
+class function_task final : public pool_task {
+public:
+    static function_task *create(F f);
+
+    void execute() noexcept override;
+
+private:
+    explicit function_task(F &&f) : f_(std::move(f)) {}
+
+private:
+    F f_;
+};
+
+template <typename F>
+function_task<F> *function_task<F>::create(F f) {
+    thread_cache_allocator<function_task> alloc;
+    function_task *task = alloc.allocate(1);
+    try {
+        ::new (static_cast<void *>(task)) function_task(std::move(f));
+    } catch (...) {
+        alloc.deallocate(task, 1);
+        throw;
+    }
+    return task;
+}
+
+template <typename F>
+void function_task<F>::execute() noexcept {
+    struct cleanup {
+        function_task *task;
+        ~cleanup() {
+            thread_cache_allocator<function_task> alloc;
+            alloc.destroy(this->task);
+            alloc.deallocate(this->task, 1);
+        }
+    } guard{this};
+    this->f_();
+}
+
+/*
+ * Fixed set of worker threads, each owning a work_stealing_deque. Tasks
+ * spawned on a worker go to its own deque, where it runs them newest first;
+ * tasks from other threads go through a shared injection list. An idle
+ * worker steals from a random victim and sleeps once nothing is left
+ * anywhere. Threads waiting on a task_group run pending tasks meanwhile, so
+ * nested parallelism cannot deadlock the pool.
+ *
+ * Destroying a pool runs every task already queued before joining.
+ */
+class thread_pool {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    explicit thread_pool(std::size_t threads = default_thread_count());
+    thread_pool(const thread_pool &other) = delete;
+    thread_pool &operator=(const thread_pool &other) = delete;
+    ~thread_pool();
+
+    static thread_pool &instance();
+    static std::size_t default_thread_count() noexcept;
+
+    std::size_t size() const noexcept;
+    // index of the calling thread among this pool's workers, or npos
+    std::size_t current_worker() const noexcept;
+    template <typename F>
+    void submit(F f);
+    void spawn(pool_task *task);
+    bool run_pending_task();
+
+private:
+    struct worker {
+        work_stealing_deque<pool_task *> tasks;
+        std::thread thread;
+    };
+    struct worker_context {
+        const thread_pool *pool;
+        std::size_t index;
+        std::uint64_t rng;
+    };
+
+    static worker_context &context() noexcept;
+    void worker_loop(std::size_t index);
+    pool_task *find_task(std::size_t self) noexcept;
+    pool_task *pop_injected() noexcept;
+    void notify() noexcept;
+
+private:
+    worker *workers_;
+    std::size_t size_;
+
+    std::mutex inject_mutex_;
+    pool_task *inject_head_ = nullptr;
+    pool_task *inject_tail_ = nullptr;
+    std::atomic<std::size_t> injected_{0};
+
+    // sleeping workers wait for epoch_ to move; spawners bump it only when
+    // someone is asleep
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<std::size_t> sleepers_{0};
+    std::uint64_t epoch_ = 0;
+    bool stop_ = false;
+};
+
+inline thread_pool::thread_pool(std::size_t threads) : workers_(nullptr), size_(threads == 0 ? 1 : threads) {
+    this->workers_ = new worker[this->size_];
+    std::size_t started = 0;
+    try {
+        for (; started < this->size_; ++started) this->workers_[started].thread = std::thread([this, started] { worker_loop(started); });
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex_);
+            this->stop_ = true;
+        }
+        this->sleep_cv_.notify_all();
+        for (std::size_t i = 0; i < started; ++i) this->workers_[i].thread.join();
+        delete[] this->workers_;
+        throw;
+    }
+}
+
+inline thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex_);
+        this->stop_ = true;
+        ++this->epoch_;
+    }
+    this->sleep_cv_.notify_all();
+    for (std::size_t i = 0; i < this->size_; ++i) this->workers_[i].thread.join();
+    delete[] this->workers_;
+}
+
+inline thread_pool &thread_pool::instance() {
+    static thread_pool *pool = new thread_pool;
+    return *pool;
+}
+
+inline std::size_t thread_pool::default_thread_count() noexcept {
+    std::size_t n = std::thread::hardware_concurrency();
+    return (n == 0) ? 1 : n;
+}
+
+inline std::size_t thread_pool::size() const noexcept {
+    return this->size_;
+}
+
+inline std::size_t thread_pool::current_worker() const noexcept {
+    const worker_context &ctx = context();
+    return (ctx.pool == this) ? ctx.index : npos;
+}
+
+template <typename F>
+void thread_pool::submit(F f) {
+    function_task<F> *task = function_task<F>::create(std::move(f));
+    try {
+        spawn(task);
+    } catch (...) {
+        thread_cache_allocator<function_task<F>> alloc;
+        alloc.destroy(task);
+        alloc.deallocate(task, 1);
+        throw;
+    }
+}
+
+// if the task cannot be queued, spawn throws and the task stays with the caller
+inline void thread_pool::spawn(pool_task *task) {
+    std::size_t self = current_worker();
+    if (self != npos) {
+        this->workers_[self].tasks.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(this->inject_mutex_);
+        if (this->inject_tail_ == nullptr) {
+            this->inject_head_ = task;
+        } else {
+            this->inject_tail_->next_ = task;
+        }
+        this->inject_tail_ = task;
+        this->injected_.fetch_add(1, std::memory_order_relaxed);
+    }
+    notify();
+}
+
+// runs one queued task on the calling thread, if there is one
+inline bool thread_pool::run_pending_task() {
+    pool_task *task = find_task(current_worker());
+    if (task == nullptr) return false;
+    task->execute();
+    return true;
+}
+
+inline thread_pool::worker_context &thread_pool::context() noexcept {
+    static thread_local worker_context ctx{nullptr, npos, 0};
+    return ctx;
+}
+
+inline void thread_pool::worker_loop(std::size_t index) {
+    worker_context &ctx = context();
+    ctx.pool = this;
+    ctx.index = index;
+    ctx.rng = 0x9e3779b97f4a7c15ull * (index + 1);
+    for (;;) {
+        if (pool_task *task = find_task(index)) {
+            task->execute();
+            continue;
+        }
+        std::uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex_);
+            if (this->stop_) break;
+            epoch = this->epoch_;
+        }
+        // announce the nap before the last look, so a spawner that misses
+        // the task in our scan sees us asleep and bumps the epoch
+        this->sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        pool_task *task = find_task(index);
+        if (task == nullptr) {
+            std::unique_lock<std::mutex> lock(this->sleep_mutex_);
+            this->sleep_cv_.wait(lock, [&] { return this->epoch_ != epoch || this->stop_; });
+        }
+        this->sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        if (task != nullptr) task->execute();
+    }
+}
+
+inline pool_task *thread_pool::find_task(std::size_t self) noexcept {
+    pool_task *task = nullptr;
+    if (self != npos && this->workers_[self].tasks.pop(task)) return task;
+    if ((task = pop_injected()) != nullptr) return task;
+
+    worker_context &ctx = context();
+    // xorshift64, seeded lazily on threads that are not workers
+    if (ctx.rng == 0) ctx.rng = reinterpret_cast<std::uintptr_t>(&ctx) | 1;
+    ctx.rng ^= ctx.rng << 13;
+    ctx.rng ^= ctx.rng >> 7;
+    ctx.rng ^= ctx.rng << 17;
+    std::size_t start = static_cast<std::size_t>(ctx.rng % this->size_);
+    for (std::size_t i = 0; i < this->size_; ++i) {
+        std::size_t victim = (start + i) % this->size_;
+        if (victim != self && this->workers_[victim].tasks.steal(task)) return task;
+    }
+    return nullptr;
+}
+
+inline pool_task *thread_pool::pop_injected() noexcept {
+    if (this->injected_.load(std::memory_order_relaxed) == 0) return nullptr;
+    std::lock_guard<std::mutex> lock(this->inject_mutex_);
+    pool_task *task = this->inject_head_;
+    if (task == nullptr) return nullptr;
+    this->inject_head_ = task->next_;
+    if (this->inject_head_ == nullptr) this->inject_tail_ = nullptr;
+    this->injected_.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+inline void thread_pool::notify() noexcept {
+    // pairs with the seq_cst increment of sleepers_ in worker_loop
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->sleepers_.load(std::memory_order_relaxed) == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex_);
+        ++this->epoch_;
+    }
+    this->sleep_cv_.notify_one();
+}
+
+/*
+ * Fork-join scope over a thread_pool. wait() returns once every task run()
+ * through the group has finished, running pending tasks of the pool in the
+ * meantime, and rethrows the first exception a task threw. The destructor
+ * waits as well but drops exceptions.
+ */
+class task_group {
+public:
+    explicit task_group(thread_pool &pool = thread_pool::instance()) noexcept : pool_(pool), pending_(0) {}
+    task_group(const task_group &other) = delete;
+    task_group &operator=(const task_group &other) = delete;
+    ~task_group();
+
+    template <typename F>
+    void run(F f);
+    void wait();
+    thread_pool &pool() const noexcept { return this->pool_; }
+
+private:
+    template <typename F>
+    class group_task;
+
+    void wait_idle() noexcept;
+    void fail(std::exception_ptr error) noexcept;
+
+private:
+    thread_pool &pool_;
+    std::atomic<std::size_t> pending_;
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+};
+
+// frees itself before reporting to the group, which may be gone right after
+template <typename F>
+class task_group::group_task final : public pool_task {
+public:
+    group_task(task_group *group, F &&f) : group_(group), f_(std::move(f)) {}
+
+    void execute() noexcept override {
+        task_group *group = this->group_;
+        try {
+            this->f_();
+        } catch (...) {
+            group->fail(std::current_exception());
+        }
+        thread_cache_allocator<group_task> alloc;
+        alloc.destroy(this);
+        alloc.deallocate(this, 1);
+        group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+
+private:
+    task_group *group_;
+    F f_;
+};
+
+inline task_group::~task_group() {
+    wait_idle();
+}
+
+template <typename F>
+void task_group::run(F f) {
+    thread_cache_allocator<group_task<F>> alloc;
+    group_task<F> *task = alloc.allocate(1);
+    try {
+        ::new (static_cast<void *>(task)) group_task<F>(this, std::move(f));
+    } catch (...) {
+        alloc.deallocate(task, 1);
+        throw;
+    }
+    // counted before it is queued, since a worker may finish it right away
+    this->pending_.fetch_add(1, std::memory_order_relaxed);
+    try {
+        this->pool_.spawn(task);
+    } catch (...) {
+        alloc.destroy(task);
+        alloc.deallocate(task, 1);
+        this->pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+inline void task_group::wait() {
+    wait_idle();
+    if (this->failed_.load(std::memory_order_relaxed)) {
+        std::exception_ptr error = std::move(this->error_);
+        this->error_ = nullptr;
+        this->failed_.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(error);
+    }
+}
+
+inline void task_group::wait_idle() noexcept {
+    while (this->pending_.load(std::memory_order_acquire) != 0) {
+        if (!this->pool_.run_pending_task()) std::this_thread::yield();
+    }
+}
+
+inline void task_group::fail(std::exception_ptr error) noexcept {
+    if (!this->failed_.exchange(true, std::memory_order_relaxed)) this->error_ = std::move(error);
+}
+
+}  // namespace tinystl
@@ -11,4 +11,69 @@ typename std::remove_reference<T>::type &&move(T &&value) noexcept {
     return static_cast<typename std::remove_reference<T>::type &&>(value);
 }
 
+/*
+ * True for types whose objects can be moved to a new address by copying
+ * their bytes and forgetting the original, with no move constructor and no
+ * destructor run. That covers every trivially copyable type, and also types
+ * that own a resource through a pointer that nothing else refers back to,
+ * such as unique_ptr or shared_ptr. Types holding a pointer into themselves
+ * (small_vector with its inline buffer, libstdc++'s std::string) are not.
+ *
+ * Other types opt in by specializing the trait, or with
+ * TINYSTL_TRIVIALLY_RELOCATABLE at global scope for a non-template class.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : std::integral_constant<bool, is_trivially_relocatable<typename std::remove_const<T1>::type>::value &&
+                                       is_trivially_relocatable<typename std::remove_const<T2>::type>::value> {};
+
+#define TINYSTL_TRIVIALLY_RELOCATABLE(...)                                 \
+    namespace tinystl {                                                    \
+    template <>                                                            \
+    struct is_trivially_relocatable<__VA_ARGS__> : std::true_type {};      \
+    }
+
+/*
+ * A pair that takes no space for an empty first member: T1 becomes a private
+ * base instead of a field, so the empty base optimization applies.
+ */
+template <typename T1, typename T2, bool = std::is_empty<T1>::value && !std::is_final<T1>::value>
+class compressed_pair;
+
+template <typename T1, typename T2>
+class compressed_pair<T1, T2, true> : private T1 {
+public:
+    compressed_pair() : T1(), second_() {}
+    template <typename U1, typename U2>
+    compressed_pair(U1 &&first, U2 &&second) : T1(std::forward<U1>(first)), second_(std::forward<U2>(second)) {}
+
+    T1 &first() noexcept { return *this; }
+    const T1 &first() const noexcept { return *this; }
+    T2 &second() noexcept { return this->second_; }
+    const T2 &second() const noexcept { return this->second_; }
+
+private:
+    T2 second_;
+};
+
+template <typename T1, typename T2>
+class compressed_pair<T1, T2, false> {
+public:
+    compressed_pair() : first_(), second_() {}
+    template <typename U1, typename U2>
+    compressed_pair(U1 &&first, U2 &&second) : first_(std::forward<U1>(first)), second_(std::forward<U2>(second)) {}
+
+    T1 &first() noexcept { return this->first_; }
+    const T1 &first() const noexcept { return this->first_; }
+    T2 &second() noexcept { return this->second_; }
+    const T2 &second() const noexcept { return this->second_; }
+
+private:
+    T1 first_;
+    T2 second_;
+};
+
 }  // namespace tinystl
@@ -1,10 +1,739 @@
 #pragma once
 
-#include <memory>
+#include <tinystl/allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <ratio>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace tinystl {
-    template <typename T, typename Allocator = std::allocator<T>>
-    class vector {
 
-    };
-}
\ No newline at end of file
+/*
+ * GrowthFactor is the ratio the capacity is multiplied by when the vector runs
+ * out of room. The default of 1.5 (rather than 2) lets a freed buffer be
+ * reused by a later, larger request from the same allocator, since the sum of
+ * all previous buffers eventually exceeds the next one.
+ */
+template <typename T, typename Allocator = allocator<T>, typename GrowthFactor = std::ratio<3, 2>>
+class vector {
+    static_assert(GrowthFactor::num > GrowthFactor::den, "growth factor must be greater than 1");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using growth_factor = GrowthFactor;
+
+private:
+    template <typename It>
+    using enable_if_iterator = typename std::enable_if<
+        std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>::type;
+
+public:
+    vector() noexcept : begin_(nullptr), end_(nullptr), cap_(nullptr), alloc_() {}
+    explicit vector(const Allocator &alloc) noexcept;
+    explicit vector(size_type n, const Allocator &alloc = Allocator());
+    vector(size_type n, const T &value, const Allocator &alloc = Allocator());
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    vector(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+    vector(std::initializer_list<T> il, const Allocator &alloc = Allocator());
+    vector(const vector &other);
+    vector(vector &&other) noexcept;
+    vector &operator=(const vector &other);
+    vector &operator=(vector &&other) noexcept;
+    vector &operator=(std::initializer_list<T> il);
+    ~vector();
+
+    void assign(size_type n, const T &value);
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> il);
+    allocator_type get_allocator() const;
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) noexcept;
+    const_reference operator[](size_type pos) const noexcept;
+    reference front() noexcept;
+    const_reference front() const noexcept;
+    reference back() noexcept;
+    const_reference back() const noexcept;
+    T *data() noexcept;
+    const T *data() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void reserve(size_type n);
+    size_type capacity() const noexcept;
+    void shrink_to_fit();
+
+    void clear() noexcept;
+    iterator insert(const_iterator pos, const T &value);
+    iterator insert(const_iterator pos, T &&value);
+    iterator insert(const_iterator pos, size_type n, const T &value);
+    template <typename InputIt, typename = enable_if_iterator<InputIt>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> il);
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    void push_back(const T &value);
+    void push_back(T &&value);
+    template <typename... Args>
+    reference emplace_back(Args &&...args);
+    void pop_back();
+    void resize(size_type n);
+    void resize(size_type n, const T &value);
+    void swap(vector &other) noexcept;
+
+private:
+    size_type next_capacity(size_type required) const;
+    void reallocate(size_type new_cap);
+    template <typename Construct>
+    void realloc_insert(T *pos, size_type n, Construct &&construct_gap);
+    void relocate(T *first, T *last, T *dest);
+    void destroy(T *first, T *last) noexcept;
+    void deallocate_storage() noexcept;
+
+private:
+    T *begin_;
+    T *end_;
+    T *cap_;
+    Allocator alloc_;
+};
+
+// the elements live on the heap, so only the allocator decides
+template <typename T, typename A, typename G>
+struct is_trivially_relocatable<vector<T, A, G>> : is_trivially_relocatable<A> {};
+
+template <typename T, typename A, typename G>
+vector<T, A, G>::vector(const A &alloc) noexcept
+    : begin_(nullptr), end_(nullptr), cap_(nullptr), alloc_(alloc) {}
+
+/*
+ * The constructors below delegate to the allocator constructor, so the
+ * destructor cleans up whatever they have built if they throw.
+ */
+template <typename T, typename A, typename G>
+vector<T, A, G>::vector(size_type n, const A &alloc)
+    : vector(alloc) {
+    if (n == 0) return;
+    this->begin_ = this->end_ = this->alloc_.allocate(n);
+    this->cap_ = this->begin_ + n;
+    this->end_ = uninitialized_value_construct_n(this->alloc_, this->begin_, n);
+}
+
+template <typename T, typename A, typename G>
+vector<T, A, G>::vector(size_type n, const T &value, const A &alloc)
+    : vector(alloc) {
+    if (n == 0) return;
+    this->begin_ = this->end_ = this->alloc_.allocate(n);
+    this->cap_ = this->begin_ + n;
+    this->end_ = uninitialized_fill_n(this->alloc_, this->begin_, n, value);
+}
+
+template <typename T, typename A, typename G>
+template <typename InputIt, typename>
+vector<T, A, G>::vector(InputIt first, InputIt last, const A &alloc)
+    : vector(alloc) {
+    assign(first, last);
+}
+
+template <typename T, typename A, typename G>
+vector<T, A, G>::vector(std::initializer_list<T> il, const A &alloc)
+    : vector(il.begin(), il.end(), alloc) {}
+
+template <typename T, typename A, typename G>
+vector<T, A, G>::vector(const vector &other)
+    : vector(other.begin(), other.end(), other.alloc_) {}
+
+template <typename T, typename A, typename G>
+vector<T, A, G>::vector(vector &&other) noexcept
+    : begin_(other.begin_), end_(other.end_), cap_(other.cap_), alloc_(std::move(other.alloc_)) {
+    other.begin_ = other.end_ = other.cap_ = nullptr;
+}
+
+template <typename T, typename A, typename G>
+vector<T, A, G> &vector<T, A, G>::operator=(const vector &other) {
+    if (this != &other) assign(other.begin(), other.end());
+    return *this;
+}
+
+template <typename T, typename A, typename G>
+vector<T, A, G> &vector<T, A, G>::operator=(vector &&other) noexcept {
+    if (this != &other) {
+        destroy(this->begin_, this->end_);
+        deallocate_storage();
+        this->alloc_ = std::move(other.alloc_);
+        this->begin_ = other.begin_;
+        this->end_ = other.end_;
+        this->cap_ = other.cap_;
+        other.begin_ = other.end_ = other.cap_ = nullptr;
+    }
+    return *this;
+}
+
+template <typename T, typename A, typename G>
+vector<T, A, G> &vector<T, A, G>::operator=(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+    return *this;
+}
+
+template <typename T, typename A, typename G>
+vector<T, A, G>::~vector() {
+    destroy(this->begin_, this->end_);
+    deallocate_storage();
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::assign(size_type n, const T &value) {
+    if (n > capacity()) {
+        vector tmp(n, value, this->alloc_);
+        swap(tmp);
+    } else if (n > size()) {
+        std::fill(this->begin_, this->end_, value);
+        this->end_ = uninitialized_fill_n(this->alloc_, this->end_, n - size(), value);
+    } else {
+        std::fill_n(this->begin_, n, value);
+        T *new_end = this->begin_ + n;
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+}
+
+template <typename T, typename A, typename G>
+template <typename InputIt, typename>
+void vector<T, A, G>::assign(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        if (n > capacity()) {
+            vector tmp(this->alloc_);
+            tmp.reserve(n);
+            tmp.end_ = uninitialized_copy_n(tmp.alloc_, first, n, tmp.begin_);
+            swap(tmp);
+        } else if (n > size()) {
+            InputIt mid = first;
+            std::advance(mid, size());
+            std::copy(first, mid, this->begin_);
+            this->end_ = uninitialized_copy_n(this->alloc_, mid, n - size(), this->end_);
+        } else {
+            T *new_end = std::copy(first, last, this->begin_);
+            destroy(new_end, this->end_);
+            this->end_ = new_end;
+        }
+    } else {
+        clear();
+        for (; first != last; ++first) emplace_back(*first);
+    }
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::assign(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::allocator_type vector<T, A, G>::get_allocator() const {
+    return this->alloc_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::reference vector<T, A, G>::at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("tinystl::vector::at");
+    return this->begin_[pos];
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reference vector<T, A, G>::at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("tinystl::vector::at");
+    return this->begin_[pos];
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::reference vector<T, A, G>::operator[](size_type pos) noexcept {
+    return this->begin_[pos];
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reference vector<T, A, G>::operator[](size_type pos) const noexcept {
+    return this->begin_[pos];
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::reference vector<T, A, G>::front() noexcept {
+    return *this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reference vector<T, A, G>::front() const noexcept {
+    return *this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::reference vector<T, A, G>::back() noexcept {
+    return *(this->end_ - 1);
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reference vector<T, A, G>::back() const noexcept {
+    return *(this->end_ - 1);
+}
+
+template <typename T, typename A, typename G>
+T *vector<T, A, G>::data() noexcept {
+    return this->begin_;
+}
+
+template <typename T, typename A, typename G>
+const T *vector<T, A, G>::data() const noexcept {
+    return this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::begin() noexcept {
+    return this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_iterator vector<T, A, G>::begin() const noexcept {
+    return this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_iterator vector<T, A, G>::cbegin() const noexcept {
+    return this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::end() noexcept {
+    return this->end_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_iterator vector<T, A, G>::end() const noexcept {
+    return this->end_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_iterator vector<T, A, G>::cend() const noexcept {
+    return this->end_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::reverse_iterator vector<T, A, G>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reverse_iterator vector<T, A, G>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reverse_iterator vector<T, A, G>::crbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::reverse_iterator vector<T, A, G>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reverse_iterator vector<T, A, G>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::const_reverse_iterator vector<T, A, G>::crend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, typename A, typename G>
+bool vector<T, A, G>::empty() const noexcept {
+    return this->begin_ == this->end_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::size_type vector<T, A, G>::size() const noexcept {
+    return static_cast<size_type>(this->end_ - this->begin_);
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::size_type vector<T, A, G>::max_size() const noexcept {
+    return this->alloc_.max_size();
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::reserve(size_type n) {
+    if (n > max_size()) throw std::length_error("tinystl::vector::reserve");
+    if (n > capacity()) reallocate(n);
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::size_type vector<T, A, G>::capacity() const noexcept {
+    return static_cast<size_type>(this->cap_ - this->begin_);
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::shrink_to_fit() {
+    if (this->end_ == this->cap_) return;
+    if (empty()) {
+        deallocate_storage();
+        this->begin_ = this->end_ = this->cap_ = nullptr;
+        return;
+    }
+    reallocate(size());
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::clear() noexcept {
+    destroy(this->begin_, this->end_);
+    this->end_ = this->begin_;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::insert(const_iterator pos, size_type n, const T &value) {
+    T *p = this->begin_ + (pos - this->begin_);
+    if (n == 0) return p;
+    if (static_cast<size_type>(this->cap_ - this->end_) < n) {
+        size_type offset = static_cast<size_type>(p - this->begin_);
+        realloc_insert(p, n, [&](T *gap) { uninitialized_fill_n(this->alloc_, gap, n, value); });
+        return this->begin_ + offset;
+    }
+    T copy(value);
+    size_type elems_after = static_cast<size_type>(this->end_ - p);
+    T *old_end = this->end_;
+    if (elems_after > n) {
+        this->end_ = uninitialized_move_n(this->alloc_, old_end - n, n, old_end);
+        std::move_backward(p, old_end - n, old_end);
+        std::fill_n(p, n, copy);
+    } else {
+        this->end_ = uninitialized_fill_n(this->alloc_, old_end, n - elems_after, copy);
+        this->end_ = uninitialized_move_n(this->alloc_, p, elems_after, this->end_);
+        std::fill(p, old_end, copy);
+    }
+    return p;
+}
+
+template <typename T, typename A, typename G>
+template <typename InputIt, typename>
+typename vector<T, A, G>::iterator vector<T, A, G>::insert(const_iterator pos, InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    T *p = this->begin_ + (pos - this->begin_);
+    size_type offset = static_cast<size_type>(p - this->begin_);
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        if (n == 0) return p;
+        if (static_cast<size_type>(this->cap_ - this->end_) < n) {
+            realloc_insert(p, n, [&](T *gap) { uninitialized_copy_n(this->alloc_, first, n, gap); });
+            return this->begin_ + offset;
+        }
+        size_type elems_after = static_cast<size_type>(this->end_ - p);
+        T *old_end = this->end_;
+        if (elems_after > n) {
+            this->end_ = uninitialized_move_n(this->alloc_, old_end - n, n, old_end);
+            std::move_backward(p, old_end - n, old_end);
+            std::copy(first, last, p);
+        } else {
+            InputIt mid = first;
+            std::advance(mid, elems_after);
+            this->end_ = uninitialized_copy_n(this->alloc_, mid, n - elems_after, old_end);
+            this->end_ = uninitialized_move_n(this->alloc_, p, elems_after, this->end_);
+            std::copy(first, mid, p);
+        }
+        return p;
+    } else {
+        if (p == this->end_) {
+            for (; first != last; ++first) emplace_back(*first);
+            return this->begin_ + offset;
+        }
+        vector tmp(first, last, this->alloc_);
+        return insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+    }
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::insert(const_iterator pos, std::initializer_list<T> il) {
+    return insert(pos, il.begin(), il.end());
+}
+
+template <typename T, typename A, typename G>
+template <typename... Args>
+typename vector<T, A, G>::iterator vector<T, A, G>::emplace(const_iterator pos, Args &&...args) {
+    T *p = this->begin_ + (pos - this->begin_);
+    size_type offset = static_cast<size_type>(p - this->begin_);
+    if (this->end_ == this->cap_) {
+        realloc_insert(p, 1, [&](T *gap) { this->alloc_.construct(gap, std::forward<Args>(args)...); });
+    } else if (p == this->end_) {
+        this->alloc_.construct(this->end_, std::forward<Args>(args)...);
+        ++this->end_;
+    } else {
+        // args may refer to an element that is about to be shifted
+        T tmp(std::forward<Args>(args)...);
+        this->alloc_.construct(this->end_, std::move(*(this->end_ - 1)));
+        ++this->end_;
+        std::move_backward(p, this->end_ - 2, this->end_ - 1);
+        *p = std::move(tmp);
+    }
+    return this->begin_ + offset;
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::iterator vector<T, A, G>::erase(const_iterator first, const_iterator last) {
+    T *f = this->begin_ + (first - this->begin_);
+    T *l = this->begin_ + (last - this->begin_);
+    if (f == l) return f;
+    if constexpr (is_trivially_relocatable<T>::value) {
+        // the erased elements go first, then the tail slides down as bytes
+        destroy(f, l);
+        this->end_ = relocate_n(this->alloc_, l, static_cast<size_type>(this->end_ - l), f);
+    } else {
+        T *new_end = std::move(l, this->end_, f);
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+    return f;
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::push_back(const T &value) {
+    emplace_back(value);
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::push_back(T &&value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T, typename A, typename G>
+template <typename... Args>
+typename vector<T, A, G>::reference vector<T, A, G>::emplace_back(Args &&...args) {
+    if (this->end_ != this->cap_) {
+        this->alloc_.construct(this->end_, std::forward<Args>(args)...);
+        ++this->end_;
+    } else if constexpr (allocator_can_reallocate<A>::value && is_trivially_relocatable<T>::value) {
+        // args may refer to an element that moves with the buffer
+        T tmp(std::forward<Args>(args)...);
+        reallocate(next_capacity(size() + 1));
+        this->alloc_.construct(this->end_, std::move(tmp));
+        ++this->end_;
+    } else {
+        realloc_insert(this->end_, 1, [&](T *gap) { this->alloc_.construct(gap, std::forward<Args>(args)...); });
+    }
+    return back();
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::pop_back() {
+    --this->end_;
+    this->alloc_.destroy(this->end_);
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::resize(size_type n) {
+    if (n > size()) {
+        if (n > capacity()) reallocate(next_capacity(n));
+        this->end_ = uninitialized_value_construct_n(this->alloc_, this->end_, n - size());
+    } else {
+        T *new_end = this->begin_ + n;
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::resize(size_type n, const T &value) {
+    if (n > size()) {
+        insert(cend(), n - size(), value);
+    } else {
+        T *new_end = this->begin_ + n;
+        destroy(new_end, this->end_);
+        this->end_ = new_end;
+    }
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::swap(vector &other) noexcept {
+    std::swap(this->begin_, other.begin_);
+    std::swap(this->end_, other.end_);
+    std::swap(this->cap_, other.cap_);
+    std::swap(this->alloc_, other.alloc_);
+}
+
+template <typename T, typename A, typename G>
+typename vector<T, A, G>::size_type vector<T, A, G>::next_capacity(size_type required) const {
+    const size_type max = max_size();
+    if (required > max) throw std::length_error("tinystl::vector");
+    size_type cap = capacity();
+    if (cap == 0) {
+        // the first allocation fills at least one cache line
+        constexpr size_type min_cap = (sizeof(T) < 64) ? 64 / sizeof(T) : 1;
+        return std::max(required, min_cap);
+    }
+    size_type extra = cap / G::den * (G::num - G::den) + cap % G::den * (G::num - G::den) / G::den;
+    size_type grown = (extra > max - cap) ? max : cap + extra;
+    return std::max(required, grown);
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::reallocate(size_type new_cap) {
+    if constexpr (allocator_can_reallocate<A>::value && is_trivially_relocatable<T>::value) {
+        if (this->begin_ != nullptr) {
+            size_type n = size();
+            this->begin_ = this->alloc_.reallocate(this->begin_, capacity(), new_cap);
+            this->end_ = this->begin_ + n;
+            this->cap_ = this->begin_ + new_cap;
+            return;
+        }
+    }
+    T *new_begin = this->alloc_.allocate(new_cap);
+    try {
+        relocate(this->begin_, this->end_, new_begin);
+    } catch (...) {
+        this->alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    size_type n = size();
+    deallocate_storage();
+    this->begin_ = new_begin;
+    this->end_ = new_begin + n;
+    this->cap_ = new_begin + new_cap;
+}
+
+template <typename T, typename A, typename G>
+template <typename Construct>
+void vector<T, A, G>::realloc_insert(T *pos, size_type n, Construct &&construct_gap) {
+    size_type new_cap = next_capacity(size() + n);
+    size_type new_size = size() + n;
+    T *new_begin = this->alloc_.allocate(new_cap);
+    T *new_pos = new_begin + (pos - this->begin_);
+    // the new elements go first: their source may alias an element of *this
+    try {
+        construct_gap(new_pos);
+    } catch (...) {
+        this->alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    try {
+        relocate(this->begin_, pos, new_begin);
+    } catch (...) {
+        destroy(new_pos, new_pos + n);
+        this->alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    try {
+        relocate(pos, this->end_, new_pos + n);
+    } catch (...) {
+        // the prefix has already left the old buffer, so only the basic
+        // guarantee can be kept here
+        destroy(new_begin, new_pos + n);
+        this->alloc_.deallocate(new_begin, new_cap);
+        destroy(pos, this->end_);
+        this->end_ = this->begin_;
+        throw;
+    }
+    deallocate_storage();
+    this->begin_ = new_begin;
+    this->end_ = new_begin + new_size;
+    this->cap_ = new_begin + new_cap;
+}
+
+// moves [first, last) into uninitialized storage at dest, see relocate_n
+template <typename T, typename A, typename G>
+void vector<T, A, G>::relocate(T *first, T *last, T *dest) {
+    relocate_n(this->alloc_, first, static_cast<size_type>(last - first), dest);
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::destroy(T *first, T *last) noexcept {
+    destroy_n(this->alloc_, first, static_cast<size_type>(last - first));
+}
+
+template <typename T, typename A, typename G>
+void vector<T, A, G>::deallocate_storage() noexcept {
+    if (this->begin_ != nullptr) {
+        this->alloc_.deallocate(this->begin_, capacity());
+    }
+}
+
+template <typename T, typename A, typename G>
+bool operator==(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename A, typename G>
+bool operator!=(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename A, typename G>
+bool operator<(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename A, typename G>
+bool operator>(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename A, typename G>
+bool operator<=(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename A, typename G>
+bool operator>=(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, typename A, typename G>
+void swap(vector<T, A, G> &lhs, vector<T, A, G> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace tinystl
@@ -1,5 +1,8 @@
 #include <tinystl/allocator.h>
 #include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 
 /*
  * WARN: this test is generated by Github Copilot.
@@ -7,6 +10,28 @@
 
 using namespace tinystl;
 
+namespace {
+
+struct Pixel {
+    std::uint8_t r, g, b;
+};
+
+struct ThrowsOnCopy {
+    static int live;
+    int value;
+
+    ThrowsOnCopy(int v) : value(v) { ++live; }
+    ThrowsOnCopy(const ThrowsOnCopy& other) : value(other.value) {
+        if (live >= 3) throw std::runtime_error("copy");
+        ++live;
+    }
+    ~ThrowsOnCopy() { --live; }
+};
+
+int ThrowsOnCopy::live = 0;
+
+}  // namespace
+
 TEST_CASE("Allocator Tests", "[allocator]") {
     SECTION("Allocate and deallocate") {
         allocator<int> alloc;
@@ -233,4 +258,78 @@ TEST_CASE("Allocator Tests", "[allocator]") {
         alloc.deallocate(p1, 1);
         alloc.deallocate(p2, 1);
     }
+
+    SECTION("Bulk fill of trivially copyable types") {
+        allocator<std::uint32_t> alloc;
+        std::uint32_t* p = alloc.allocate(101);
+        REQUIRE(uninitialized_fill_n(alloc, p, 101, 0x12345678u) == p + 101);
+        for (int i = 0; i < 101; ++i) REQUIRE(p[i] == 0x12345678u);
+        uninitialized_fill_n(alloc, p, 37, 0u);
+        for (int i = 0; i < 37; ++i) REQUIRE(p[i] == 0u);
+        REQUIRE(p[37] == 0x12345678u);
+        alloc.deallocate(p, 101);
+
+        allocator<Pixel> pixels;
+        Pixel* q = pixels.allocate(50);
+        uninitialized_fill_n(pixels, q, 50, Pixel{1, 2, 3});
+        for (int i = 0; i < 50; ++i) REQUIRE((q[i].r == 1 && q[i].g == 2 && q[i].b == 3));
+        pixels.deallocate(q, 50);
+    }
+
+    SECTION("Bulk copy, move and value construction") {
+        allocator<double> alloc;
+        double src[70];
+        for (int i = 0; i < 70; ++i) src[i] = i * 0.5;
+        double* p = alloc.allocate(70);
+        REQUIRE(uninitialized_copy_n(alloc, static_cast<const double*>(src), 70, p) == p + 70);
+        for (int i = 0; i < 70; ++i) REQUIRE(p[i] == i * 0.5);
+        REQUIRE(uninitialized_value_construct_n(alloc, p, 10) == p + 10);
+        for (int i = 0; i < 10; ++i) REQUIRE(p[i] == 0.0);
+        alloc.deallocate(p, 70);
+
+        allocator<std::string> strings;
+        std::string* s = strings.allocate(3);
+        std::string* t = strings.allocate(3);
+        uninitialized_fill_n(strings, s, 3, std::string(40, 'a'));
+        REQUIRE(uninitialized_move_n(strings, s, 3, t) == t + 3);
+        REQUIRE(t[2] == std::string(40, 'a'));
+        REQUIRE(s[2].empty());
+        destroy_n(strings, s, 3);
+        destroy_n(strings, t, 3);
+        strings.deallocate(s, 3);
+        strings.deallocate(t, 3);
+    }
+
+    SECTION("Relocation") {
+        allocator<std::string> strings;
+        std::string* s = strings.allocate(3);
+        std::string* t = strings.allocate(3);
+        uninitialized_fill_n(strings, s, 3, std::string(40, 'a'));
+        REQUIRE(relocate_n(strings, s, 3, t) == t + 3);
+        REQUIRE(t[0] == std::string(40, 'a'));
+        destroy_n(strings, t, 3);
+        strings.deallocate(s, 3);
+        strings.deallocate(t, 3);
+
+        // trivially relocatable ranges may overlap
+        allocator<int> ints;
+        int* p = ints.allocate(6);
+        for (int i = 0; i < 6; ++i) p[i] = i;
+        REQUIRE(relocate_n(ints, p + 2, 4, p) == p + 4);
+        REQUIRE((p[0] == 2 && p[1] == 3 && p[2] == 4 && p[3] == 5));
+        ints.deallocate(p, 6);
+    }
+
+    SECTION("Bulk construction cleans up when an element throws") {
+        ThrowsOnCopy::live = 0;
+        allocator<ThrowsOnCopy> alloc;
+        ThrowsOnCopy* p = alloc.allocate(5);
+        ThrowsOnCopy value(7);
+        REQUIRE_THROWS_AS(uninitialized_fill_n(alloc, p, 5, value), std::runtime_error);
+        REQUIRE(ThrowsOnCopy::live == 1);
+        ThrowsOnCopy src[2] = {1, 2};
+        REQUIRE_THROWS_AS(uninitialized_copy_n(alloc, src, 2, p), std::runtime_error);
+        REQUIRE(ThrowsOnCopy::live == 3);
+        alloc.deallocate(p, 5);
+    }
 }
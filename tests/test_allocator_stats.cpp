@@ -0,0 +1,129 @@
+#include <tinystl/allocator_stats.h>
+#include <tinystl/memory.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace tinystl;
+
+#ifdef TINYSTL_ENABLE_ALLOCATOR_STATS
+
+TEST_CASE("Allocator Stats Tests", "[allocator_stats]") {
+    global_allocation_registry().reset();
+
+    SECTION("Histogram buckets") {
+        REQUIRE(allocation_stats::bucket(1) == 0);
+        REQUIRE(allocation_stats::bucket(2) == 1);
+        REQUIRE(allocation_stats::bucket(16) == 4);
+        REQUIRE(allocation_stats::bucket(17) == 5);
+        REQUIRE(allocation_stats::bucket(static_cast<std::size_t>(-1)) == allocation_stats::histogram_size - 1);
+    }
+
+    SECTION("Counts, live and peak bytes") {
+        instrumented_allocator<int> alloc;
+        int *a = alloc.allocate(4);
+        int *b = alloc.allocate(8);
+        alloc.deallocate(a, 4);
+        int *c = alloc.allocate(2);
+
+        allocation_stats s = global_allocation_registry().snapshot();
+        REQUIRE(s.allocations == 3);
+        REQUIRE(s.deallocations == 1);
+        REQUIRE(s.allocated_bytes == 14 * sizeof(int));
+        REQUIRE(s.live_bytes == 10 * sizeof(int));
+        REQUIRE(s.peak_bytes == 12 * sizeof(int));
+        REQUIRE(s.histogram[allocation_stats::bucket(4 * sizeof(int))] == 1);
+        REQUIRE(s.histogram[allocation_stats::bucket(8 * sizeof(int))] == 1);
+
+        alloc.deallocate(b, 8);
+        alloc.deallocate(c, 2);
+        REQUIRE(global_allocation_registry().snapshot().live_bytes == 0);
+    }
+
+    SECTION("Tags follow rebinding") {
+        static const char tag[] = "nodes";
+        {
+            vector<int, instrumented_allocator<int>> v(instrumented_allocator<int>{tag});
+            for (int i = 0; i < 100; ++i) v.push_back(i);
+            auto p = tinystl::allocate_shared<std::string>(instrumented_allocator<std::string>(tag), "x");
+
+            allocation_stats s = global_allocation_registry().snapshot();
+            const allocation_tag_stats *t = s.find(tag);
+            REQUIRE(t != nullptr);
+            REQUIRE(t->allocations == s.allocations);
+            REQUIRE(t->live_bytes == s.live_bytes);
+            REQUIRE(t->live_bytes >= 100 * sizeof(int));
+        }
+        allocation_stats s = global_allocation_registry().snapshot();
+        const allocation_tag_stats *t = s.find(tag);
+        REQUIRE(t->live_bytes == 0);
+        REQUIRE(t->deallocations == t->allocations);
+    }
+
+    SECTION("Call site tags") {
+        instrumented_allocator<char> alloc(TINYSTL_CALL_SITE);
+        REQUIRE(std::string(alloc.tag()).find("test_allocator_stats.cpp:") != std::string::npos);
+        alloc.deallocate(alloc.allocate(3), 3);
+        allocation_stats s = global_allocation_registry().snapshot();
+        REQUIRE(s.find(alloc.tag())->allocations == 1);
+    }
+
+    SECTION("Dump") {
+        instrumented_allocator<char> alloc("dump");
+        char *p = alloc.allocate(100);
+        std::ostringstream os;
+        global_allocation_registry().dump(os);
+        alloc.deallocate(p, 100);
+        std::string out = os.str();
+        REQUIRE(out.find("live bytes: 100") != std::string::npos);
+        REQUIRE(out.find("<= 128: 1") != std::string::npos);
+        REQUIRE(out.find("dump: allocations 1") != std::string::npos);
+    }
+
+    SECTION("Concurrent recording") {
+        allocation_registry registry;
+        std::thread threads[4];
+        for (auto &t : threads) {
+            t = std::thread([&registry] {
+                for (int i = 0; i < 10000; ++i) {
+                    registry.record_allocate(32, "worker");
+                    registry.record_deallocate(32, "worker");
+                }
+            });
+        }
+        for (auto &t : threads) t.join();
+        allocation_stats s = registry.snapshot();
+        REQUIRE(s.allocations == 40000);
+        REQUIRE(s.live_bytes == 0);
+        REQUIRE(s.peak_bytes >= 32);
+        REQUIRE(s.peak_bytes <= 4 * 32);
+        REQUIRE(s.tag_count == 1);
+    }
+}
+
+#else
+
+TEST_CASE("Allocator Stats Tests", "[allocator_stats]") {
+    SECTION("Compiled out") {
+        REQUIRE_FALSE(allocation_registry::enabled);
+        allocation_registry registry;
+        registry.record_allocate(32, "tag");
+        allocation_stats s = registry.snapshot();
+        REQUIRE(s.allocations == 0);
+        REQUIRE(s.tag_count == 0);
+    }
+
+    SECTION("Instrumented allocator only forwards") {
+        instrumented_allocator<int> alloc("off");
+        int *p = alloc.allocate(4);
+        REQUIRE(p != nullptr);
+        alloc.deallocate(p, 4);
+        allocation_stats s = global_allocation_registry().snapshot();
+        REQUIRE(s.allocations == 0);
+        REQUIRE(s.find("off") == nullptr);
+    }
+}
+
+#endif
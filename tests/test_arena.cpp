@@ -0,0 +1,86 @@
+#include <tinystl/arena.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <string>
+
+using namespace tinystl;
+
+namespace {
+
+bool inside(const void *p, const void *buffer, std::size_t size) {
+    auto addr = reinterpret_cast<std::uintptr_t>(p);
+    auto begin = reinterpret_cast<std::uintptr_t>(buffer);
+    return addr >= begin && addr < begin + size;
+}
+
+}  // namespace
+
+TEST_CASE("Arena Tests", "[arena]") {
+    SECTION("Bump allocation is contiguous and aligned") {
+        monotonic_arena arena;
+        char *a = static_cast<char *>(arena.allocate(3, 1));
+        char *b = static_cast<char *>(arena.allocate(5, 1));
+        REQUIRE(b == a + 3);
+        void *c = arena.allocate(8, 8);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 8 == 0);
+        void *d = arena.allocate(16, 64);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(d) % 64 == 0);
+    }
+
+    SECTION("Caller provided buffer is used first") {
+        alignas(std::max_align_t) unsigned char buffer[128];
+        monotonic_arena arena(buffer, sizeof(buffer));
+        void *p = arena.allocate(64);
+        REQUIRE(inside(p, buffer, sizeof(buffer)));
+        void *q = arena.allocate(128);
+        REQUIRE_FALSE(inside(q, buffer, sizeof(buffer)));
+
+        arena.release();
+        REQUIRE(arena.allocate(64) == p);
+    }
+
+    SECTION("Oversized and many allocations") {
+        monotonic_arena arena(64);
+        char *big = static_cast<char *>(arena.allocate(100000));
+        big[99999] = 1;
+        for (int i = 0; i < 10000; ++i) {
+            int *p = static_cast<int *>(arena.allocate(sizeof(int), alignof(int)));
+            *p = i;
+        }
+        arena.release();
+    }
+
+    SECTION("Inline arena") {
+        inline_arena<256> arena;
+        void *p = arena.allocate(200);
+        void *q = arena.allocate(200);
+        REQUIRE(inside(p, &arena, sizeof(arena)));
+        REQUIRE_FALSE(inside(q, &arena, sizeof(arena)));
+    }
+
+    SECTION("Allocator adapter") {
+        inline_arena<1024> arena;
+        arena_allocator<int> alloc(arena);
+        int *p = alloc.allocate(4);
+        REQUIRE(inside(p, &arena, sizeof(arena)));
+        alloc.deallocate(p, 4);
+        REQUIRE(alloc.allocate(0) == nullptr);
+
+        arena_allocator<double> other(alloc);
+        REQUIRE(other == alloc);
+        monotonic_arena second;
+        REQUIRE(arena_allocator<int>(second) != alloc);
+    }
+
+    SECTION("As a container allocator") {
+        monotonic_arena arena;
+        {
+            tinystl::vector<std::string, arena_allocator<std::string>> v(arena);
+            for (int i = 0; i < 100; ++i) v.push_back(std::to_string(i));
+            REQUIRE(v[99] == "99");
+            REQUIRE(v.get_allocator().arena() == &arena);
+        }
+        arena.release();
+    }
+}
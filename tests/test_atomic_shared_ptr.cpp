@@ -0,0 +1,117 @@
+#include <tinystl/atomic_shared_ptr.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct config {
+    static std::atomic<int> live;
+    int version;
+    int checksum;
+
+    explicit config(int v) : version(v), checksum(v * 7) { ++live; }
+    ~config() {
+        checksum = -1;
+        --live;
+    }
+};
+
+std::atomic<int> config::live {0};
+
+}  // namespace
+
+TEST_CASE("Atomic Shared Ptr Tests", "[atomic_shared_ptr]") {
+    SECTION("Empty slot") {
+        atomic_shared_ptr<int> slot;
+        REQUIRE(slot.is_lock_free());
+        REQUIRE_FALSE(slot.load());
+    }
+
+    SECTION("Load and store") {
+        {
+            atomic_shared_ptr<config> slot(tinystl::make_shared<config>(1));
+            auto a = slot.load();
+            REQUIRE(a->version == 1);
+            slot.store(tinystl::make_shared<config>(2));
+            REQUIRE(slot.load()->version == 2);
+            REQUIRE(a->version == 1);
+            REQUIRE(a.use_count() == 1);
+            REQUIRE(config::live == 2);
+            a.reset();
+            REQUIRE(config::live == 1);
+            slot = shared_ptr<config>();
+            REQUIRE(config::live == 0);
+            REQUIRE_FALSE(slot.load());
+            slot.store(tinystl::make_shared<config>(3));
+        }
+        REQUIRE(config::live == 0);
+    }
+
+    SECTION("Exchange") {
+        atomic_shared_ptr<config> slot(tinystl::make_shared<config>(1));
+        auto old = slot.exchange(tinystl::make_shared<config>(2));
+        REQUIRE(old->version == 1);
+        REQUIRE(old.use_count() == 1);
+        shared_ptr<config> current = slot;
+        REQUIRE(current->version == 2);
+    }
+
+    SECTION("Compare exchange") {
+        atomic_shared_ptr<config> slot(tinystl::make_shared<config>(1));
+        auto expected = slot.load();
+        auto stale = tinystl::make_shared<config>(9);
+
+        REQUIRE_FALSE(slot.compare_exchange_strong(stale, tinystl::make_shared<config>(2)));
+        REQUIRE(stale.get() == expected.get());
+        stale.reset();
+        REQUIRE(slot.compare_exchange_strong(expected, tinystl::make_shared<config>(3)));
+        REQUIRE(slot.load()->version == 3);
+        REQUIRE(expected.use_count() == 1);
+    }
+
+    SECTION("Many loads replenish the batch") {
+        atomic_shared_ptr<config> slot(tinystl::make_shared<config>(1));
+        for (std::size_t i = 0; i < 4 * atomic_shared_ptr<config>::batch; ++i) {
+            auto p = slot.load();
+            REQUIRE(p->version == 1);
+        }
+        auto last = slot.exchange(shared_ptr<config>());
+        REQUIRE(last.use_count() == 1);
+    }
+
+    SECTION("Readers and a writer") {
+        {
+            atomic_shared_ptr<config> slot(tinystl::make_shared<config>(0));
+            std::atomic<bool> done {false};
+            std::atomic<int> failures {0};
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 3; ++t) {
+                readers.emplace_back([&] {
+                    int last = 0;
+                    while (!done.load(std::memory_order_acquire)) {
+                        auto c = slot.load();
+                        if (c->checksum != c->version * 7 || c->version < last) failures.fetch_add(1);
+                        last = c->version;
+                    }
+                });
+            }
+            for (int v = 1; v <= 20000; ++v) {
+                if (v % 2 == 0) {
+                    slot.store(tinystl::make_shared<config>(v));
+                } else {
+                    auto expected = slot.load();
+                    if (!slot.compare_exchange_strong(expected, tinystl::make_shared<config>(v))) failures.fetch_add(1);
+                }
+            }
+            done.store(true, std::memory_order_release);
+            for (auto &t : readers) t.join();
+            REQUIRE(failures == 0);
+            REQUIRE(slot.load()->version == 20000);
+        }
+        REQUIRE(config::live == 0);
+    }
+}
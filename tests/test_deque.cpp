@@ -0,0 +1,198 @@
+#include <tinystl/deque.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace tinystl;
+
+namespace {
+
+// throws when constructed from a negative value
+struct picky {
+    static int live;
+    int value;
+
+    picky(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("picky");
+        ++live;
+    }
+    picky(const picky &other) : value(other.value) { ++live; }
+    ~picky() { --live; }
+};
+
+int picky::live = 0;
+
+}  // namespace
+
+TEST_CASE("Deque Tests", "[deque]") {
+    SECTION("Blocks are a power of two of about 4 KiB") {
+        REQUIRE(deque<char>::block_size == 4096);
+        REQUIRE(deque<int>::block_size == 1024);
+        REQUIRE(deque<std::string>::block_size * sizeof(std::string) <= 4096);
+        REQUIRE(deque<char[1000]>::block_size == 16);
+    }
+
+    SECTION("Push and pop at both ends") {
+        deque<int> d;
+        REQUIRE(d.empty());
+        for (int i = 0; i < 5000; ++i) {
+            d.push_back(i);
+            d.push_front(-i - 1);
+        }
+        REQUIRE(d.size() == 10000);
+        REQUIRE(d.front() == -5000);
+        REQUIRE(d.back() == 4999);
+        for (int i = 0; i < 10000; ++i) REQUIRE(d[i] == i - 5000);
+        REQUIRE(d.at(9999) == 4999);
+        REQUIRE_THROWS_AS(d.at(10000), std::out_of_range);
+
+        for (int i = 0; i < 3000; ++i) {
+            d.pop_front();
+            d.pop_back();
+        }
+        REQUIRE(d.size() == 4000);
+        REQUIRE(d.front() == -2000);
+        REQUIRE(d.back() == 1999);
+        while (!d.empty()) d.pop_back();
+        d.push_front(7);
+        REQUIRE(d.front() == 7);
+        REQUIRE(d.back() == 7);
+    }
+
+    SECTION("References stay valid while the deque grows") {
+        deque<std::string> d;
+        d.push_back("first");
+        std::string *first = &d.front();
+        for (int i = 0; i < 20000; ++i) {
+            d.emplace_back(std::to_string(i));
+            d.emplace_front(std::to_string(-i));
+        }
+        REQUIRE(&d[20000] == first);
+        REQUIRE(*first == "first");
+    }
+
+    SECTION("Used as a queue it reuses its blocks") {
+        deque<int> d;
+        for (int round = 0; round < 100000; ++round) {
+            d.push_back(round);
+            if (d.size() > 100) d.pop_front();
+        }
+        REQUIRE(d.size() == 100);
+        REQUIRE(d.front() == 99900);
+        REQUIRE(d.back() == 99999);
+    }
+
+    SECTION("Random operations match std::deque") {
+        deque<int> d;
+        std::deque<int> expected;
+        std::mt19937 rng(42);
+        for (int i = 0; i < 200000; ++i) {
+            unsigned op = rng() % 100;
+            if (op < 30) {
+                d.push_back(i);
+                expected.push_back(i);
+            } else if (op < 60) {
+                d.push_front(i);
+                expected.push_front(i);
+            } else if (op < 79 && !expected.empty()) {
+                d.pop_back();
+                expected.pop_back();
+            } else if (op < 98 && !expected.empty()) {
+                d.pop_front();
+                expected.pop_front();
+            } else if (op == 99) {
+                d.clear();
+                expected.clear();
+            }
+            REQUIRE(d.size() == expected.size());
+            if (!expected.empty()) {
+                REQUIRE(d.front() == expected.front());
+                REQUIRE(d.back() == expected.back());
+            }
+        }
+        REQUIRE(std::equal(d.begin(), d.end(), expected.begin(), expected.end()));
+    }
+
+    SECTION("Iterators") {
+        deque<int> d;
+        for (int i = 0; i < 3000; ++i) d.push_back(i);
+        for (int i = 1; i <= 3000; ++i) d.push_front(-i);
+        REQUIRE(d.end() - d.begin() == 6000);
+        REQUIRE(std::accumulate(d.begin(), d.end(), 0L) == -3000L);
+        REQUIRE(std::is_sorted(d.cbegin(), d.cend()));
+        REQUIRE(*std::lower_bound(d.begin(), d.end(), 1234) == 1234);
+        REQUIRE(*(d.begin() + 4500) == 1500);
+        REQUIRE(d.begin()[10] == -2990);
+        REQUIRE(*d.rbegin() == 2999);
+        deque<int>::const_iterator it = d.begin();
+        REQUIRE(it == d.cbegin());
+        std::sort(d.begin(), d.end(), [](int a, int b) { return a > b; });
+        REQUIRE(d.front() == 2999);
+        REQUIRE(d.back() == -3000);
+
+        // popping whole blocks off the front leaves the other iterators valid
+        constexpr int block = static_cast<int>(deque<int>::block_size);
+        deque<int> q;
+        for (int i = 0; i < 3 * block; ++i) q.push_back(i);
+        deque<int>::iterator mid = q.begin() + 2 * block;
+        deque<int>::iterator last = q.end() - 1;
+        for (int i = 0; i < block; ++i) q.pop_front();
+        REQUIRE(*mid == 2 * block);
+        REQUIRE(mid != q.end());
+        REQUIRE(mid - q.begin() == block);
+        REQUIRE(q.end() - mid == block);
+        REQUIRE(q.begin() < mid);
+        REQUIRE(last + 1 == q.end());
+    }
+
+    SECTION("Construction, copy and comparison") {
+        deque<int> a{1, 2, 3};
+        deque<int> b(a);
+        REQUIRE(a == b);
+        b.push_front(0);
+        REQUIRE(a != b);
+        deque<int> c(std::move(b));
+        REQUIRE(b.empty());
+        REQUIRE(c.size() == 4);
+        a = c;
+        REQUIRE(a == c);
+        a = {5, 6};
+        REQUIRE(a.size() == 2);
+        REQUIRE(a[1] == 6);
+        c = std::move(a);
+        REQUIRE(c.back() == 6);
+
+        deque<std::string> s(3000, "x");
+        REQUIRE(s.size() == 3000);
+        REQUIRE(s[2999] == "x");
+        s.resize(10);
+        REQUIRE(s.size() == 10);
+        s.resize(20);
+        REQUIRE(s[19].empty());
+        s.clear();
+        REQUIRE(s.empty());
+        s.push_back("again");
+        REQUIRE(s.front() == "again");
+        s.shrink_to_fit();
+    }
+
+    SECTION("A throwing constructor leaves the deque unchanged") {
+        picky::live = 0;
+        {
+            deque<picky> d;
+            for (int i = 0; i < 2 * static_cast<int>(deque<picky>::block_size); ++i) d.emplace_back(i);
+            REQUIRE_THROWS_AS(d.emplace_back(-1), std::runtime_error);
+            REQUIRE_THROWS_AS(d.emplace_front(-1), std::runtime_error);
+            REQUIRE(d.size() == 2 * deque<picky>::block_size);
+            d.emplace_front(5);
+            d.pop_front();
+            REQUIRE(d.front().value == 0);
+            REQUIRE(picky::live == static_cast<int>(d.size()));
+        }
+        REQUIRE(picky::live == 0);
+    }
+}
@@ -0,0 +1,280 @@
+#include <tinystl/flat_hash_map.h>
+#include <catch2/catch_all.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct string_hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+struct string_equal {
+    using is_transparent = void;
+    bool operator()(std::string_view lhs, std::string_view rhs) const { return lhs == rhs; }
+};
+
+// every key lands in the same group, so probes run through tombstones
+struct constant_hash {
+    std::size_t operator()(int) const { return 42; }
+};
+
+struct counted {
+    static int live;
+    int value;
+
+    counted(int v = 0) : value(v) { ++live; }
+    counted(const counted &other) : value(other.value) { ++live; }
+    counted(counted &&other) noexcept : value(other.value) { ++live; }
+    counted &operator=(const counted &other) = default;
+    ~counted() { --live; }
+};
+
+int counted::live = 0;
+
+// a key without a move constructor whose copies start throwing once copies_left runs out
+struct fragile_key {
+    static int copies_left;
+    static int live;
+    int value;
+
+    explicit fragile_key(int v) : value(v) { ++live; }
+    fragile_key(const fragile_key &other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("fragile_key copy");
+        ++live;
+    }
+    ~fragile_key() { --live; }
+    bool operator==(const fragile_key &other) const { return this->value == other.value; }
+};
+
+int fragile_key::copies_left = 0;
+int fragile_key::live = 0;
+
+struct fragile_hash {
+    std::size_t operator()(const fragile_key &k) const { return std::hash<int>()(k.value); }
+};
+
+// a key that can be moved without throwing, counting its copies
+struct movable_key {
+    static int copies;
+    std::string value;
+
+    explicit movable_key(std::string v) : value(std::move(v)) {}
+    movable_key(const movable_key &other) : value(other.value) { ++copies; }
+    movable_key(movable_key &&other) noexcept = default;
+    bool operator==(const movable_key &other) const { return this->value == other.value; }
+};
+
+int movable_key::copies = 0;
+
+struct movable_hash {
+    std::size_t operator()(const movable_key &k) const noexcept { return std::hash<std::string>()(k.value); }
+};
+
+}  // namespace
+
+TEST_CASE("Flat Hash Map Tests", "[flat_hash_map]") {
+    SECTION("Starts empty without allocating") {
+        flat_hash_map<int, int> m;
+        REQUIRE(m.empty());
+        REQUIRE(m.capacity() == 0);
+        REQUIRE(m.begin() == m.end());
+        REQUIRE(m.find(1) == m.end());
+        REQUIRE(m.erase(1) == 0);
+    }
+
+    SECTION("Insert and find") {
+        flat_hash_map<int, std::string> m;
+        auto ret = m.insert({1, "one"});
+        REQUIRE(ret.second);
+        REQUIRE(ret.first->first == 1);
+        REQUIRE(ret.first->second == "one");
+        ret = m.insert({1, "uno"});
+        REQUIRE_FALSE(ret.second);
+        REQUIRE(ret.first->second == "one");
+        REQUIRE(m.size() == 1);
+        REQUIRE(m.contains(1));
+        REQUIRE(m.count(2) == 0);
+        REQUIRE(m.at(1) == "one");
+        REQUIRE_THROWS_AS(m.at(2), std::out_of_range);
+    }
+
+    SECTION("Emplace, try_emplace, insert_or_assign and subscript") {
+        flat_hash_map<std::string, std::string> m;
+        REQUIRE(m.emplace("a", "1").second);
+        REQUIRE_FALSE(m.emplace("a", "2").second);
+        REQUIRE(m.try_emplace("b", 3, 'x').second);
+        REQUIRE(m["b"] == "xxx");
+        REQUIRE_FALSE(m.insert_or_assign("b", "y").second);
+        REQUIRE(m["b"] == "y");
+        m["c"] = "z";
+        REQUIRE(m.size() == 3);
+        REQUIRE(m["missing"].empty());
+        REQUIRE(m.size() == 4);
+    }
+
+    SECTION("Grows and agrees with std::unordered_map") {
+        flat_hash_map<int, int> m;
+        std::unordered_map<int, int> ref;
+        for (int i = 0; i < 10000; ++i) {
+            int key = (i * 7919) % 5003;
+            m[key] += i;
+            ref[key] += i;
+        }
+        REQUIRE(m.size() == ref.size());
+        REQUIRE(m.load_factor() <= 0.875f);
+        for (const auto &kv : ref) {
+            auto it = m.find(kv.first);
+            REQUIRE(it != m.end());
+            REQUIRE(it->second == kv.second);
+        }
+        std::size_t visited = 0;
+        for (const auto &kv : m) {
+            REQUIRE(ref.at(kv.first) == kv.second);
+            ++visited;
+        }
+        REQUIRE(visited == m.size());
+    }
+
+    SECTION("Erase by key and by iterator") {
+        flat_hash_map<int, int> m;
+        for (int i = 0; i < 100; ++i) m[i] = i;
+        REQUIRE(m.erase(5) == 1);
+        REQUIRE(m.erase(5) == 0);
+        REQUIRE_FALSE(m.contains(5));
+        for (auto it = m.begin(); it != m.end();) {
+            if (it->first % 2 == 0) {
+                it = m.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        REQUIRE(m.size() == 49);
+        for (int i = 0; i < 100; ++i) REQUIRE(m.contains(i) == (i % 2 == 1 && i != 5));
+    }
+
+    SECTION("Lookups probe past tombstones") {
+        flat_hash_map<int, int, constant_hash> m;
+        for (int i = 0; i < 40; ++i) m[i] = i;
+        for (int i = 0; i < 40; i += 2) m.erase(i);
+        for (int i = 1; i < 40; i += 2) REQUIRE(m.at(i) == i);
+        for (int round = 0; round < 50; ++round) {
+            m[100 + round] = round;
+            m.erase(100 + round);
+        }
+        REQUIRE(m.size() == 20);
+        for (int i = 0; i < 40; ++i) REQUIRE(m.contains(i) == (i % 2 == 1));
+    }
+
+    SECTION("Churn does not grow the table") {
+        flat_hash_map<int, int> m;
+        m.reserve(100);
+        std::size_t capacity = m.capacity();
+        for (int i = 0; i < 100000; ++i) {
+            m[i] = i;
+            if (i >= 50) m.erase(i - 50);
+        }
+        REQUIRE(m.size() == 50);
+        REQUIRE(m.capacity() == capacity);
+    }
+
+    SECTION("Reserve avoids rehashing") {
+        flat_hash_map<int, int> m;
+        m.reserve(1000);
+        std::size_t capacity = m.capacity();
+        REQUIRE(capacity * 7 / 8 >= 1000);
+        m[0] = 0;
+        int *first = &m[0];
+        for (int i = 1; i < 1000; ++i) m[i] = i;
+        REQUIRE(m.capacity() == capacity);
+        REQUIRE(&m[0] == first);
+        m.rehash(0);
+        REQUIRE(m.size() == 1000);
+        REQUIRE(m.at(999) == 999);
+    }
+
+    SECTION("Heterogeneous lookup") {
+        flat_hash_map<std::string, int, string_hash, string_equal> m;
+        m["alpha"] = 1;
+        m["beta"] = 2;
+        std::string_view key = "alpha";
+        REQUIRE(m.find(key) != m.end());
+        REQUIRE(m.find(key)->second == 1);
+        REQUIRE(m.contains("beta"));
+        REQUIRE(m.count(std::string_view("gamma")) == 0);
+        REQUIRE(m.erase(std::string_view("beta")) == 1);
+        REQUIRE(m.size() == 1);
+        const auto &cm = m;
+        REQUIRE(cm.find(key) != cm.end());
+    }
+
+    SECTION("Copy, move and compare") {
+        flat_hash_map<int, std::string> a{{1, "a"}, {2, "b"}, {3, "c"}};
+        flat_hash_map<int, std::string> b(a);
+        REQUIRE(a == b);
+        b[4] = "d";
+        REQUIRE(a != b);
+        flat_hash_map<int, std::string> c(std::move(b));
+        REQUIRE(b.empty());
+        REQUIRE(c.size() == 4);
+        b = c;
+        REQUIRE(b == c);
+        a = std::move(c);
+        REQUIRE(a.size() == 4);
+        REQUIRE(a.at(4) == "d");
+        swap(a, b);
+        REQUIRE(a == b);
+    }
+
+    SECTION("A throwing key copy leaves a rehash undone") {
+        fragile_key::live = 0;
+        {
+            flat_hash_map<fragile_key, int, fragile_hash> m;
+            fragile_key::copies_left = 1000;
+            for (int i = 0; i < 14; ++i) m.try_emplace(fragile_key(i), i);
+            REQUIRE(m.capacity() == 16);
+
+            fragile_key::copies_left = 3;
+            REQUIRE_THROWS_AS(m.try_emplace(fragile_key(14), 14), std::runtime_error);
+            REQUIRE(m.size() == 14);
+            REQUIRE(m.capacity() == 16);
+            REQUIRE(fragile_key::live == 14);
+            for (int i = 0; i < 14; ++i) REQUIRE(m.at(fragile_key(i)) == i);
+
+            fragile_key::copies_left = 1000;
+            REQUIRE(m.try_emplace(fragile_key(14), 14).second);
+            REQUIRE(m.capacity() == 32);
+            for (int i = 0; i < 15; ++i) REQUIRE(m.at(fragile_key(i)) == i);
+        }
+        REQUIRE(fragile_key::live == 0);
+    }
+
+    SECTION("Growing moves keys instead of copying them") {
+        flat_hash_map<movable_key, int, movable_hash> m;
+        movable_key::copies = 0;
+        for (int i = 0; i < 1000; ++i) m.try_emplace(movable_key(std::to_string(i) + " is a key long enough to live on the heap"), i);
+        REQUIRE(movable_key::copies == 0);
+        for (int i = 0; i < 1000; ++i) REQUIRE(m.at(movable_key(std::to_string(i) + " is a key long enough to live on the heap")) == i);
+    }
+
+    SECTION("Destroys every element") {
+        counted::live = 0;
+        {
+            flat_hash_map<int, counted> m;
+            for (int i = 0; i < 500; ++i) m.try_emplace(i, i);
+            for (int i = 0; i < 500; i += 3) m.erase(i);
+            REQUIRE(counted::live == static_cast<int>(m.size()));
+            m.clear();
+            REQUIRE(counted::live == 0);
+            REQUIRE(m.empty());
+            for (int i = 0; i < 10; ++i) m.try_emplace(i, i);
+        }
+        REQUIRE(counted::live == 0);
+    }
+}
@@ -0,0 +1,124 @@
+#include <tinystl/intrusive_ptr.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct node : intrusive_ref_counter<node> {
+    static int live;
+    int value;
+
+    explicit node(int v) : value(v) { ++live; }
+    node(const node& other) : intrusive_ref_counter<node>(other), value(other.value) { ++live; }
+    virtual ~node() { --live; }
+};
+
+int node::live = 0;
+
+struct derived_node : node {
+    explicit derived_node(int v) : node(v) {}
+};
+
+struct local_node : intrusive_ref_counter<local_node, plain_count_policy> {
+    int value = 0;
+};
+
+}  // namespace
+
+TEST_CASE("Intrusive Ptr Tests", "[intrusive_ptr]") {
+    SECTION("Pointer sized handle") {
+        REQUIRE(sizeof(intrusive_ptr<node>) == sizeof(node*));
+    }
+
+    SECTION("Default constructor") {
+        intrusive_ptr<node> ptr;
+        REQUIRE(ptr.get() == nullptr);
+        REQUIRE_FALSE(ptr);
+    }
+
+    SECTION("Reference counting") {
+        {
+            auto ptr = make_intrusive<node>(1);
+            REQUIRE(ptr->use_count() == 1);
+            REQUIRE(node::live == 1);
+
+            intrusive_ptr<node> copy(ptr);
+            REQUIRE(ptr->use_count() == 2);
+            REQUIRE(copy == ptr);
+
+            intrusive_ptr<node> moved(std::move(copy));
+            REQUIRE(copy.get() == nullptr);
+            REQUIRE(ptr->use_count() == 2);
+
+            moved.reset();
+            REQUIRE(ptr->use_count() == 1);
+        }
+        REQUIRE(node::live == 0);
+    }
+
+    SECTION("Adopting a raw pointer keeps the count in the object") {
+        node* raw = new node(2);
+        intrusive_ptr<node> a(raw);
+        intrusive_ptr<node> b(raw);
+        REQUIRE(raw->use_count() == 2);
+
+        node* detached = b.detach();
+        REQUIRE(detached == raw);
+        REQUIRE(raw->use_count() == 2);
+        intrusive_ptr<node> c(detached, false);
+        REQUIRE(raw->use_count() == 2);
+    }
+
+    SECTION("Assignment and reset") {
+        auto a = make_intrusive<node>(1);
+        auto b = make_intrusive<node>(2);
+        a = b;
+        REQUIRE(node::live == 1);
+        REQUIRE(b->use_count() == 2);
+        a = a;
+        REQUIRE(b->use_count() == 2);
+        a.reset(new node(3));
+        REQUIRE(a->value == 3);
+        REQUIRE(b->use_count() == 1);
+        a.swap(b);
+        REQUIRE(a->value == 2);
+        REQUIRE(b->value == 3);
+    }
+
+    SECTION("Copying an object does not copy its count") {
+        auto a = make_intrusive<node>(4);
+        node copy(*a);
+        REQUIRE(copy.use_count() == 0);
+    }
+
+    SECTION("Derived to base conversion") {
+        intrusive_ptr<derived_node> d = make_intrusive<derived_node>(5);
+        intrusive_ptr<node> b(d);
+        REQUIRE(b->value == 5);
+        REQUIRE(d->use_count() == 2);
+    }
+
+    SECTION("Non-atomic policy") {
+        auto a = make_intrusive<local_node>();
+        intrusive_ptr<local_node> b(a);
+        REQUIRE(a->use_count() == 2);
+    }
+
+    SECTION("Copies from many threads") {
+        auto ptr = make_intrusive<node>(6);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([ptr] {
+                for (int i = 0; i < 10000; ++i) {
+                    intrusive_ptr<node> copy(ptr);
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        REQUIRE(ptr->use_count() == 1);
+    }
+}
@@ -1,11 +1,50 @@
+#include <tinystl/arena.h>
 #include <tinystl/memory.h>
 #include <catch2/catch_all.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 /*
  * WARN: this test is generated by Github Copilot.
  */
 
 using namespace tinystl;
+
+namespace {
+
+struct allocation_counter {
+    int allocations = 0;
+    int deallocations = 0;
+};
+
+template <typename T>
+struct counting_allocator {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = counting_allocator<U>;
+    };
+
+    allocation_counter* counter;
+
+    explicit counting_allocator(allocation_counter* c) : counter(c) {}
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) : counter(other.counter) {}
+
+    T* allocate(std::size_t n) {
+        counter->allocations += 1;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) {
+        counter->deallocations += 1;
+        ::operator delete(p);
+    }
+};
+
+}  // namespace
+
 TEST_CASE("Unique Ptr Tests", "[memory]") {
     SECTION("Default constructor") {
         unique_ptr<int> ptr;
@@ -58,6 +97,57 @@ TEST_CASE("Unique Ptr Tests", "[memory]") {
         auto ptr = make_unique<int>(42);
         REQUIRE(*ptr == 42);
     }
+
+    SECTION("Swap") {
+        unique_ptr<int> ptr1(new int(1));
+        unique_ptr<int> ptr2(new int(2));
+        ptr1.swap(ptr2);
+        REQUIRE(*ptr1 == 2);
+        REQUIRE(*ptr2 == 1);
+    }
+
+    SECTION("Stateless deleters take no space") {
+        REQUIRE(sizeof(unique_ptr<int>) == sizeof(int*));
+        REQUIRE(sizeof(unique_ptr<int[]>) == sizeof(int*));
+    }
+
+    SECTION("Stateful deleter") {
+        struct counting_deleter {
+            int* deleted;
+            void operator()(int* p) const {
+                *deleted += 1;
+                delete p;
+            }
+        };
+
+        int deleted = 0;
+        {
+            unique_ptr<int, counting_deleter> ptr1(new int(1), counting_deleter{&deleted});
+            REQUIRE(ptr1.get_deleter().deleted == &deleted);
+
+            unique_ptr<int, counting_deleter> ptr2(std::move(ptr1));
+            REQUIRE(ptr1.get() == nullptr);
+            REQUIRE(ptr2.get_deleter().deleted == &deleted);
+
+            ptr2.reset(new int(2));
+            REQUIRE(deleted == 1);
+        }
+        REQUIRE(deleted == 2);
+    }
+
+    SECTION("Array") {
+        unique_ptr<int[]> arr(new int[4]{1, 2, 3, 4});
+        REQUIRE(arr[2] == 3);
+        arr[2] = 7;
+        REQUIRE(arr.get()[2] == 7);
+
+        auto made = make_unique<std::string[]>(3);
+        REQUIRE(made[0].empty());
+        made[1] = "x";
+        unique_ptr<std::string[]> moved(std::move(made));
+        REQUIRE_FALSE(made);
+        REQUIRE(moved[1] == "x");
+    }
 }
 
 TEST_CASE("Shared Ptr Tests") {
@@ -107,6 +197,13 @@ TEST_CASE("Shared Ptr Tests") {
         REQUIRE(*ptr2 == 42);
     }
 
+    SECTION("Moves do not throw") {
+        static_assert(std::is_nothrow_move_constructible<shared_ptr<int>>::value, "");
+        static_assert(std::is_nothrow_move_assignable<shared_ptr<int>>::value, "");
+        static_assert(std::is_nothrow_move_constructible<weak_ptr<int>>::value, "");
+        static_assert(std::is_nothrow_move_assignable<weak_ptr<int>>::value, "");
+    }
+
     SECTION("Reset") {
         shared_ptr<int> ptr(new int(42));
         ptr.reset();
@@ -135,6 +232,149 @@ TEST_CASE("Shared Ptr Tests") {
         REQUIRE(ptr.use_count() == 1);
     }
 
+    SECTION("Tinystl make shared") {
+        auto ptr = make_shared<std::string>(3, 'x');
+        REQUIRE(*ptr == "xxx");
+        REQUIRE(ptr->size() == 3);
+        REQUIRE(ptr.use_count() == 1);
+
+        shared_ptr<std::string> copy(ptr);
+        REQUIRE(copy.get() == ptr.get());
+        REQUIRE(ptr.use_count() == 2);
+    }
+
+    SECTION("Make shared destroys the object with the last owner") {
+        struct tracked {
+            int *destroyed;
+            explicit tracked(int *d) : destroyed(d) {}
+            ~tracked() { *destroyed += 1; }
+        };
+
+        int destroyed = 0;
+        weak_ptr<tracked> weak;
+        {
+            auto ptr = tinystl::make_shared<tracked>(&destroyed);
+            weak = weak_ptr<tracked>(ptr);
+            auto locked = weak.lock();
+            REQUIRE(locked.get() == ptr.get());
+            REQUIRE(destroyed == 0);
+        }
+        REQUIRE(destroyed == 1);
+        REQUIRE(weak.expired());
+        REQUIRE(weak.lock().get() == nullptr);
+        weak.reset();
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("Custom deleter") {
+        int deleted = 0;
+        {
+            shared_ptr<int> ptr(new int(5), [&deleted](int* p) {
+                deleted += 1;
+                delete p;
+            });
+            shared_ptr<int> copy(ptr);
+            REQUIRE(*copy == 5);
+        }
+        REQUIRE(deleted == 1);
+    }
+
+    SECTION("Pointers with different deleters convert") {
+        struct counting_deleter {
+            int* deleted;
+            void operator()(int* p) const {
+                *deleted += 1;
+                delete p;
+            }
+        };
+        int deleted = 0;
+        {
+            shared_ptr<int, counting_deleter> ptr(new int(9), counting_deleter{&deleted});
+            weak_ptr<int> weak(ptr);
+            shared_ptr<int, counting_deleter> locked = weak.lock();
+            REQUIRE(locked.get() == ptr.get());
+            REQUIRE(ptr.use_count() == 2);
+
+            shared_ptr<int> plain = ptr;
+            REQUIRE(ptr.use_count() == 3);
+            shared_ptr<int> moved = std::move(locked);
+            REQUIRE(locked.get() == nullptr);
+            REQUIRE(ptr.use_count() == 3);
+
+            shared_ptr<int> assigned;
+            assigned = ptr;
+            REQUIRE(ptr.use_count() == 4);
+            assigned = shared_ptr<int, counting_deleter>(ptr);
+            REQUIRE(ptr.use_count() == 4);
+            plain = std::move(moved);
+            assigned.reset();
+            REQUIRE(ptr.use_count() == 2);
+            ptr.reset();
+            REQUIRE(*plain == 9);
+            REQUIRE(deleted == 0);
+        }
+        REQUIRE(deleted == 1);
+    }
+
+    SECTION("Deleter runs when the control block cannot be built") {
+        struct throwing_move_deleter {
+            int* deleted;
+            explicit throwing_move_deleter(int* d) : deleted(d) {}
+            throwing_move_deleter(const throwing_move_deleter&) = default;
+            throwing_move_deleter(throwing_move_deleter&&) { throw std::runtime_error("move"); }
+            void operator()(int* p) const {
+                *deleted += 1;
+                delete p;
+            }
+        };
+
+        int deleted = 0;
+        allocation_counter counter;
+        throwing_move_deleter deleter(&deleted);
+        REQUIRE_THROWS_AS(shared_ptr<int>(new int(1), deleter, counting_allocator<int>(&counter)), std::runtime_error);
+        REQUIRE(deleted == 1);
+        REQUIRE(counter.allocations == 1);
+        REQUIRE(counter.deallocations == 1);
+    }
+
+    SECTION("Custom deleter and allocator") {
+        monotonic_arena arena;
+        int value = 3;
+        bool deleted = false;
+        {
+            shared_ptr<int> ptr(&value, [&deleted](int*) { deleted = true; }, arena_allocator<int>(arena));
+            REQUIRE(ptr.get() == &value);
+        }
+        REQUIRE(deleted);
+    }
+
+    SECTION("Allocate shared uses one allocation from the allocator") {
+        allocation_counter counter;
+        {
+            auto ptr = tinystl::allocate_shared<std::string>(counting_allocator<std::string>(&counter), "pooled");
+            REQUIRE(*ptr == "pooled");
+            REQUIRE(counter.allocations == 1);
+            weak_ptr<std::string> weak(ptr);
+            ptr.reset();
+            REQUIRE(weak.expired());
+            REQUIRE(counter.deallocations == 0);
+        }
+        REQUIRE(counter.allocations == 1);
+        REQUIRE(counter.deallocations == 1);
+
+        monotonic_arena arena;
+        auto ptr = allocate_shared<int>(arena_allocator<int>(arena), 11);
+        REQUIRE(*ptr == 11);
+    }
+
+    SECTION("Copy of an empty pointer") {
+        shared_ptr<int> empty;
+        shared_ptr<int> copy(empty);
+        REQUIRE(copy.get() == nullptr);
+        REQUIRE_FALSE(copy);
+        REQUIRE(copy.use_count() == 0);
+    }
+
     SECTION("Weak Ptr") {
         shared_ptr<int> sharedPtr(new int(42));
         weak_ptr<int> weakPtr(sharedPtr);
@@ -170,4 +410,67 @@ TEST_CASE("Shared Ptr Tests") {
         }
     }
 
-}
\ No newline at end of file
+    SECTION("Non-atomic count policy") {
+        shared_ptr<int, default_deleter<int>, plain_count_policy> ptr(new int(7));
+        weak_ptr<int, plain_count_policy> weak(ptr);
+        {
+            auto copy = weak.lock();
+            REQUIRE(ptr.use_count() == 2);
+        }
+        REQUIRE(ptr.use_count() == 1);
+        ptr.reset();
+        REQUIRE(weak.expired());
+        REQUIRE_FALSE(weak.lock());
+
+        auto made = make_shared<int, default_deleter<int>, plain_count_policy>(8);
+        REQUIRE(*made == 8);
+    }
+}
+
+TEST_CASE("Shared Ptr Concurrency Tests", "[memory][thread]") {
+    SECTION("Copies from many threads") {
+        struct tracked {
+            std::atomic<int> *destroyed;
+            explicit tracked(std::atomic<int> *d) : destroyed(d) {}
+            ~tracked() { destroyed->fetch_add(1); }
+        };
+
+        std::atomic<int> destroyed{0};
+        std::atomic<int> mismatches{0};
+        auto ptr = tinystl::make_shared<tracked>(&destroyed);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([ptr, &mismatches] {
+                for (int i = 0; i < 10000; ++i) {
+                    shared_ptr<tracked> copy(ptr);
+                    weak_ptr<tracked> weak(copy);
+                    if (weak.lock().get() != copy.get()) mismatches.fetch_add(1);
+                }
+            });
+        }
+        for (auto &t : threads) t.join();
+        REQUIRE(mismatches.load() == 0);
+        REQUIRE(ptr.use_count() == 1);
+        ptr.reset();
+        REQUIRE(destroyed.load() == 1);
+    }
+
+    SECTION("Lock races with the last owner") {
+        std::atomic<int> mismatches{0};
+        for (int round = 0; round < 200; ++round) {
+            auto ptr = make_shared<int>(round);
+            weak_ptr<int> weak(ptr);
+            std::thread locker([weak, round, &mismatches] {
+                for (;;) {
+                    auto locked = weak.lock();
+                    if (!locked) break;
+                    if (*locked != round) mismatches.fetch_add(1);
+                }
+            });
+            ptr.reset();
+            locker.join();
+            REQUIRE(weak.expired());
+        }
+        REQUIRE(mismatches.load() == 0);
+    }
+}
@@ -0,0 +1,156 @@
+#include <tinystl/mmap_allocator.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <string>
+
+using namespace tinystl;
+
+namespace {
+
+bool page_aligned(const void *p, std::size_t page) {
+    return reinterpret_cast<std::uintptr_t>(p) % page == 0;
+}
+
+}  // namespace
+
+TEST_CASE("Mmap Allocator Tests", "[mmap_allocator]") {
+    const std::size_t page = mmap_resource::page_size();
+
+    SECTION("Large requests are mapped and small ones are not") {
+        mmap_resource resource(huge_page_mode::none, 4 * page);
+        void *small = resource.allocate(64);
+        REQUIRE(resource.mapped_bytes() == 0);
+        resource.deallocate(small, 64);
+
+        void *large = resource.allocate(4 * page + 1);
+        REQUIRE(page_aligned(large, page));
+        REQUIRE(resource.mapped_bytes() == 5 * page);
+        std::memset(large, 0x5a, 4 * page + 1);
+        resource.deallocate(large, 4 * page + 1);
+        REQUIRE(resource.mapped_bytes() == 0);
+    }
+
+    SECTION("Reallocate keeps contents across sizes") {
+        mmap_resource resource(huge_page_mode::none, 4 * page);
+        auto *p = static_cast<unsigned char *>(resource.allocate(100));
+        for (std::size_t i = 0; i < 100; ++i) p[i] = static_cast<unsigned char>(i);
+
+        // small to mapped, then grown and shrunk in place, then back to small
+        p = static_cast<unsigned char *>(resource.reallocate(p, 100, 8 * page));
+        REQUIRE(resource.mapped_bytes() == 8 * page);
+        for (std::size_t i = 0; i < 100; ++i) REQUIRE(p[i] == static_cast<unsigned char>(i));
+        p[8 * page - 1] = 0xee;
+
+        p = static_cast<unsigned char *>(resource.reallocate(p, 8 * page, 64 * page));
+        REQUIRE(resource.mapped_bytes() == 64 * page);
+        REQUIRE(p[8 * page - 1] == 0xee);
+        for (std::size_t i = 0; i < 100; ++i) REQUIRE(p[i] == static_cast<unsigned char>(i));
+
+        p = static_cast<unsigned char *>(resource.reallocate(p, 64 * page, 5 * page));
+        REQUIRE(resource.mapped_bytes() == 5 * page);
+        p = static_cast<unsigned char *>(resource.reallocate(p, 5 * page, 50));
+        REQUIRE(resource.mapped_bytes() == 0);
+        for (std::size_t i = 0; i < 50; ++i) REQUIRE(p[i] == static_cast<unsigned char>(i));
+        resource.deallocate(p, 50);
+    }
+
+    SECTION("Decommitted pages read as zero") {
+        mmap_resource resource(huge_page_mode::none, 4 * page);
+        auto *p = static_cast<unsigned char *>(resource.allocate(8 * page));
+        std::memset(p, 0xff, 8 * page);
+        // only the whole pages inside the range are released
+        resource.decommit(p + page / 2, 3 * page);
+        REQUIRE(p[0] == 0xff);
+        REQUIRE(p[page / 2] == 0xff);
+        REQUIRE(p[page] == 0);
+        REQUIRE(p[3 * page - 1] == 0);
+        REQUIRE(p[3 * page] == 0xff);
+        p[page] = 1;
+        REQUIRE(p[page] == 1);
+        resource.deallocate(p, 8 * page);
+    }
+
+    SECTION("Huge page modes map whole huge pages") {
+        for (huge_page_mode mode : {huge_page_mode::transparent, huge_page_mode::hugetlb}) {
+            mmap_resource resource(mode, 4 * page);
+            // hugetlb falls back to ordinary pages when no huge pages are reserved
+            auto *p = static_cast<unsigned char *>(resource.allocate(3 * mmap_resource::huge_page_size / 2));
+            REQUIRE(resource.mapped_bytes() == 2 * mmap_resource::huge_page_size);
+            if (mode == huge_page_mode::transparent) REQUIRE(page_aligned(p, mmap_resource::huge_page_size));
+            p[0] = 1;
+            p[3 * mmap_resource::huge_page_size / 2 - 1] = 2;
+            p = static_cast<unsigned char *>(resource.reallocate(p, 3 * mmap_resource::huge_page_size / 2, 5 * mmap_resource::huge_page_size));
+            REQUIRE(p[0] == 1);
+            REQUIRE(p[3 * mmap_resource::huge_page_size / 2 - 1] == 2);
+            resource.deallocate(p, 5 * mmap_resource::huge_page_size);
+            REQUIRE(resource.mapped_bytes() == 0);
+        }
+    }
+
+    SECTION("Allocators compare by resource") {
+        mmap_resource resource;
+        mmap_allocator<int> a(resource);
+        mmap_allocator<double> b(a);
+        mmap_allocator<int> c;
+        REQUIRE(a == b);
+        REQUIRE(a != c);
+        REQUIRE(b.resource() == &resource);
+        REQUIRE(c.resource() == &default_mmap_resource());
+        REQUIRE(allocator_can_reallocate<mmap_allocator<int>>::value);
+        REQUIRE_FALSE(allocator_can_reallocate<allocator<int>>::value);
+    }
+
+    SECTION("Small blocks keep the alignment of over-aligned types") {
+        struct alignas(64) line {
+            unsigned char bytes[64];
+        };
+        mmap_resource resource(huge_page_mode::none, 4 * page);
+        mmap_allocator<line> alloc(resource);
+        for (std::size_t n : {1u, 3u, 17u}) {
+            line *p = alloc.allocate(n);
+            REQUIRE(page_aligned(p, alignof(line)));
+            alloc.deallocate(p, n);
+        }
+
+        // across the threshold and back, through a copy each way
+        std::size_t small = 2;
+        std::size_t large = 8 * page / sizeof(line);
+        line *p = alloc.allocate(small);
+        p[1].bytes[0] = 9;
+        p = alloc.reallocate(p, small, large);
+        REQUIRE(page_aligned(p, alignof(line)));
+        REQUIRE(p[1].bytes[0] == 9);
+        p = alloc.reallocate(p, large, small);
+        REQUIRE(page_aligned(p, alignof(line)));
+        REQUIRE(p[1].bytes[0] == 9);
+        alloc.deallocate(p, small);
+        REQUIRE(resource.mapped_bytes() == 0);
+    }
+
+    SECTION("Vector grows through reallocate") {
+        mmap_resource resource(huge_page_mode::none, 4 * page);
+        vector<std::uint64_t, mmap_allocator<std::uint64_t>> v{mmap_allocator<std::uint64_t>(resource)};
+        for (std::uint64_t i = 0; i < 100000; ++i) v.push_back(i * 3);
+        REQUIRE(resource.mapped_bytes() >= v.capacity() * sizeof(std::uint64_t));
+        for (std::uint64_t i = 0; i < 100000; ++i) REQUIRE(v[i] == i * 3);
+
+        // pushing an element of the vector itself while it moves
+        v.resize(v.capacity());
+        v.push_back(v[7]);
+        REQUIRE(v.back() == 21);
+
+        v.resize(10);
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 10);
+        REQUIRE(resource.mapped_bytes() == 0);
+        for (std::uint64_t i = 0; i < 10; ++i) REQUIRE(v[i] == i * 3);
+    }
+
+    SECTION("Vector of non-trivial elements relocates as usual") {
+        mmap_resource resource(huge_page_mode::none, 4 * page);
+        vector<std::string, mmap_allocator<std::string>> v{mmap_allocator<std::string>(resource)};
+        for (int i = 0; i < 5000; ++i) v.push_back(std::to_string(i) + " is long enough to live on the heap");
+        for (int i = 0; i < 5000; ++i) REQUIRE(v[i] == std::to_string(i) + " is long enough to live on the heap");
+    }
+}
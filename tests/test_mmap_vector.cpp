@@ -0,0 +1,129 @@
+#include <tinystl/mmap_vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+using namespace tinystl;
+
+namespace {
+
+struct point {
+    double x;
+    double y;
+};
+
+// a fresh path under the temporary directory, removed again on scope exit
+struct temp_file {
+    std::string path;
+
+    explicit temp_file(const char *name)
+        : path((std::filesystem::temp_directory_path() / (std::string("tinystl_") + name + "_" + std::to_string(::getpid()))).string()) {
+        std::remove(path.c_str());
+    }
+    ~temp_file() { std::remove(path.c_str()); }
+};
+
+}  // namespace
+
+TEST_CASE("Mmap Vector Tests", "[mmap_vector]") {
+    SECTION("A new file starts empty") {
+        temp_file file("empty");
+        mmap_vector<int> v(file.path);
+        REQUIRE(v.is_open());
+        REQUIRE_FALSE(v.read_only());
+        REQUIRE(v.empty());
+        REQUIRE(v.begin() == v.end());
+        REQUIRE(std::filesystem::file_size(file.path) == mmap_vector<int>::data_offset);
+    }
+
+    SECTION("Elements persist across opens") {
+        temp_file file("persist");
+        {
+            mmap_vector<std::uint64_t> v(file.path);
+            for (std::uint64_t i = 0; i < 100000; ++i) v.push_back(i * i);
+            v.sync();
+        }
+        mmap_vector<std::uint64_t> v(file.path);
+        REQUIRE(v.size() == 100000);
+        for (std::uint64_t i = 0; i < 100000; ++i) REQUIRE(v[i] == i * i);
+        v.push_back(7);
+        REQUIRE(v.back() == 7);
+        REQUIRE(v.at(3) == 9);
+        REQUIRE_THROWS_AS(v.at(100001), std::out_of_range);
+    }
+
+    SECTION("Growth extends the file") {
+        temp_file file("grow");
+        mmap_vector<point> v(file.path);
+        v.reserve(1000);
+        REQUIRE(v.capacity() >= 1000);
+        REQUIRE(std::filesystem::file_size(file.path) >= mmap_vector<point>::data_offset + 1000 * sizeof(point));
+        REQUIRE(v.size() == 0);
+
+        v.resize(3000, point{1.5, -2.5});
+        REQUIRE(v.size() == 3000);
+        REQUIRE(v[2999].x == 1.5);
+        REQUIRE(v[2999].y == -2.5);
+        // pushing an element of the vector itself while the mapping moves
+        v.resize(v.capacity());
+        v[0] = point{4, 5};
+        v.emplace_back(v[0]);
+        REQUIRE(v.back().x == 4);
+        REQUIRE(v.back().y == 5);
+
+        v.resize(10);
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 10);
+        REQUIRE(std::filesystem::file_size(file.path) == mmap_vector<point>::data_offset + 10 * sizeof(point));
+        v.pop_back();
+        REQUIRE(v.size() == 9);
+        v.clear();
+        REQUIRE(v.empty());
+    }
+
+    SECTION("Read-only vectors refuse to change") {
+        temp_file file("read_only");
+        {
+            mmap_vector<int> v(file.path);
+            v.resize(50, 3);
+        }
+        mmap_vector<int> v(file.path, mmap_mode::read_only);
+        REQUIRE(v.read_only());
+        REQUIRE(v.size() == 50);
+        REQUIRE(v[49] == 3);
+        REQUIRE_THROWS_AS(v.push_back(1), std::logic_error);
+        REQUIRE_THROWS_AS(v.resize(10), std::logic_error);
+        REQUIRE_THROWS_AS(v.clear(), std::logic_error);
+        REQUIRE(v.size() == 50);
+    }
+
+    SECTION("Opening fails for missing or mismatched files") {
+        temp_file file("mismatch");
+        REQUIRE_THROWS_AS(mmap_vector<int>(file.path, mmap_mode::read_only), std::system_error);
+        {
+            mmap_vector<int> v(file.path);
+            v.push_back(1);
+        }
+        REQUIRE_THROWS_AS(mmap_vector<double>(file.path), std::runtime_error);
+        REQUIRE(mmap_vector<int>(file.path).size() == 1);
+    }
+
+    SECTION("Move transfers the mapping") {
+        temp_file file("move");
+        mmap_vector<int> a(file.path);
+        a.push_back(42);
+        mmap_vector<int> b(std::move(a));
+        REQUIRE_FALSE(a.is_open());
+        REQUIRE(a.size() == 0);
+        REQUIRE(b[0] == 42);
+        a = std::move(b);
+        REQUIRE(a[0] == 42);
+        a.close();
+        REQUIRE_FALSE(a.is_open());
+    }
+}
@@ -0,0 +1,146 @@
+#include <tinystl/mpmc_queue.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct throwing_copy {
+    int value;
+
+    throwing_copy(int v) : value(v) {}
+    throwing_copy(const throwing_copy &other) : value(other.value) {
+        if (value < 0) throw std::runtime_error("copy");
+    }
+    throwing_copy(throwing_copy &&other) noexcept : value(other.value) {}
+    throwing_copy &operator=(throwing_copy &&other) noexcept = default;
+};
+
+}  // namespace
+
+TEST_CASE("MPMC Queue Tests", "[mpmc_queue]") {
+    SECTION("Capacity rounds up to a power of two") {
+        REQUIRE(mpmc_queue<int>(1).capacity() == 2);
+        REQUIRE(mpmc_queue<int>(5).capacity() == 8);
+        REQUIRE(mpmc_queue<int>(64).capacity() == 64);
+        REQUIRE_THROWS_AS(mpmc_queue<int>(0), std::invalid_argument);
+    }
+
+    SECTION("FIFO order and bounds") {
+        mpmc_queue<int> q(4);
+        int value = 0;
+        REQUIRE_FALSE(q.try_pop(value));
+        for (int i = 0; i < 4; ++i) REQUIRE(q.try_push(i));
+        REQUIRE_FALSE(q.try_push(4));
+        REQUIRE(q.size_approx() == 4);
+        for (int round = 0; round < 10; ++round) {
+            REQUIRE(q.try_pop(value));
+            REQUIRE(value == round);
+            REQUIRE(q.try_push(round + 4));
+        }
+        REQUIRE(q.size_approx() == 4);
+    }
+
+    SECTION("Batched push and pop") {
+        mpmc_queue<int> q(8);
+        std::vector<int> in{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        REQUIRE(q.push_n(in.begin(), in.size()) == 8);
+        REQUIRE(q.push_n(in.begin() + 8, 2) == 0);
+        std::vector<int> out;
+        REQUIRE(q.pop_n(std::back_inserter(out), 3) == 3);
+        REQUIRE(q.push_n(in.begin() + 8, 2) == 2);
+        REQUIRE(q.pop_n(std::back_inserter(out), 100) == 7);
+        REQUIRE(out == in);
+        REQUIRE(q.empty_approx());
+    }
+
+    SECTION("Non-trivial elements are moved and destroyed") {
+        mpmc_queue<std::string> q(4);
+        std::string long_string(100, 'x');
+        REQUIRE(q.try_push(long_string));
+        REQUIRE(q.try_emplace(50, 'y'));
+        REQUIRE(q.try_push(std::string(60, 'z')));
+        std::string out;
+        REQUIRE(q.try_pop(out));
+        REQUIRE(out == long_string);
+        // the queue is destroyed with two strings still inside
+    }
+
+    SECTION("A throwing copy leaves the queue untouched") {
+        mpmc_queue<throwing_copy> q(4);
+        throwing_copy bad(-1);
+        REQUIRE_THROWS_AS(q.try_push(bad), std::runtime_error);
+        REQUIRE(q.empty_approx());
+        std::vector<throwing_copy> in;
+        for (int v : {1, 2, -3}) in.emplace_back(v);
+        REQUIRE_THROWS_AS(q.push_n(in.begin(), in.size()), std::runtime_error);
+        REQUIRE(q.size_approx() == 2);
+        throwing_copy out(0);
+        REQUIRE(q.try_pop(out));
+        REQUIRE(out.value == 1);
+    }
+
+    SECTION("Concurrent producers and consumers") {
+        constexpr int producers = 4;
+        constexpr int consumers = 4;
+        constexpr std::uint64_t per_producer = 50000;
+        mpmc_queue<std::uint64_t> q(256);
+        std::atomic<std::uint64_t> sum{0};
+        std::atomic<std::uint64_t> popped{0};
+        std::atomic<int> out_of_order{0};
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                std::uint64_t next = 0;
+                std::uint64_t batch[8];
+                while (next < per_producer) {
+                    if (next % 3 == 0) {
+                        std::size_t n = 0;
+                        for (; n < 8 && next + n < per_producer; ++n) batch[n] = (std::uint64_t(p) << 32) | (next + n);
+                        next += q.push_n(batch, n);
+                    } else if (q.try_push((std::uint64_t(p) << 32) | next)) {
+                        ++next;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                std::uint64_t last[producers];
+                for (auto &l : last) l = ~std::uint64_t(0);
+                std::uint64_t batch[16];
+                while (popped.load(std::memory_order_relaxed) < producers * per_producer) {
+                    std::size_t n = q.pop_n(batch, 16);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (std::size_t i = 0; i < n; ++i) {
+                        std::uint64_t producer = batch[i] >> 32;
+                        std::uint64_t seq = batch[i] & 0xffffffffu;
+                        // a single consumer sees each producer's elements in order
+                        if (last[producer] != ~std::uint64_t(0) && seq <= last[producer]) out_of_order.fetch_add(1);
+                        last[producer] = seq;
+                        sum.fetch_add(seq, std::memory_order_relaxed);
+                    }
+                    popped.fetch_add(n, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto &t : threads) t.join();
+
+        REQUIRE(popped.load() == producers * per_producer);
+        REQUIRE(sum.load() == producers * (per_producer * (per_producer - 1) / 2));
+        REQUIRE(out_of_order.load() == 0);
+        REQUIRE(q.empty_approx());
+    }
+}
@@ -0,0 +1,129 @@
+#include <tinystl/object_pool.h>
+#include <catch2/catch_all.hpp>
+#include <stdexcept>
+#include <string>
+
+using namespace tinystl;
+
+namespace {
+
+struct message {
+    static int constructed;
+    static int destroyed;
+    int id;
+    std::string body;
+
+    explicit message(int i = 0) : id(i) {
+        if (i < 0) throw std::runtime_error("message");
+        ++constructed;
+    }
+    ~message() { ++destroyed; }
+};
+
+int message::constructed = 0;
+int message::destroyed = 0;
+
+struct clear_message {
+    void operator()(message &m) const noexcept {
+        m.id = 0;
+        m.body.clear();
+    }
+};
+
+void reset_counts() {
+    message::constructed = 0;
+    message::destroyed = 0;
+}
+
+}  // namespace
+
+TEST_CASE("Object Pool Tests", "[object_pool]") {
+    SECTION("Released slots are handed out again") {
+        reset_counts();
+        {
+            object_pool<message> pool(4);
+            object_pool<message>::handle a = pool.acquire(1);
+            REQUIRE(a->id == 1);
+            REQUIRE(pool.in_use() == 1);
+            REQUIRE(pool.capacity() == 4);
+            message *slot = a.get();
+            a.reset();
+            REQUIRE(pool.in_use() == 0);
+            REQUIRE(message::destroyed == 1);
+
+            auto b = pool.acquire(2);
+            REQUIRE(b.get() == slot);
+            REQUIRE(b->id == 2);
+            REQUIRE(b.get_deleter().pool() == &pool);
+        }
+        REQUIRE(message::constructed == 2);
+        REQUIRE(message::destroyed == 2);
+    }
+
+    SECTION("The pool grows in chunks") {
+        object_pool<int> pool(2);
+        vector<object_pool<int>::handle> handles;
+        for (int i = 0; i < 100; ++i) handles.push_back(pool.acquire(i));
+        REQUIRE(pool.in_use() == 100);
+        REQUIRE(pool.capacity() >= 100);
+        for (int i = 0; i < 100; ++i) REQUIRE(*handles[i] == i);
+        handles.clear();
+        REQUIRE(pool.in_use() == 0);
+
+        // reusing never grows the pool again
+        std::size_t capacity = pool.capacity();
+        for (int i = 0; i < 100; ++i) handles.push_back(pool.acquire(i));
+        REQUIRE(pool.capacity() == capacity);
+    }
+
+    SECTION("Reserve keeps the slots left in the current chunk") {
+        object_pool<int> pool(8);
+        auto a = pool.acquire(1);
+        pool.reserve(100);
+        REQUIRE(pool.capacity() == 100);
+        vector<object_pool<int>::handle> handles;
+        for (int i = 0; i < 99; ++i) handles.push_back(pool.acquire(i));
+        REQUIRE(pool.capacity() == 100);
+        REQUIRE(pool.in_use() == 100);
+    }
+
+    SECTION("A throwing constructor leaves the slot free") {
+        reset_counts();
+        object_pool<message> pool(1);
+        REQUIRE_THROWS_AS(pool.acquire(-1), std::runtime_error);
+        REQUIRE(pool.in_use() == 0);
+        auto a = pool.acquire(1);
+        a.reset();
+        REQUIRE_THROWS_AS(pool.acquire(-1), std::runtime_error);
+        auto b = pool.acquire(3);
+        REQUIRE(pool.capacity() == 1);
+        REQUIRE(b->id == 3);
+    }
+
+    SECTION("Reset mode keeps objects and their buffers") {
+        reset_counts();
+        {
+            object_pool<message, clear_message> pool(4);
+            auto a = pool.acquire();
+            a->id = 9;
+            a->body.assign(1000, 'x');
+            const char *buffer = a->body.data();
+            message *slot = a.get();
+            a.reset();
+            REQUIRE(message::destroyed == 0);
+
+            auto b = pool.acquire();
+            REQUIRE(b.get() == slot);
+            REQUIRE(b->id == 0);
+            REQUIRE(b->body.empty());
+            REQUIRE(b->body.capacity() >= 1000);
+            REQUIRE(b->body.data() == buffer);
+            REQUIRE(message::constructed == 1);
+
+            // objects for the rest of the chunk are built when the pool moves on
+            pool.reserve(10);
+            REQUIRE(message::constructed == 4);
+        }
+        REQUIRE(message::destroyed == message::constructed);
+    }
+}
@@ -0,0 +1,116 @@
+#include <tinystl/parallel.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace tinystl;
+
+TEST_CASE("Parallel Algorithm Tests", "[parallel]") {
+    thread_pool pool(4);
+
+    SECTION("Grain adapts to the input size") {
+        REQUIRE(parallel_grain(0, pool) == parallel_min_grain);
+        REQUIRE(parallel_grain(10, pool) == parallel_min_grain);
+        REQUIRE(parallel_grain(400000, pool) == 10000);
+        REQUIRE(parallel_grain(400001, pool) == 10001);
+    }
+
+    SECTION("Small inputs stay on the calling thread") {
+        std::thread::id caller = std::this_thread::get_id();
+        vector<std::thread::id> seen(parallel_min_grain);
+        parallel_for_each(pool, seen.begin(), seen.end(), [](std::thread::id &id) { id = std::this_thread::get_id(); });
+        REQUIRE(std::all_of(seen.begin(), seen.end(), [caller](std::thread::id id) { return id == caller; }));
+    }
+
+    SECTION("for_each visits every element once") {
+        vector<int> v(100000, 1);
+        parallel_for_each(pool, v.begin(), v.end(), [](int &x) { x += 1; });
+        REQUIRE(std::all_of(v.begin(), v.end(), [](int x) { return x == 2; }));
+
+        vector<int> empty;
+        parallel_for_each(pool, empty.begin(), empty.end(), [](int &x) { x = 0; });
+        vector<int> one(1, 5);
+        parallel_for_each(one.begin(), one.end(), [](int &x) { x = 6; });
+        REQUIRE(one[0] == 6);
+    }
+
+    SECTION("transform") {
+        vector<int> in(12345);
+        std::iota(in.begin(), in.end(), 0);
+        vector<long> out(in.size());
+        auto end = parallel_transform(pool, in.begin(), in.end(), out.begin(), [](int x) { return long(x) * x; });
+        REQUIRE(end == out.end());
+        for (std::size_t i = 0; i < in.size(); ++i) REQUIRE(out[i] == long(i) * long(i));
+    }
+
+    SECTION("reduce combines in order") {
+        vector<std::uint64_t> v(1000000);
+        std::iota(v.begin(), v.end(), 1);
+        REQUIRE(parallel_reduce(pool, v.begin(), v.end(), std::uint64_t(0)) == 1000000ull * 1000001ull / 2);
+        REQUIRE(parallel_reduce(pool, v.begin(), v.begin(), std::uint64_t(7)) == 7);
+
+        vector<std::string> words;
+        for (int i = 0; i < 20000; ++i) words.push_back(std::to_string(i % 10));
+        std::string expected = std::accumulate(words.begin(), words.end(), std::string(">"));
+        REQUIRE(parallel_reduce(pool, words.begin(), words.end(), std::string(">")) == expected);
+    }
+
+    SECTION("sort") {
+        std::mt19937 rng(7);
+        for (std::size_t n : {0u, 1u, 2u, 3u, 100u, 4097u, 200000u}) {
+            vector<int> v(n);
+            for (auto &x : v) x = static_cast<int>(rng() % 1000);
+            vector<int> expected(v);
+            std::sort(expected.begin(), expected.end());
+            parallel_sort(pool, v.begin(), v.end());
+            REQUIRE(v == expected);
+        }
+
+        vector<std::string> s;
+        for (int i = 0; i < 5000; ++i) s.push_back(std::to_string(rng()));
+        vector<std::string> expected(s);
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+        parallel_sort(s.begin(), s.end(), std::greater<>());
+        REQUIRE(s == expected);
+    }
+
+    SECTION("inclusive_scan") {
+        for (std::size_t n : {0u, 1u, 7u, 100u, 33333u}) {
+            vector<long> v(n);
+            std::iota(v.begin(), v.end(), 1);
+            vector<long> out(n);
+            auto end = parallel_inclusive_scan(pool, v.begin(), v.end(), out.begin());
+            REQUIRE(end == out.end());
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(out[i] == long(i + 1) * long(i + 2) / 2);
+            // in place
+            parallel_inclusive_scan(pool, v.begin(), v.end(), v.begin());
+            REQUIRE(v == out);
+        }
+
+        vector<std::string> letters;
+        for (int i = 0; i < 5000; ++i) letters.push_back(std::string(1, char('a' + i % 26)));
+        vector<std::string> out(letters.size());
+        parallel_inclusive_scan(pool, letters.begin(), letters.end(), out.begin());
+        std::string running;
+        for (std::size_t i = 0; i < letters.size(); ++i) {
+            running += letters[i];
+            REQUIRE(out[i] == running);
+        }
+    }
+
+    SECTION("Exceptions propagate to the caller") {
+        vector<int> v(100000, 0);
+        v[77777] = 1;
+        REQUIRE_THROWS_AS(parallel_for_each(pool, v.begin(), v.end(),
+                                            [](int x) {
+                                                if (x == 1) throw std::runtime_error("bad element");
+                                            }),
+                          std::runtime_error);
+    }
+}
@@ -0,0 +1,84 @@
+#include <tinystl/pool_allocator.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tinystl;
+
+TEST_CASE("Pool Allocator Tests", "[pool_allocator]") {
+    SECTION("Size classes") {
+        REQUIRE(size_class_pool::size_class(1) == 0);
+        REQUIRE(size_class_pool::size_class(16) == 0);
+        REQUIRE(size_class_pool::size_class(17) == 1);
+        REQUIRE(size_class_pool::block_size(size_class_pool::size_class(200)) == 208);
+    }
+
+    SECTION("Allocate and deallocate") {
+        pool_allocator<int> alloc;
+        int *p = alloc.allocate(5);
+        REQUIRE(p != nullptr);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % size_class_pool::alignment == 0);
+        alloc.deallocate(p, 5);
+        REQUIRE(alloc.allocate(0) == nullptr);
+    }
+
+    SECTION("Freed blocks are reused by the same size class") {
+        size_class_pool pool;
+        void *p1 = pool.allocate(24);
+        void *p2 = pool.allocate(24);
+        REQUIRE(p1 != p2);
+        pool.deallocate(p1, 24);
+        REQUIRE(pool.allocate(32) == p1);
+        pool.deallocate(p2, 24);
+        REQUIRE(pool.allocate(48) != p2);
+    }
+
+    SECTION("Blocks of one class do not overlap") {
+        size_class_pool pool;
+        std::vector<char *> blocks;
+        for (int i = 0; i < 10000; ++i) {
+            char *p = static_cast<char *>(pool.allocate(64));
+            std::memset(p, i & 0xff, 64);
+            blocks.push_back(p);
+        }
+        for (int i = 0; i < 10000; ++i) {
+            REQUIRE(static_cast<unsigned char>(blocks[i][0]) == (i & 0xff));
+            REQUIRE(static_cast<unsigned char>(blocks[i][63]) == (i & 0xff));
+        }
+        for (char *p : blocks) pool.deallocate(p, 64);
+    }
+
+    SECTION("Large requests bypass the pool") {
+        pool_allocator<double> alloc;
+        double *p = alloc.allocate(1000);
+        p[999] = 1.0;
+        alloc.deallocate(p, 1000);
+    }
+
+    SECTION("Construct and destroy") {
+        pool_allocator<std::string> alloc;
+        std::string *p = alloc.allocate(1);
+        alloc.construct(p, "Hello, Pool!");
+        REQUIRE(*p == "Hello, Pool!");
+        REQUIRE(alloc.address(*p) == p);
+        alloc.destroy(p);
+        alloc.deallocate(p, 1);
+    }
+
+    SECTION("Rebind and compare") {
+        pool_allocator<int> a;
+        pool_allocator<int>::rebind<double>::other b(a);
+        REQUIRE(a == b);
+        REQUIRE_FALSE(a != b);
+    }
+
+    SECTION("As a container allocator") {
+        tinystl::vector<std::string, pool_allocator<std::string>> v;
+        for (int i = 0; i < 100; ++i) v.push_back(std::to_string(i));
+        REQUIRE(v.size() == 100);
+        REQUIRE(v[42] == "42");
+    }
+}
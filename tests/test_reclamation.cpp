@@ -0,0 +1,204 @@
+#include <tinystl/reclamation.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct tracked {
+    static std::atomic<int> live;
+    int value;
+
+    explicit tracked(int v = 0) : value(v) { ++live; }
+    ~tracked() { --live; }
+};
+
+std::atomic<int> tracked::live {0};
+
+struct counting_deleter {
+    int *count;
+    void operator()(tracked *p) const {
+        ++*count;
+        delete p;
+    }
+};
+
+// Treiber stack whose pop retires the unlinked node through Domain
+template <typename Domain, typename Guard>
+class lock_free_stack {
+public:
+    struct node {
+        tracked value;
+        node *next;
+    };
+
+    explicit lock_free_stack(Domain &domain) : domain_(domain) {}
+    ~lock_free_stack() {
+        for (node *n = head_.load(); n != nullptr;) {
+            node *next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    void push(int v) {
+        node *n = new node{tracked(v), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    bool pop(int &out) {
+        Guard guard(domain_);
+        node *n = protect(guard);
+        while (n != nullptr) {
+            if (head_.compare_exchange_strong(n, n->next, std::memory_order_acquire, std::memory_order_relaxed)) break;
+            n = protect(guard);
+        }
+        if (n == nullptr) return false;
+        out = n->value.value;
+        domain_.retire(n);
+        return true;
+    }
+
+private:
+    node *protect(Guard &guard) {
+        if constexpr (std::is_same<Guard, hazard_guard>::value) {
+            return guard.protect(head_);
+        } else {
+            return head_.load(std::memory_order_acquire);
+        }
+    }
+
+private:
+    Domain &domain_;
+    std::atomic<node *> head_ {nullptr};
+};
+
+template <typename Domain, typename Guard>
+void stress(Domain &domain) {
+    lock_free_stack<Domain, Guard> stack(domain);
+    constexpr int per_thread = 5000;
+    std::atomic<long> popped_sum {0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                stack.push(t * per_thread + i);
+                int v;
+                if (stack.pop(v)) popped_sum.fetch_add(v);
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    int v;
+    while (stack.pop(v)) popped_sum.fetch_add(v);
+    long n = 4L * per_thread;
+    REQUIRE(popped_sum == n * (n - 1) / 2);
+}
+
+}  // namespace
+
+TEST_CASE("Reclamation Tests", "[reclamation]") {
+    SECTION("Epoch domain waits for guards") {
+        {
+            epoch_domain domain;
+            tracked *p = new tracked(1);
+            std::atomic<bool> entered {false};
+            std::atomic<bool> release {false};
+            std::thread reader([&] {
+                epoch_guard guard(domain);
+                entered = true;
+                while (!release) std::this_thread::yield();
+            });
+            while (!entered) std::this_thread::yield();
+
+            domain.retire(p);
+            domain.reclaim();
+            REQUIRE(tracked::live == 1);
+
+            release = true;
+            reader.join();
+            domain.reclaim();
+            REQUIRE(tracked::live == 0);
+        }
+        REQUIRE(tracked::live == 0);
+    }
+
+    SECTION("Epoch domain reclaims in batches") {
+        epoch_domain domain;
+        int deleted = 0;
+        for (std::size_t i = 0; i < 4 * epoch_domain::reclaim_threshold; ++i) {
+            epoch_guard guard(domain);
+            domain.retire(new tracked(0), counting_deleter{&deleted});
+        }
+        REQUIRE(deleted > 0);
+        REQUIRE(domain.epoch() > 0);
+    }
+
+    SECTION("Domains free what is left when destroyed") {
+        int deleted = 0;
+        {
+            epoch_domain e;
+            hazard_domain h;
+            e.retire(new tracked(1), counting_deleter{&deleted});
+            h.retire(new tracked(2), counting_deleter{&deleted});
+        }
+        REQUIRE(deleted == 2);
+        REQUIRE(tracked::live == 0);
+    }
+
+    SECTION("Hazard pointers keep protected nodes") {
+        hazard_domain domain;
+        tracked *a = new tracked(1);
+        tracked *b = new tracked(2);
+        std::atomic<tracked *> src {a};
+        {
+            hazard_guard guard(domain);
+            REQUIRE(guard.protect(src) == a);
+            src = b;
+            domain.retire(a);
+            domain.reclaim();
+            REQUIRE(tracked::live == 2);
+
+            REQUIRE(guard.protect(src) == b);
+            domain.reclaim();
+            REQUIRE(tracked::live == 1);
+        }
+        src = nullptr;
+        domain.retire(b);
+        domain.reclaim();
+        REQUIRE(tracked::live == 0);
+    }
+
+    SECTION("Deferred deleter plugs into unique_ptr") {
+        epoch_domain domain;
+        {
+            epoch_guard guard(domain);
+            unique_ptr<tracked, deferred_deleter<tracked>> p(new tracked(1), deferred_deleter<tracked>(domain));
+            p.reset();
+            domain.reclaim();
+            REQUIRE(tracked::live == 1);
+        }
+        domain.reclaim();
+        REQUIRE(tracked::live == 0);
+    }
+
+    SECTION("Concurrent stack with epochs") {
+        {
+            epoch_domain domain;
+            stress<epoch_domain, epoch_guard>(domain);
+        }
+        REQUIRE(tracked::live == 0);
+    }
+
+    SECTION("Concurrent stack with hazard pointers") {
+        {
+            hazard_domain domain;
+            stress<hazard_domain, hazard_guard>(domain);
+        }
+        REQUIRE(tracked::live == 0);
+    }
+}
@@ -0,0 +1,151 @@
+#include <tinystl/slot_map.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct thrower {
+    int value;
+    explicit thrower(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("thrower");
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Slot Map Tests", "[slot_map]") {
+    SECTION("Keys") {
+        slot_key null;
+        REQUIRE(null.index() == 0);
+        REQUIRE(null.generation() == 0);
+        slot_key k(3, 7);
+        REQUIRE(sizeof(slot_key) == 8);
+        REQUIRE(k.bits() == (std::uint64_t(7) << 32 | 3));
+        REQUIRE(slot_key::from_bits(k.bits()) == k);
+        REQUIRE(k != null);
+        std::unordered_set<slot_key> set{k, null, k};
+        REQUIRE(set.size() == 2);
+    }
+
+    SECTION("Insert, find and erase") {
+        slot_map<std::string> m;
+        REQUIRE(m.empty());
+        slot_key a = m.insert("a");
+        slot_key b = m.emplace(3, 'b');
+        slot_key c = m.insert(std::string("c"));
+        REQUIRE(m.size() == 3);
+        REQUIRE(*m.find(a) == "a");
+        REQUIRE(m[b] == "bbb");
+        REQUIRE(m.at(c) == "c");
+        REQUIRE(m.contains(b));
+        REQUIRE_FALSE(m.contains(slot_key()));
+
+        // erasing a moves the last value into its place
+        REQUIRE(m.erase(a));
+        REQUIRE(m.size() == 2);
+        REQUIRE(m.find(a) == nullptr);
+        REQUIRE_FALSE(m.erase(a));
+        REQUIRE(m[b] == "bbb");
+        REQUIRE(m[c] == "c");
+        REQUIRE(m.data()[0] == "c");
+        REQUIRE(m.key_at(0) == c);
+        REQUIRE(m.key_at(1) == b);
+        REQUIRE_THROWS_AS(m.at(a), std::out_of_range);
+    }
+
+    SECTION("Stale keys miss after their slot is reused") {
+        slot_map<int> m;
+        slot_key a = m.insert(1);
+        m.erase(a);
+        slot_key b = m.insert(2);
+        REQUIRE(b.index() == a.index());
+        REQUIRE(b.generation() != a.generation());
+        REQUIRE(m.find(a) == nullptr);
+        REQUIRE(m[b] == 2);
+        REQUIRE(m.find(slot_key(b.index() + 1, b.generation())) == nullptr);
+    }
+
+    SECTION("Clear makes every key stale") {
+        slot_map<int> m;
+        std::vector<slot_key> keys;
+        for (int i = 0; i < 100; ++i) keys.push_back(m.insert(i));
+        m.clear();
+        REQUIRE(m.empty());
+        for (slot_key k : keys) REQUIRE_FALSE(m.contains(k));
+        slot_key k = m.insert(5);
+        REQUIRE(m[k] == 5);
+        REQUIRE(m.size() == 1);
+    }
+
+    SECTION("Iteration runs over the packed values") {
+        slot_map<int> m;
+        m.reserve(1000);
+        REQUIRE(m.capacity() >= 1000);
+        std::vector<slot_key> keys;
+        for (int i = 0; i < 1000; ++i) keys.push_back(m.insert(i));
+        for (int i = 0; i < 1000; i += 2) m.erase(keys[i]);
+        REQUIRE(m.end() - m.begin() == 500);
+        REQUIRE(std::all_of(m.cbegin(), m.cend(), [](int v) { return v % 2 == 1; }));
+        for (std::size_t pos = 0; pos < m.size(); ++pos) REQUIRE(m[m.key_at(pos)] == m.data()[pos]);
+    }
+
+    SECTION("A throwing constructor leaves the map unchanged") {
+        slot_map<thrower> m;
+        slot_key a = m.emplace(1);
+        REQUIRE_THROWS_AS(m.emplace(-1), std::runtime_error);
+        REQUIRE(m.size() == 1);
+        REQUIRE(m[a].value == 1);
+        slot_key b = m.emplace(2);
+        REQUIRE(b.index() == 1);
+        REQUIRE(m[b].value == 2);
+    }
+
+    SECTION("Copy, move and swap") {
+        slot_map<std::string> a;
+        slot_key k = a.insert("x");
+        slot_map<std::string> b(a);
+        REQUIRE(b[k] == "x");
+        slot_map<std::string> c(std::move(a));
+        REQUIRE(c[k] == "x");
+        slot_map<std::string> d;
+        swap(c, d);
+        REQUIRE(c.empty());
+        REQUIRE(d[k] == "x");
+        c = d;
+        REQUIRE(c.at(k) == "x");
+    }
+
+    SECTION("Random operations match std::map") {
+        slot_map<int> m;
+        std::map<std::uint64_t, int> expected;
+        std::vector<slot_key> erased;
+        std::mt19937 rng(42);
+        for (int i = 0; i < 100000; ++i) {
+            unsigned op = rng() % 100;
+            if (op < 55 || expected.empty()) {
+                slot_key k = m.insert(i);
+                REQUIRE(expected.emplace(k.bits(), i).second);
+            } else if (op < 99) {
+                auto it = expected.begin();
+                std::advance(it, rng() % std::min<std::size_t>(expected.size(), 16));
+                slot_key k = slot_key::from_bits(it->first);
+                REQUIRE(m.erase(k));
+                erased.push_back(k);
+                expected.erase(it);
+            } else {
+                REQUIRE(m.find(erased.empty() ? slot_key() : erased[rng() % erased.size()]) == nullptr);
+            }
+            REQUIRE(m.size() == expected.size());
+        }
+        for (const auto &kv : expected) REQUIRE(m[slot_key::from_bits(kv.first)] == kv.second);
+        for (slot_key k : erased) REQUIRE_FALSE(m.contains(k));
+    }
+}
@@ -0,0 +1,157 @@
+#include <tinystl/small_vector.h>
+#include <catch2/catch_all.hpp>
+#include <list>
+#include <memory>
+#include <string>
+
+using namespace tinystl;
+
+namespace {
+
+struct counted {
+    static int live;
+    int value;
+
+    counted(int v = 0) : value(v) { ++live; }
+    counted(const counted &other) : value(other.value) { ++live; }
+    counted(counted &&other) noexcept : value(other.value) { ++live; }
+    counted &operator=(const counted &other) = default;
+    counted &operator=(counted &&other) noexcept = default;
+    ~counted() { --live; }
+};
+
+int counted::live = 0;
+
+}  // namespace
+
+TEST_CASE("Small Vector Tests", "[small_vector]") {
+    SECTION("Starts inline") {
+        small_vector<int, 8> v;
+        REQUIRE(v.empty());
+        REQUIRE(v.is_inline());
+        REQUIRE(v.capacity() == 8);
+        REQUIRE(v.data() != nullptr);
+    }
+
+    SECTION("Stays inline up to N and spills beyond") {
+        small_vector<int, 4> v;
+        for (int i = 0; i < 4; ++i) v.push_back(i);
+        REQUIRE(v.is_inline());
+        v.push_back(4);
+        REQUIRE_FALSE(v.is_inline());
+        REQUIRE(v.capacity() >= 5);
+        for (int i = 0; i < 5; ++i) REQUIRE(v[i] == i);
+    }
+
+    SECTION("Constructors") {
+        small_vector<std::string, 2> v1(3, "abc");
+        REQUIRE(v1.size() == 3);
+        for (const auto &s : v1) REQUIRE(s == "abc");
+
+        std::list<int> l{1, 2, 3};
+        small_vector<int, 4> v2(l.begin(), l.end());
+        REQUIRE(v2 == small_vector<int, 4>{1, 2, 3});
+
+        small_vector<int, 4> v3(6);
+        REQUIRE(v3.size() == 6);
+        for (int x : v3) REQUIRE(x == 0);
+    }
+
+    SECTION("Moving a spilled vector steals its buffer") {
+        small_vector<std::string, 2> v1{"a", "b", "c"};
+        const std::string *data = v1.data();
+        small_vector<std::string, 2> v2(std::move(v1));
+        REQUIRE(v2.data() == data);
+        REQUIRE(v2.size() == 3);
+        REQUIRE(v1.empty());
+        REQUIRE(v1.is_inline());
+
+        small_vector<std::string, 2> v3;
+        v3 = std::move(v2);
+        REQUIRE(v3.data() == data);
+        REQUIRE(v3[2] == "c");
+    }
+
+    SECTION("Moving an inline vector moves the elements") {
+        small_vector<std::unique_ptr<int>, 4> v1;
+        v1.push_back(std::make_unique<int>(1));
+        v1.push_back(std::make_unique<int>(2));
+        small_vector<std::unique_ptr<int>, 4> v2(std::move(v1));
+        REQUIRE(v2.is_inline());
+        REQUIRE(v2.size() == 2);
+        REQUIRE(*v2[1] == 2);
+        REQUIRE(v1.empty());
+    }
+
+    SECTION("Copy") {
+        small_vector<std::string, 2> v1{"a", "b", "c"};
+        small_vector<std::string, 2> v2(v1);
+        REQUIRE(v1 == v2);
+        small_vector<std::string, 2> v3{"x"};
+        v3 = v1;
+        REQUIRE(v3 == v1);
+        v1 = {"y"};
+        REQUIRE(v1.size() == 1);
+    }
+
+    SECTION("Insert and erase") {
+        small_vector<int, 4> v{1, 5};
+        v.insert(v.begin() + 1, {2, 3, 4});
+        REQUIRE(v == small_vector<int, 4>{1, 2, 3, 4, 5});
+        v.insert(v.begin(), 2, 0);
+        REQUIRE(v == small_vector<int, 4>{0, 0, 1, 2, 3, 4, 5});
+        v.emplace(v.end(), 6);
+        v.erase(v.begin(), v.begin() + 2);
+        REQUIRE(v == small_vector<int, 4>{1, 2, 3, 4, 5, 6});
+        v.erase(v.begin() + 2);
+        REQUIRE(v == small_vector<int, 4>{1, 2, 4, 5, 6});
+    }
+
+    SECTION("Inserting an element of the vector itself") {
+        small_vector<std::string, 2> v{"a", "b"};
+        v.push_back(v[0]);
+        v.insert(v.begin(), v[2]);
+        REQUIRE(v == small_vector<std::string, 2>{"a", "a", "b", "a"});
+    }
+
+    SECTION("Swap") {
+        small_vector<int, 2> inline_v{1};
+        small_vector<int, 2> heap_v{2, 3, 4};
+        inline_v.swap(heap_v);
+        REQUIRE(inline_v == small_vector<int, 2>{2, 3, 4});
+        REQUIRE(heap_v == small_vector<int, 2>{1});
+
+        small_vector<int, 2> other{5, 6, 7, 8};
+        swap(inline_v, other);
+        REQUIRE(inline_v.size() == 4);
+        REQUIRE(other.size() == 3);
+    }
+
+    SECTION("Shrinking moves back inline") {
+        small_vector<int, 4> v{1, 2, 3, 4, 5, 6};
+        v.resize(3);
+        v.shrink_to_fit();
+        REQUIRE(v.is_inline());
+        REQUIRE(v == small_vector<int, 4>{1, 2, 3});
+    }
+
+    SECTION("Element lifetimes") {
+        {
+            small_vector<counted, 4> v;
+            for (int i = 0; i < 10; ++i) v.emplace_back(i);
+            v.insert(v.begin() + 3, 3, counted(7));
+            v.erase(v.begin(), v.begin() + 5);
+            small_vector<counted, 4> w(std::move(v));
+            w.resize(2);
+            w.shrink_to_fit();
+            REQUIRE(counted::live == 2);
+        }
+        REQUIRE(counted::live == 0);
+    }
+
+    SECTION("Bounds checked access") {
+        small_vector<int, 2> v{1};
+        REQUIRE(v.at(0) == 1);
+        REQUIRE_THROWS_AS(v.at(1), std::out_of_range);
+    }
+}
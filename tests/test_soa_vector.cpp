@@ -0,0 +1,189 @@
+#include <tinystl/memory.h>
+#include <tinystl/soa_vector.h>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+using namespace tinystl;
+
+namespace {
+
+// throws on the copy that brings the live count to the limit
+struct fragile {
+    static int live;
+    static int limit;
+    int value;
+
+    fragile(int v = 0) : value(v) { acquire(); }
+    fragile(const fragile &other) : value(other.value) { acquire(); }
+    ~fragile() { --live; }
+    fragile &operator=(const fragile &other) = default;
+
+    static void acquire() {
+        if (live + 1 == limit) throw std::runtime_error("fragile");
+        ++live;
+    }
+};
+
+int fragile::live = 0;
+int fragile::limit = -1;
+
+}  // namespace
+
+TEST_CASE("Soa Vector Tests", "[soa_vector]") {
+    SECTION("Rows are spread over columns") {
+        soa_vector<int, double, std::string> v;
+        REQUIRE(v.empty());
+        for (int i = 0; i < 100; ++i) v.emplace_back(i, i * 0.5, std::to_string(i));
+        REQUIRE(v.size() == 100);
+        REQUIRE(v.capacity() >= 100);
+
+        REQUIRE(v[42].get<0>() == 42);
+        REQUIRE(v[42].get<1>() == 21.0);
+        REQUIRE(v[42].get<2>() == "42");
+        REQUIRE(v.data<0>()[7] == 7);
+        REQUIRE(v.data<2>()[99] == "99");
+        REQUIRE(get<2>(v.back()) == "99");
+        REQUIRE(v.front().get<0>() == 0);
+        REQUIRE_THROWS_AS(v.at(100), std::out_of_range);
+    }
+
+    SECTION("Column spans cover one field") {
+        soa_vector<std::uint32_t, float> v;
+        for (std::uint32_t i = 0; i < 1000; ++i) v.push_back({i, 2.0f});
+        column_span<float> scores = v.column<1>();
+        REQUIRE(scores.size() == 1000);
+        for (float &s : scores) s *= 3.0f;
+        float sum = 0;
+        for (std::size_t i = 0; i < scores.size(); ++i) sum += scores[i];
+        REQUIRE(sum == 6000.0f);
+
+        const soa_vector<std::uint32_t, float> &cv = v;
+        column_span<const std::uint32_t> ids = cv.column<0>();
+        REQUIRE(ids.data() == v.data<0>());
+        REQUIRE(ids[999] == 999);
+    }
+
+    SECTION("Rows behave like structs") {
+        soa_vector<int, std::string> v;
+        v.push_back({1, "one"});
+        v.push_back({2, "two"});
+
+        auto [id, name] = v[0];
+        id = 10;
+        name += "!";
+        REQUIRE(v[0].get<0>() == 10);
+        REQUIRE(v[0].get<1>() == "one!");
+
+        // assignment copies the fields instead of rebinding the proxy
+        v[1] = v[0];
+        REQUIRE(v[1].get<0>() == 10);
+        REQUIRE(v[1].get<1>() == "one!");
+        v[0] = std::make_tuple(3, std::string("three"));
+        REQUIRE(v[0].get<1>() == "three");
+
+        std::tuple<int, std::string> row = v[1];
+        REQUIRE(std::get<0>(row) == 10);
+    }
+
+    SECTION("Iteration visits rows in order") {
+        soa_vector<int, char> v;
+        for (int i = 0; i < 10; ++i) v.emplace_back(i, static_cast<char>('a' + i));
+        int expected = 0;
+        for (auto row : v) {
+            REQUIRE(row.get<0>() == expected);
+            REQUIRE(row.get<1>() == 'a' + expected);
+            ++expected;
+        }
+        REQUIRE(expected == 10);
+        REQUIRE(v.end() - v.begin() == 10);
+        REQUIRE((*(v.begin() + 3)).get<0>() == 3);
+        REQUIRE(v.cbegin()[9].get<1>() == 'j');
+    }
+
+    SECTION("Growth keeps every column") {
+        soa_vector<std::uint64_t, std::string> v;
+        v.reserve(5);
+        REQUIRE(v.capacity() >= 5);
+        for (std::uint64_t i = 0; i < 5000; ++i) v.emplace_back(i, std::string(20, static_cast<char>('a' + i % 26)));
+        for (std::uint64_t i = 0; i < 5000; ++i) {
+            REQUIRE(v[i].get<0>() == i);
+            REQUIRE(v[i].get<1>() == std::string(20, static_cast<char>('a' + i % 26)));
+        }
+        // pushing a copy of one of our own rows while the columns move
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 5000);
+        v.push_back(v[3]);
+        REQUIRE(v.back().get<1>() == std::string(20, 'd'));
+
+        v.resize(10);
+        REQUIRE(v.size() == 10);
+        v.resize(12);
+        REQUIRE(v[11].get<0>() == 0);
+        REQUIRE(v[11].get<1>().empty());
+        v.pop_back();
+        REQUIRE(v.size() == 11);
+        v.clear();
+        REQUIRE(v.empty());
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 0);
+    }
+
+    SECTION("Move-only columns grow as bytes") {
+        soa_vector<std::string, unique_ptr<int>> v;
+        for (int i = 0; i < 1000; ++i) v.emplace_back(std::to_string(i), make_unique<int>(i));
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(v[i].get<0>() == std::to_string(i));
+            REQUIRE(*v[i].get<1>() == i);
+        }
+    }
+
+    SECTION("Copy and move") {
+        soa_vector<int, std::string> a;
+        for (int i = 0; i < 50; ++i) a.emplace_back(i, std::to_string(i));
+        soa_vector<int, std::string> b(a);
+        REQUIRE(b.size() == 50);
+        REQUIRE(b[49].get<1>() == "49");
+        REQUIRE(b.data<1>() != a.data<1>());
+
+        soa_vector<int, std::string> c(std::move(a));
+        REQUIRE(a.empty());
+        REQUIRE(c[10].get<1>() == "10");
+        a = c;
+        REQUIRE(a[20].get<0>() == 20);
+        c = std::move(b);
+        REQUIRE(c.size() == 50);
+    }
+
+    SECTION("A throwing field leaves the vector as it was") {
+        fragile::live = 0;
+        fragile::limit = -1;
+        auto text = [](int i) { return std::string(40, char('a' + i % 26)); };
+        {
+            // the string column can be moved without throwing, but must not
+            // be moved before the fragile column has been copied
+            soa_vector<int, std::string, fragile> v;
+            for (int i = 0; i < 16; ++i) v.emplace_back(i, text(i), fragile(i));
+            REQUIRE(v.capacity() == 16);
+            REQUIRE(fragile::live == 16);
+
+            // growing copies fragile, and the copy of row 8 throws
+            fragile::limit = 16 + 9;
+            REQUIRE_THROWS_AS(v.emplace_back(16, text(16), 16), std::runtime_error);
+            REQUIRE(v.size() == 16);
+            REQUIRE(v.capacity() == 16);
+            REQUIRE(fragile::live == 16);
+            for (int i = 0; i < 16; ++i) {
+                REQUIRE(v[i].get<1>() == text(i));
+                REQUIRE(v[i].get<2>().value == i);
+            }
+
+            REQUIRE_THROWS_AS((soa_vector<int, std::string, fragile>(v)), std::runtime_error);
+            REQUIRE(fragile::live == 16);
+            fragile::limit = -1;
+        }
+        REQUIRE(fragile::live == 0);
+    }
+}
@@ -0,0 +1,185 @@
+#include <tinystl/thread_cache.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+struct payload {
+    std::uint64_t id;
+    std::uint64_t check;
+};
+
+template <typename T>
+class blocking_queue {
+public:
+    void push(T value) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->items_.push_back(value);
+        }
+        this->cv_.notify_one();
+    }
+
+    T pop() {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->cv_.wait(lock, [this] { return !this->items_.empty(); });
+        T value = this->items_.front();
+        this->items_.pop_front();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<T> items_;
+};
+
+}  // namespace
+
+TEST_CASE("Thread Cache Tests", "[thread_cache]") {
+    SECTION("Freed blocks are reused by the same thread") {
+        thread_cache_allocator<payload> alloc;
+        payload *p = alloc.allocate(1);
+        REQUIRE(p != nullptr);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignof(payload) == 0);
+        alloc.deallocate(p, 1);
+        REQUIRE(alloc.allocate(1) == p);
+        alloc.deallocate(p, 1);
+    }
+
+    SECTION("Spans record the owning cache") {
+        thread_cache_allocator<int> alloc;
+        int *p = alloc.allocate(4);
+        REQUIRE(central_pool::span_of(p)->size_class == size_class_pool::size_class(4 * sizeof(int)));
+        alloc.deallocate(p, 4);
+    }
+
+    SECTION("Magazines spill and refill across many blocks") {
+        thread_cache_allocator<payload> alloc;
+        std::vector<payload *> blocks;
+        for (std::uint64_t i = 0; i < 5000; ++i) {
+            payload *p = alloc.allocate(1);
+            p->id = i;
+            p->check = ~i;
+            blocks.push_back(p);
+        }
+        for (std::uint64_t i = 0; i < 5000; ++i) {
+            REQUIRE(blocks[i]->id == i);
+            REQUIRE(blocks[i]->check == ~i);
+        }
+        for (payload *p : blocks) alloc.deallocate(p, 1);
+    }
+
+    SECTION("Large requests bypass the cache") {
+        thread_cache_allocator<double> alloc;
+        double *p = alloc.allocate(4096);
+        p[4095] = 1.0;
+        alloc.deallocate(p, 4096);
+    }
+
+    SECTION("As a container allocator") {
+        tinystl::vector<std::string, thread_cache_allocator<std::string>> v;
+        for (int i = 0; i < 5; ++i) v.push_back(std::to_string(i));
+        REQUIRE(v[4] == "4");
+    }
+}
+
+TEST_CASE("Thread Cache Producer Consumer Tests", "[thread_cache][thread]") {
+    SECTION("Consumers free what producers allocate") {
+        constexpr int producers = 2;
+        constexpr int consumers = 2;
+        constexpr std::uint64_t per_producer = 20000;
+        blocking_queue<payload *> queue;
+        std::atomic<std::uint64_t> corrupted{0};
+        std::atomic<std::uint64_t> consumed{0};
+
+        std::vector<std::thread> threads;
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                thread_cache_allocator<payload> alloc;
+                for (;;) {
+                    payload *p = queue.pop();
+                    if (p == nullptr) break;
+                    if (p->check != ~p->id) corrupted.fetch_add(1);
+                    consumed.fetch_add(1);
+                    alloc.deallocate(p, 1);
+                }
+            });
+        }
+        for (int t = 0; t < producers; ++t) {
+            threads.emplace_back([&, t] {
+                thread_cache_allocator<payload> alloc;
+                for (std::uint64_t i = 0; i < per_producer; ++i) {
+                    payload *p = alloc.allocate(1);
+                    p->id = i * producers + t;
+                    p->check = ~p->id;
+                    queue.push(p);
+                }
+            });
+        }
+        for (int t = consumers; t < consumers + producers; ++t) threads[t].join();
+        for (int c = 0; c < consumers; ++c) queue.push(nullptr);
+        for (int c = 0; c < consumers; ++c) threads[c].join();
+
+        REQUIRE(consumed.load() == producers * per_producer);
+        REQUIRE(corrupted.load() == 0);
+    }
+
+    SECTION("Remote frees return to the owning thread") {
+        struct big {
+            char bytes[240];
+        };
+        thread_cache_allocator<big> alloc;
+        big *p = alloc.allocate(1);
+        REQUIRE(central_pool::span_of(p)->owner == thread_cache::current());
+        std::thread remote([p] { thread_cache_allocator<big>().deallocate(p, 1); });
+        remote.join();
+
+        std::vector<big *> blocks;
+        bool returned = false;
+        for (std::size_t i = 0; i <= thread_cache::magazine_capacity && !returned; ++i) {
+            blocks.push_back(alloc.allocate(1));
+            returned = blocks.back() == p;
+        }
+        REQUIRE(returned);
+        for (big *b : blocks) alloc.deallocate(b, 1);
+    }
+
+    SECTION("Blocks outlive the thread that allocated them") {
+        thread_cache_allocator<payload> alloc;
+        std::vector<payload *> blocks(1000);
+        std::thread producer([&] {
+            thread_cache_allocator<payload> local;
+            for (std::uint64_t i = 0; i < blocks.size(); ++i) {
+                blocks[i] = local.allocate(1);
+                blocks[i]->id = i;
+                blocks[i]->check = ~i;
+            }
+        });
+        producer.join();
+
+        for (std::uint64_t i = 0; i < blocks.size(); ++i) {
+            REQUIRE(blocks[i]->check == ~blocks[i]->id);
+            alloc.deallocate(blocks[i], 1);
+        }
+
+        // a new thread may adopt the exited cache along with the remote frees
+        std::thread reuser([&] {
+            thread_cache_allocator<payload> local;
+            std::vector<payload *> again;
+            for (int i = 0; i < 2000; ++i) again.push_back(local.allocate(1));
+            for (payload *p : again) local.deallocate(p, 1);
+        });
+        reuser.join();
+    }
+}
@@ -0,0 +1,132 @@
+#include <tinystl/thread_pool.h>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace tinystl;
+
+namespace {
+
+long fib(thread_pool &pool, int n) {
+    if (n < 2) return n;
+    long left = 0;
+    task_group group(pool);
+    group.run([&] { left = fib(pool, n - 1); });
+    long right = fib(pool, n - 2);
+    group.wait();
+    return left + right;
+}
+
+}  // namespace
+
+TEST_CASE("Thread Pool Tests", "[thread_pool]") {
+    SECTION("Deque pops newest first and steals oldest first") {
+        work_stealing_deque<int> d(2);
+        for (int i = 0; i < 10; ++i) d.push(i);
+        REQUIRE(d.size_approx() == 10);
+        int value = -1;
+        REQUIRE(d.steal(value));
+        REQUIRE(value == 0);
+        REQUIRE(d.pop(value));
+        REQUIRE(value == 9);
+        while (d.pop(value)) {
+        }
+        REQUIRE(d.empty_approx());
+        REQUIRE_FALSE(d.steal(value));
+    }
+
+    SECTION("Every element is taken exactly once under contention") {
+        constexpr int count = 200000;
+        constexpr int thieves = 3;
+        work_stealing_deque<std::intptr_t> d;
+        std::vector<std::atomic<int>> seen(count);
+        std::atomic<bool> done{false};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thieves; ++t) {
+            threads.emplace_back([&] {
+                std::intptr_t value;
+                while (!done.load(std::memory_order_acquire)) {
+                    if (d.steal(value)) seen[value].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        std::intptr_t value;
+        for (int i = 0; i < count; ++i) {
+            d.push(i);
+            if (i % 3 == 0 && d.pop(value)) seen[value].fetch_add(1, std::memory_order_relaxed);
+        }
+        while (d.pop(value)) seen[value].fetch_add(1, std::memory_order_relaxed);
+        done.store(true, std::memory_order_release);
+        for (auto &t : threads) t.join();
+        while (d.steal(value)) seen[value].fetch_add(1, std::memory_order_relaxed);
+
+        int wrong = 0;
+        for (auto &s : seen) wrong += (s.load() != 1);
+        REQUIRE(wrong == 0);
+    }
+
+    SECTION("Submitted tasks run before the pool is destroyed") {
+        std::atomic<int> ran{0};
+        {
+            thread_pool pool(4);
+            REQUIRE(pool.size() == 4);
+            REQUIRE(pool.current_worker() == thread_pool::npos);
+            for (int i = 0; i < 1000; ++i) pool.submit([&] { ran.fetch_add(1); });
+        }
+        REQUIRE(ran.load() == 1000);
+    }
+
+    SECTION("Tasks know which worker runs them") {
+        thread_pool pool(2);
+        std::atomic<int> bad{0};
+        task_group group(pool);
+        for (int i = 0; i < 100; ++i) {
+            group.run([&] {
+                std::size_t index = pool.current_worker();
+                // the waiting thread helps too
+                if (index != thread_pool::npos && index >= pool.size()) bad.fetch_add(1);
+            });
+        }
+        group.wait();
+        REQUIRE(bad.load() == 0);
+    }
+
+    SECTION("Nested task groups do not deadlock") {
+        thread_pool pool(3);
+        REQUIRE(fib(pool, 20) == 6765);
+        thread_pool single(1);
+        REQUIRE(fib(single, 15) == 610);
+    }
+
+    SECTION("wait rethrows the first exception and the group stays usable") {
+        thread_pool pool(2);
+        task_group group(pool);
+        std::atomic<int> ran{0};
+        for (int i = 0; i < 10; ++i) {
+            group.run([&, i] {
+                ran.fetch_add(1);
+                if (i == 3) throw std::runtime_error("task failed");
+            });
+        }
+        REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+        REQUIRE(ran.load() == 10);
+        group.run([&] { ran.fetch_add(1); });
+        REQUIRE_NOTHROW(group.wait());
+        REQUIRE(ran.load() == 11);
+    }
+
+    SECTION("Idle workers wake up for new work") {
+        thread_pool pool(2);
+        for (int round = 0; round < 20; ++round) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            std::atomic<int> ran{0};
+            task_group group(pool);
+            for (int i = 0; i < 8; ++i) group.run([&] { ran.fetch_add(1); });
+            group.wait();
+            REQUIRE(ran.load() == 8);
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <tinystl/util.h>
 #include <catch2/catch_all.hpp>
+#include <string>
 #include <vector>
 
 /*
@@ -8,6 +9,18 @@
 
 using namespace tinystl;
 
+namespace {
+
+struct handle {
+    int *p;
+    handle(handle &&other) noexcept : p(other.p) { other.p = nullptr; }
+    ~handle() {}
+};
+
+}  // namespace
+
+TINYSTL_TRIVIALLY_RELOCATABLE(handle)
+
 TEST_CASE("Utils Tests", "[util]") {
     SECTION("Move function") {
         // Create a vector
@@ -28,4 +41,28 @@ TEST_CASE("Utils Tests", "[util]") {
         REQUIRE(v2[1] == 2);
         REQUIRE(v2[2] == 3);
     }
-}
\ No newline at end of file
+
+    SECTION("Compressed pair") {
+        struct empty {};
+        REQUIRE(sizeof(compressed_pair<empty, int*>) == sizeof(int*));
+        REQUIRE(sizeof(compressed_pair<long, int*>) == sizeof(long) + sizeof(int*));
+
+        compressed_pair<std::string, int> p("key", 1);
+        REQUIRE(p.first() == "key");
+        p.second() += 1;
+        REQUIRE(p.second() == 2);
+
+        compressed_pair<empty, int> e;
+        REQUIRE(e.second() == 0);
+    }
+
+    SECTION("Trivially relocatable trait") {
+        REQUIRE(is_trivially_relocatable<int>::value);
+        REQUIRE(is_trivially_relocatable<int *>::value);
+        REQUIRE_FALSE(is_trivially_relocatable<std::string>::value);
+        REQUIRE(is_trivially_relocatable<handle>::value);
+        REQUIRE_FALSE(std::is_trivially_copyable<handle>::value);
+        REQUIRE(is_trivially_relocatable<std::pair<const int, handle>>::value);
+        REQUIRE_FALSE(is_trivially_relocatable<std::pair<int, std::string>>::value);
+    }
+}
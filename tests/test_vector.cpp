@@ -0,0 +1,286 @@
+#include <tinystl/memory.h>
+#include <tinystl/vector.h>
+#include <catch2/catch_all.hpp>
+#include <list>
+#include <sstream>
+#include <string>
+
+using namespace tinystl;
+
+namespace {
+
+struct counted {
+    static int live;
+    int value;
+
+    counted(int v = 0) : value(v) { ++live; }
+    counted(const counted &other) : value(other.value) { ++live; }
+    counted(counted &&other) noexcept : value(other.value) { ++live; }
+    counted &operator=(const counted &other) = default;
+    counted &operator=(counted &&other) noexcept = default;
+    ~counted() { --live; }
+};
+
+int counted::live = 0;
+
+struct throwing_copy {
+    static int copies_left;
+    int value;
+
+    throwing_copy(int v = 0) : value(v) {}
+    throwing_copy(const throwing_copy &other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("copy");
+    }
+    throwing_copy &operator=(const throwing_copy &other) = default;
+};
+
+int throwing_copy::copies_left = 0;
+
+// moved as bytes by the vector, so its move constructor is never called
+struct relocatable {
+    static int live;
+    static int moves;
+    int value;
+
+    relocatable(int v = 0) : value(v) { ++live; }
+    relocatable(relocatable &&other) noexcept : value(other.value) {
+        ++live;
+        ++moves;
+    }
+    ~relocatable() { --live; }
+};
+
+int relocatable::live = 0;
+int relocatable::moves = 0;
+
+}  // namespace
+
+TINYSTL_TRIVIALLY_RELOCATABLE(relocatable)
+
+TEST_CASE("Vector Tests", "[vector]") {
+    SECTION("Default constructor") {
+        vector<int> v;
+        REQUIRE(v.empty());
+        REQUIRE(v.size() == 0);
+        REQUIRE(v.capacity() == 0);
+        REQUIRE(v.data() == nullptr);
+    }
+
+    SECTION("Count and value constructors") {
+        vector<int> v1(5);
+        REQUIRE(v1.size() == 5);
+        REQUIRE(v1.capacity() == 5);
+        for (int x : v1) REQUIRE(x == 0);
+
+        vector<std::string> v2(3, "abc");
+        REQUIRE(v2.size() == 3);
+        for (const auto &s : v2) REQUIRE(s == "abc");
+    }
+
+    SECTION("Range and initializer list constructors") {
+        std::list<int> l{1, 2, 3, 4};
+        vector<int> v1(l.begin(), l.end());
+        REQUIRE(v1.size() == 4);
+        REQUIRE(v1[3] == 4);
+
+        vector<int> v2{5, 6, 7};
+        REQUIRE(v2.size() == 3);
+        REQUIRE(v2.front() == 5);
+        REQUIRE(v2.back() == 7);
+
+        std::istringstream in("8 9 10");
+        vector<int> v3{std::istream_iterator<int>(in), std::istream_iterator<int>()};
+        REQUIRE(v3 == vector<int>{8, 9, 10});
+    }
+
+    SECTION("Copy and move") {
+        vector<std::string> v1{"a", "b", "c"};
+        vector<std::string> v2(v1);
+        REQUIRE(v1 == v2);
+
+        const std::string *data = v1.data();
+        vector<std::string> v3(std::move(v1));
+        REQUIRE(v1.empty());
+        REQUIRE(v3.data() == data);
+
+        vector<std::string> v4{"x"};
+        v4 = v2;
+        REQUIRE(v4 == v2);
+        v4 = std::move(v3);
+        REQUIRE(v4.data() == data);
+        v4 = {"y", "z"};
+        REQUIRE(v4.size() == 2);
+        REQUIRE(v4[1] == "z");
+    }
+
+    SECTION("Push back and growth factor") {
+        vector<int> v;
+        for (int i = 0; i < 1000; ++i) v.push_back(i);
+        REQUIRE(v.size() == 1000);
+        for (int i = 0; i < 1000; ++i) REQUIRE(v[i] == i);
+
+        vector<int> g;
+        g.reserve(100);
+        g.resize(100);
+        g.push_back(0);
+        REQUIRE(g.capacity() == 150);
+
+        vector<int, allocator<int>, std::ratio<2, 1>> d;
+        d.reserve(100);
+        d.resize(100);
+        d.push_back(0);
+        REQUIRE(d.capacity() == 200);
+    }
+
+    SECTION("Push back an element of itself") {
+        vector<std::string> v{"hello"};
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == v.size());
+        v.push_back(v[0]);
+        REQUIRE(v.size() == 2);
+        REQUIRE(v[1] == "hello");
+
+        vector<std::string> w{"a", "b"};
+        w.reserve(10);
+        w.insert(w.begin(), w[1]);
+        REQUIRE(w == vector<std::string>{"b", "a", "b"});
+    }
+
+    SECTION("Emplace back") {
+        vector<std::pair<int, std::string>> v;
+        auto &ref = v.emplace_back(1, "one");
+        REQUIRE(ref.first == 1);
+        REQUIRE(v.back().second == "one");
+    }
+
+    SECTION("Insert") {
+        vector<int> v{1, 2, 3};
+        auto it = v.insert(v.begin() + 1, 9);
+        REQUIRE(*it == 9);
+        REQUIRE(v == vector<int>{1, 9, 2, 3});
+
+        it = v.insert(v.end(), 2, 7);
+        REQUIRE(it == v.begin() + 4);
+        REQUIRE(v == vector<int>{1, 9, 2, 3, 7, 7});
+
+        v.reserve(20);
+        v.insert(v.begin(), 3, 0);
+        REQUIRE(v == vector<int>{0, 0, 0, 1, 9, 2, 3, 7, 7});
+        v.insert(v.end() - 1, {4, 5});
+        REQUIRE(v == vector<int>{0, 0, 0, 1, 9, 2, 3, 7, 4, 5, 7});
+
+        std::list<int> l{8, 8};
+        v.insert(v.begin() + 2, l.begin(), l.end());
+        REQUIRE(v == vector<int>{0, 0, 8, 8, 0, 1, 9, 2, 3, 7, 4, 5, 7});
+    }
+
+    SECTION("Erase") {
+        vector<int> v{1, 2, 3, 4, 5};
+        auto it = v.erase(v.begin() + 1);
+        REQUIRE(*it == 3);
+        REQUIRE(v == vector<int>{1, 3, 4, 5});
+        it = v.erase(v.begin(), v.begin() + 2);
+        REQUIRE(*it == 4);
+        REQUIRE(v == vector<int>{4, 5});
+        v.pop_back();
+        REQUIRE(v == vector<int>{4});
+    }
+
+    SECTION("Resize and assign") {
+        vector<int> v;
+        v.resize(3);
+        REQUIRE(v == vector<int>{0, 0, 0});
+        v.resize(5, 1);
+        REQUIRE(v == vector<int>{0, 0, 0, 1, 1});
+        v.resize(2);
+        REQUIRE(v == vector<int>{0, 0});
+
+        v.assign(4, 2);
+        REQUIRE(v == vector<int>{2, 2, 2, 2});
+        v.assign({1, 2});
+        REQUIRE(v == vector<int>{1, 2});
+    }
+
+    SECTION("At throws out of range") {
+        vector<int> v{1};
+        REQUIRE(v.at(0) == 1);
+        REQUIRE_THROWS_AS(v.at(1), std::out_of_range);
+    }
+
+    SECTION("Reverse iterators and comparison") {
+        vector<int> v{1, 2, 3};
+        vector<int> r(v.rbegin(), v.rend());
+        REQUIRE(r == vector<int>{3, 2, 1});
+        REQUIRE(v < r);
+        REQUIRE(r > v);
+        REQUIRE(v != r);
+    }
+
+    SECTION("Swap") {
+        vector<int> a{1, 2};
+        vector<int> b{3};
+        swap(a, b);
+        REQUIRE(a == vector<int>{3});
+        REQUIRE(b == vector<int>{1, 2});
+    }
+
+    SECTION("Elements are destroyed exactly once") {
+        {
+            vector<counted> v;
+            for (int i = 0; i < 100; ++i) v.emplace_back(i);
+            v.insert(v.begin() + 10, 5, counted(42));
+            v.erase(v.begin(), v.begin() + 20);
+            v.shrink_to_fit();
+            REQUIRE(counted::live == 85);
+        }
+        REQUIRE(counted::live == 0);
+    }
+
+    SECTION("Trivially relocatable elements move as bytes") {
+        {
+            vector<relocatable> v;
+            for (int i = 0; i < 1000; ++i) v.emplace_back(i);
+            v.erase(v.begin() + 10, v.begin() + 20);
+            v.shrink_to_fit();
+            REQUIRE(relocatable::moves == 0);
+            REQUIRE(relocatable::live == 990);
+            REQUIRE(v[9].value == 9);
+            REQUIRE(v[10].value == 20);
+        }
+        REQUIRE(relocatable::live == 0);
+
+        vector<unique_ptr<int>> ptrs;
+        for (int i = 0; i < 100; ++i) ptrs.push_back(make_unique<int>(i));
+        ptrs.erase(ptrs.begin());
+        REQUIRE(*ptrs.front() == 1);
+        REQUIRE(*ptrs.back() == 99);
+        vector<vector<unique_ptr<int>>> nested(3);
+        nested[1].push_back(make_unique<int>(7));
+        nested.erase(nested.begin());
+        for (int i = 0; i < 100; ++i) nested.emplace_back();
+        REQUIRE(*nested[0][0] == 7);
+    }
+
+    SECTION("Growth keeps elements intact when a copy throws") {
+        vector<throwing_copy> v;
+        throwing_copy::copies_left = 100;
+        for (int i = 0; i < 4; ++i) v.push_back(throwing_copy(i));
+        v.shrink_to_fit();
+
+        throwing_copy::copies_left = 2;
+        REQUIRE_THROWS(v.push_back(throwing_copy(4)));
+        REQUIRE(v.size() == 4);
+        for (int i = 0; i < 4; ++i) REQUIRE(v[i].value == i);
+    }
+
+    SECTION("Constructors clean up when a copy throws") {
+        vector<throwing_copy> src;
+        throwing_copy::copies_left = 100;
+        for (int i = 0; i < 4; ++i) src.push_back(throwing_copy(i));
+
+        throwing_copy::copies_left = 2;
+        REQUIRE_THROWS(vector<throwing_copy>(src.begin(), src.end()));
+        throwing_copy::copies_left = 2;
+        REQUIRE_THROWS(vector<throwing_copy>(4, throwing_copy(1)));
+    }
+}